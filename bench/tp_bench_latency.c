@@ -0,0 +1,423 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/tp.h"
+#include "tp_bench_util.h"
+#include "tp_sample_util.h"
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TP_BENCH_LATENCY_MIN_BYTES 64u
+#define TP_BENCH_LATENCY_MAX_BYTES (8u * 1024u * 1024u)
+#define TP_BENCH_LATENCY_TIMEOUT_NS (1000LL * 1000 * 1000)
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Measures offer_frame -> read_frame latency over the no-driver SHM path.\n"
+        "Options:\n"
+        "  -a <dir>     Aeron directory (default: embedded driver if available, else $AERON_DIR)\n"
+        "  -c <chan>    Control channel (default: aeron:ipc)\n"
+        "  -s <id>      Stream id (default: 10000)\n"
+        "  -m <bytes>   Minimum payload bytes (default: 64)\n"
+        "  -M <bytes>   Maximum payload bytes (default: 8388608)\n"
+        "  -n <nslots>  Header/pool nslots (default: 16)\n"
+        "  -f <count>   Measured frames per payload size (default: 10000)\n"
+        "  -w <count>   Warmup frames per payload size (default: 1000)\n"
+        "  -e <engine>  Payload copy engine: memcpy|auto|sse2|avx2|avx512 (default: memcpy)\n"
+        "  -T <bytes>   Copy engine threshold, 0 = library default (default: 0)\n"
+        "  -j <threads> Striped payload copy helper threads, 0 = off (default: 0)\n"
+        "  -h           Show help\n"
+        "Payload sizes double from min to max. Latency is taken from the SlotHeader timestamp\n"
+        "stamped before tp_producer_offer_frame to the return of tp_consumer_read_frame.\n",
+        name);
+}
+
+typedef struct tp_bench_latency_state_stct
+{
+    tp_consumer_t *consumer;
+    tp_latency_histogram_t *hist;
+    double sum_ns;
+    bool record;
+    bool received;
+    uint32_t expected_len;
+    uint64_t errors;
+}
+tp_bench_latency_state_t;
+
+static void on_descriptor(void *clientd, const tp_frame_descriptor_t *desc)
+{
+    tp_bench_latency_state_t *state = (tp_bench_latency_state_t *)clientd;
+    tp_frame_view_t view;
+    int read_result;
+    int64_t now_ns;
+
+    if (NULL == state || NULL == desc)
+    {
+        return;
+    }
+
+    read_result = tp_consumer_read_frame(state->consumer, desc->seq, &view);
+    now_ns = tp_clock_now_ns();
+    if (read_result == 0)
+    {
+        if (view.payload_len != state->expected_len)
+        {
+            state->errors++;
+        }
+        else if (state->record)
+        {
+            uint64_t latency_ns = (uint64_t)(now_ns - (int64_t)view.timestamp_ns);
+
+            tp_latency_histogram_record(state->hist, latency_ns);
+            state->sum_ns += (double)latency_ns;
+        }
+    }
+    else if (read_result < 0)
+    {
+        state->errors++;
+    }
+
+    state->received = true;
+}
+
+static int run_size(
+    tp_client_t *client,
+    uint32_t stream_id,
+    uint64_t epoch,
+    uint32_t nslots,
+    uint32_t payload_len,
+    tp_copy_engine_t copy_engine,
+    size_t copy_threshold,
+    uint32_t copy_threads,
+    int warmup,
+    int frames,
+    tp_latency_histogram_t *hist)
+{
+    tp_producer_context_t producer_ctx;
+    tp_bench_regions_t regions;
+    tp_bench_latency_state_t state;
+    tp_payload_pool_config_t producer_pool;
+    tp_consumer_pool_config_t consumer_pool;
+    tp_producer_config_t producer_cfg;
+    tp_consumer_config_t consumer_cfg;
+    tp_producer_t *producer = NULL;
+    tp_consumer_t *consumer = NULL;
+    tp_tensor_header_t header;
+    tp_frame_t frame;
+    tp_frame_metadata_t meta;
+    uint8_t *payload = NULL;
+    uint32_t stride = tp_bench_round_stride(payload_len);
+    uint64_t drops_gap = 0;
+    uint64_t drops_late = 0;
+    uint64_t timeouts = 0;
+    int result = -1;
+    int i;
+
+    if (tp_bench_create_regions(&regions, stream_id, epoch, 1, nslots, stride) < 0)
+    {
+        return -1;
+    }
+
+    payload = (uint8_t *)malloc(payload_len);
+    if (NULL == payload)
+    {
+        goto cleanup;
+    }
+    for (i = 0; i < (int)payload_len; i++)
+    {
+        payload[i] = (uint8_t)i;
+    }
+
+    if (tp_producer_context_init_default(&producer_ctx, stream_id, 1, false) < 0)
+    {
+        goto cleanup;
+    }
+    tp_producer_context_set_payload_copy_engine(&producer_ctx, copy_engine, copy_threshold);
+    tp_producer_context_set_payload_copy_threads(&producer_ctx, copy_threads, 0, 0);
+
+    if (tp_producer_init(&producer, client, &producer_ctx) < 0 ||
+        tp_consumer_init_simple(&consumer, client, stream_id, 2, false) < 0)
+    {
+        fprintf(stderr, "Producer/consumer init failed: %s\n", tp_errmsg());
+        goto cleanup;
+    }
+
+    memset(&producer_pool, 0, sizeof(producer_pool));
+    producer_pool.pool_id = 1;
+    producer_pool.nslots = nslots;
+    producer_pool.stride_bytes = stride;
+    producer_pool.uri = regions.pool_uri;
+
+    memset(&producer_cfg, 0, sizeof(producer_cfg));
+    producer_cfg.stream_id = stream_id;
+    producer_cfg.producer_id = 1;
+    producer_cfg.epoch = epoch;
+    producer_cfg.layout_version = TP_LAYOUT_VERSION;
+    producer_cfg.header_nslots = nslots;
+    producer_cfg.header_uri = regions.header_uri;
+    producer_cfg.pools = &producer_pool;
+    producer_cfg.pool_count = 1;
+
+    memset(&consumer_pool, 0, sizeof(consumer_pool));
+    consumer_pool.pool_id = 1;
+    consumer_pool.nslots = nslots;
+    consumer_pool.stride_bytes = stride;
+    consumer_pool.uri = regions.pool_uri;
+
+    memset(&consumer_cfg, 0, sizeof(consumer_cfg));
+    consumer_cfg.stream_id = stream_id;
+    consumer_cfg.epoch = epoch;
+    consumer_cfg.layout_version = TP_LAYOUT_VERSION;
+    consumer_cfg.header_nslots = nslots;
+    consumer_cfg.header_uri = regions.header_uri;
+    consumer_cfg.pools = &consumer_pool;
+    consumer_cfg.pool_count = 1;
+
+    if (tp_producer_attach(producer, &producer_cfg) < 0 || tp_consumer_attach(consumer, &consumer_cfg) < 0)
+    {
+        fprintf(stderr, "Attach failed: %s\n", tp_errmsg());
+        goto cleanup;
+    }
+
+    if (tp_example_wait_for_publication(client, tp_producer_descriptor_publication(producer), TP_BENCH_LATENCY_TIMEOUT_NS * 2) < 0)
+    {
+        fprintf(stderr, "Descriptor publication not connected\n");
+        goto cleanup;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.consumer = consumer;
+    state.hist = hist;
+    state.expected_len = payload_len;
+    tp_consumer_set_descriptor_handler(consumer, on_descriptor, &state);
+
+    memset(&header, 0, sizeof(header));
+    header.dtype = TP_DTYPE_UINT8;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = (int32_t)payload_len;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.tensor = &header;
+    frame.payload = payload;
+    frame.payload_len = payload_len;
+    frame.pool_id = 1;
+
+    tp_latency_histogram_reset(hist);
+    for (i = 0; i < warmup + frames; i++)
+    {
+        int64_t deadline;
+
+        state.record = i >= warmup;
+        state.received = false;
+        meta.meta_version = 0;
+        meta.timestamp_ns = (uint64_t)tp_clock_now_ns();
+        if (tp_producer_offer_frame(producer, &frame, &meta) < 0)
+        {
+            fprintf(stderr, "Offer failed: %s\n", tp_errmsg());
+            goto cleanup;
+        }
+
+        deadline = tp_clock_now_ns() + TP_BENCH_LATENCY_TIMEOUT_NS;
+        while (!state.received && tp_clock_now_ns() < deadline)
+        {
+            tp_consumer_poll_descriptors(consumer, 1);
+        }
+        if (!state.received)
+        {
+            timeouts++;
+        }
+    }
+
+    tp_consumer_get_drop_counts(consumer, &drops_gap, &drops_late, NULL);
+    printf("%12u %8" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10.0f %8" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n",
+        payload_len,
+        hist->count,
+        tp_latency_histogram_percentile(hist, 50.0),
+        tp_latency_histogram_percentile(hist, 99.0),
+        tp_latency_histogram_percentile(hist, 99.9),
+        hist->max_ns,
+        hist->count == 0 ? 0.0 : state.sum_ns / (double)hist->count,
+        drops_gap,
+        drops_late,
+        timeouts + state.errors);
+    fflush(stdout);
+    result = 0;
+
+cleanup:
+    if (NULL != consumer)
+    {
+        tp_consumer_close(consumer);
+    }
+    if (NULL != producer)
+    {
+        tp_producer_close(producer);
+    }
+    free(payload);
+    tp_bench_remove_regions(&regions);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    tp_context_t *client_context = NULL;
+    tp_client_t *client = NULL;
+    tp_latency_histogram_t *hist = NULL;
+    char embedded_dir[4096];
+    const char *aeron_dir = NULL;
+    const char *channel = "aeron:ipc";
+    const char *allowed_paths[] = { "/dev/shm", "/tmp" };
+    uint32_t stream_id = 10000;
+    uint32_t min_bytes = TP_BENCH_LATENCY_MIN_BYTES;
+    uint32_t max_bytes = TP_BENCH_LATENCY_MAX_BYTES;
+    uint32_t nslots = 16;
+    uint32_t payload_len;
+    uint64_t epoch = 1;
+    tp_copy_engine_t copy_engine = TP_COPY_ENGINE_MEMCPY;
+    size_t copy_threshold = 0;
+    uint32_t copy_threads = 0;
+    int frames = 10000;
+    int warmup = 1000;
+    bool embedded = false;
+    bool client_inited = false;
+    int result = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:c:s:m:M:n:f:w:e:T:j:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'a':
+                aeron_dir = optarg;
+                break;
+            case 'c':
+                channel = optarg;
+                break;
+            case 's':
+                stream_id = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'm':
+                min_bytes = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'M':
+                max_bytes = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                nslots = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                frames = (int)strtol(optarg, NULL, 10);
+                break;
+            case 'w':
+                warmup = (int)strtol(optarg, NULL, 10);
+                break;
+            case 'e':
+                if (tp_bench_parse_copy_engine(optarg, &copy_engine) < 0)
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'T':
+                copy_threshold = (size_t)strtoull(optarg, NULL, 10);
+                break;
+            case 'j':
+                copy_threads = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (stream_id == 0 || min_bytes == 0 || max_bytes < min_bytes || frames <= 0 || warmup < 0 ||
+        nslots == 0 || (nslots & (nslots - 1)) != 0 || optind < argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (NULL == aeron_dir)
+    {
+        if (tp_bench_start_embedded_driver(embedded_dir, sizeof(embedded_dir)) == 0)
+        {
+            aeron_dir = embedded_dir;
+            embedded = true;
+        }
+        else
+        {
+            aeron_dir = getenv("AERON_DIR");
+        }
+    }
+    if (NULL == aeron_dir || aeron_dir[0] == '\0')
+    {
+        fprintf(stderr, "No Aeron directory: pass -a or set AERON_DIR\n");
+        return 1;
+    }
+
+    hist = (tp_latency_histogram_t *)malloc(sizeof(*hist));
+    if (NULL == hist)
+    {
+        goto cleanup;
+    }
+
+    if (tp_example_init_client_context_nodriver(&client_context, aeron_dir, channel, allowed_paths, 2) < 0)
+    {
+        fprintf(stderr, "Failed to init context\n");
+        goto cleanup;
+    }
+
+    if (tp_client_init(&client, client_context) < 0 || tp_client_start(client) < 0)
+    {
+        fprintf(stderr, "Client init failed: %s\n", tp_errmsg());
+        goto cleanup;
+    }
+    client_inited = true;
+
+    printf("# aeron_dir=%s embedded_driver=%d nslots=%u frames=%d warmup=%d copy_engine=%s (%s) copy_threshold=%zu copy_threads=%u\n",
+        aeron_dir, embedded ? 1 : 0, nslots, frames, warmup,
+        tp_copy_engine_name(copy_engine),
+        tp_copy_engine_name(tp_copy_engine_resolve(copy_engine)),
+        copy_threshold,
+        copy_threads);
+    printf("%12s %8s %10s %10s %10s %10s %10s %8s %8s %8s\n",
+        "payload_b", "count", "p50_ns", "p99_ns", "p99.9_ns", "max_ns", "mean_ns", "gap", "late", "errors");
+
+    for (payload_len = min_bytes; payload_len <= max_bytes; payload_len *= 2)
+    {
+        if (run_size(client, stream_id, epoch++, nslots, payload_len, copy_engine, copy_threshold, copy_threads, warmup, frames, hist) < 0)
+        {
+            goto cleanup;
+        }
+        if (payload_len > UINT32_MAX / 2)
+        {
+            break;
+        }
+    }
+
+    result = 0;
+
+cleanup:
+    if (client_inited)
+    {
+        tp_client_close(client);
+    }
+    free(hist);
+    if (embedded)
+    {
+        tp_bench_stop_embedded_driver();
+    }
+    return result;
+}
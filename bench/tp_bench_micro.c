@@ -0,0 +1,620 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/tp.h"
+#include "tensor_pool/tp_seqlock.h"
+#include "tensor_pool/tp_slot.h"
+#include "tensor_pool/internal/tp_producer_internal.h"
+
+#include "wire/tensor_pool/messageHeader.h"
+#include "wire/tensor_pool/slotHeader.h"
+#include "wire/tensor_pool/tensorHeader.h"
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#define TP_BENCH_MICRO_MAX_POOLS 16
+#define TP_BENCH_MICRO_MAX_CASES 64
+#define TP_BENCH_MICRO_NAME_MAX 64
+#define TP_BENCH_MICRO_COPY_BYTES (4u * 1024u * 1024u)
+#define TP_BENCH_MICRO_COPY_SLOTS 16u
+
+typedef struct tp_bench_micro_fixture_stct
+{
+    tp_tensor_header_t tensor;
+    tp_tensor_header_t prepared;
+    tp_producer_t producer;
+    tp_payload_pool_t pools[TP_BENCH_MICRO_MAX_POOLS];
+    uint8_t slot[TP_HEADER_SLOT_BYTES];
+    uint8_t scratch[TP_HEADER_SLOT_BYTES];
+    size_t pool_lengths[TP_BENCH_MICRO_MAX_POOLS];
+    uint8_t *copy_src;
+    uint8_t *copy_dst;
+    tp_copy_fn_t copy_fn;
+    volatile uint64_t sink;
+}
+tp_bench_micro_fixture_t;
+
+typedef void (*tp_bench_micro_fn_t)(tp_bench_micro_fixture_t *fixture, uint64_t iterations);
+
+typedef struct tp_bench_micro_result_stct
+{
+    char name[TP_BENCH_MICRO_NAME_MAX];
+    double ns_per_op;
+    double ops_per_sec;
+    double instructions_per_op;
+    double bytes_per_op;
+    bool has_instructions;
+}
+tp_bench_micro_result_t;
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Times the per-frame producer/consumer header paths and prints JSON results.\n"
+        "Options:\n"
+        "  -i <iters>   Iterations per repetition (default: 1000000)\n"
+        "  -r <reps>    Repetitions, best is reported (default: 5)\n"
+        "  -f <filter>  Only run cases whose name contains <filter>\n"
+        "  -b <file>    Compare against a baseline JSON file produced by this tool\n"
+        "  -t <pct>     Regression threshold in percent for -b (default: 10)\n"
+        "  -h           Show help\n"
+        "payload_copy.* cases copy 4 MiB into a 64 MiB ring (one copy per op) and also report gb_per_sec.\n"
+        "Exit status is 2 when -b finds a case slower than the threshold.\n",
+        name);
+}
+
+#if defined(__linux__)
+static int tp_bench_perf_open(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void tp_bench_perf_start(int fd)
+{
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static bool tp_bench_perf_stop(int fd, uint64_t *count)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    return read(fd, count, sizeof(*count)) == (ssize_t)sizeof(*count);
+}
+#else
+static int tp_bench_perf_open(void)
+{
+    return -1;
+}
+
+static void tp_bench_perf_start(int fd)
+{
+    (void)fd;
+}
+
+static bool tp_bench_perf_stop(int fd, uint64_t *count)
+{
+    (void)fd;
+    (void)count;
+    return false;
+}
+#endif
+
+static void tp_bench_write_slot_header(uint8_t *slot, uint64_t seq)
+{
+    struct tensor_pool_slotHeader slot_header;
+
+    tensor_pool_slotHeader_wrap_for_encode(&slot_header, (char *)slot, 0, TP_HEADER_SLOT_BYTES);
+    tensor_pool_slotHeader_set_valuesLenBytes(&slot_header, 4096);
+    tensor_pool_slotHeader_set_payloadSlot(&slot_header, (uint32_t)(seq & 1023));
+    tensor_pool_slotHeader_set_poolId(&slot_header, 1);
+    tensor_pool_slotHeader_set_payloadOffset(&slot_header, 0);
+    tensor_pool_slotHeader_set_timestampNs(&slot_header, seq);
+    tensor_pool_slotHeader_set_metaVersion(&slot_header, 0);
+}
+
+static int tp_bench_fixture_init(tp_bench_micro_fixture_t *fixture)
+{
+    uint32_t header_len;
+    uint32_t header_len_le;
+    size_t i;
+
+    memset(fixture, 0, sizeof(*fixture));
+
+    fixture->tensor.dtype = TP_DTYPE_FLOAT32;
+    fixture->tensor.major_order = TP_MAJOR_ORDER_ROW;
+    fixture->tensor.ndims = 3;
+    fixture->tensor.progress_unit = TP_PROGRESS_NONE;
+    fixture->tensor.dims[0] = 4;
+    fixture->tensor.dims[1] = 480;
+    fixture->tensor.dims[2] = 640;
+
+    if (tp_producer_prepare_tensor_header_for_test(NULL, &fixture->tensor, &fixture->prepared) < 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < TP_BENCH_MICRO_MAX_POOLS; i++)
+    {
+        fixture->pools[i].pool_id = (uint16_t)(i + 1);
+        fixture->pools[i].nslots = 1024;
+        fixture->pools[i].stride_bytes = 64u << i;
+        fixture->pool_lengths[i] = ((size_t)64u << i) - 1u;
+    }
+    fixture->producer.pools = fixture->pools;
+
+    tp_bench_write_slot_header(fixture->slot, 7);
+    tp_producer_zero_slot_padding_for_test(fixture->slot);
+    if (tp_producer_encode_tensor_header_for_test(fixture->scratch, sizeof(fixture->scratch), &fixture->prepared) < 0)
+    {
+        return -1;
+    }
+    header_len = (uint32_t)(tensor_pool_messageHeader_encoded_length() + tensor_pool_tensorHeader_sbe_block_length());
+    header_len_le = SBE_LITTLE_ENDIAN_ENCODE_32(header_len);
+    memcpy(fixture->slot + tensor_pool_slotHeader_sbe_block_length(), &header_len_le, sizeof(header_len_le));
+    memcpy(fixture->slot + tensor_pool_slotHeader_sbe_block_length() + sizeof(header_len_le), fixture->scratch, header_len);
+    tp_atomic_store_u64((uint64_t *)fixture->slot, tp_seq_committed(7));
+
+    return 0;
+}
+
+static void bench_encode_tensor_header(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        tp_producer_encode_tensor_header_for_test(fixture->scratch, sizeof(fixture->scratch), &fixture->prepared);
+        fixture->sink += fixture->scratch[tensor_pool_messageHeader_encoded_length()];
+    }
+}
+
+static void bench_prepare_tensor_header(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    tp_tensor_header_t out;
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        tp_producer_prepare_tensor_header_for_test(NULL, &fixture->tensor, &out);
+        fixture->sink += (uint64_t)out.strides[0];
+    }
+}
+
+static void bench_slot_header_setters(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        tp_bench_write_slot_header(fixture->scratch, i);
+        fixture->sink += fixture->scratch[8];
+    }
+}
+
+static void bench_zero_slot_padding(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        tp_producer_zero_slot_padding_for_test(fixture->scratch);
+        fixture->sink += fixture->scratch[tensor_pool_slotHeader_pad_encoding_offset()];
+    }
+}
+
+static void bench_slot_decode(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    tp_slot_view_t view;
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        tp_slot_decode(&view, fixture->slot, TP_HEADER_SLOT_BYTES, NULL);
+        fixture->sink += view.values_len_bytes;
+    }
+}
+
+static void bench_tensor_header_decode(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    tp_slot_view_t view;
+    tp_tensor_header_t header;
+    uint64_t i;
+
+    tp_slot_decode(&view, fixture->slot, TP_HEADER_SLOT_BYTES, NULL);
+    for (i = 0; i < iterations; i++)
+    {
+        tp_tensor_header_decode(&header, view.header_bytes, view.header_bytes_length, NULL);
+        fixture->sink += (uint64_t)header.dims[0];
+    }
+}
+
+static void bench_tensor_header_validate(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    tp_tensor_header_t header;
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        header = fixture->prepared;
+        tp_tensor_header_validate(&header, NULL);
+        fixture->sink += (uint64_t)header.strides[0];
+    }
+}
+
+static void bench_consumer_decode_all(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    tp_slot_view_t view;
+    tp_tensor_header_t header;
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        uint64_t seq = tp_atomic_load_u64((uint64_t *)fixture->slot);
+        tp_slot_decode(&view, fixture->slot, TP_HEADER_SLOT_BYTES, NULL);
+        tp_tensor_header_decode(&header, view.header_bytes, view.header_bytes_length, NULL);
+        tp_tensor_header_validate(&header, NULL);
+        fixture->sink += seq ^ tp_atomic_load_u64((uint64_t *)fixture->slot) ^ (uint64_t)header.strides[0];
+    }
+}
+
+static void bench_find_pool_for_length(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    size_t pool_count = fixture->producer.pool_count;
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        tp_payload_pool_t *pool = tp_producer_find_pool_for_length_for_test(
+            &fixture->producer,
+            fixture->pool_lengths[i % pool_count]);
+        fixture->sink += pool ? pool->pool_id : 0;
+    }
+}
+
+static void bench_payload_copy(tp_bench_micro_fixture_t *fixture, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        uint8_t *dst = fixture->copy_dst + (i % TP_BENCH_MICRO_COPY_SLOTS) * TP_BENCH_MICRO_COPY_BYTES;
+        fixture->copy_fn(dst, fixture->copy_src, TP_BENCH_MICRO_COPY_BYTES);
+        fixture->sink += dst[i & 4095u];
+    }
+}
+
+static bool tp_bench_run_case(
+    tp_bench_micro_fixture_t *fixture,
+    const char *name,
+    tp_bench_micro_fn_t fn,
+    uint64_t iterations,
+    int repetitions,
+    int perf_fd,
+    tp_bench_micro_result_t *result)
+{
+    double best_ns = -1.0;
+    uint64_t best_instructions = 0;
+    bool has_instructions = false;
+    int rep;
+
+    fn(fixture, iterations / 10 + 1);
+
+    for (rep = 0; rep < repetitions; rep++)
+    {
+        uint64_t instructions = 0;
+        int64_t start_ns;
+        int64_t end_ns;
+        double elapsed;
+
+        tp_bench_perf_start(perf_fd);
+        start_ns = tp_clock_now_ns();
+        fn(fixture, iterations);
+        end_ns = tp_clock_now_ns();
+        if (tp_bench_perf_stop(perf_fd, &instructions))
+        {
+            has_instructions = true;
+        }
+
+        elapsed = (double)(end_ns - start_ns);
+        if (best_ns < 0.0 || elapsed < best_ns)
+        {
+            best_ns = elapsed;
+            best_instructions = instructions;
+        }
+    }
+
+    memset(result, 0, sizeof(*result));
+    strncpy(result->name, name, sizeof(result->name) - 1);
+    result->ns_per_op = best_ns / (double)iterations;
+    result->ops_per_sec = best_ns > 0.0 ? ((double)iterations * 1e9) / best_ns : 0.0;
+    result->has_instructions = has_instructions;
+    result->instructions_per_op = (double)best_instructions / (double)iterations;
+    return true;
+}
+
+static int tp_bench_load_baseline(const char *path, tp_bench_micro_result_t *baseline, size_t capacity, size_t *count)
+{
+    char line[512];
+    FILE *fp = fopen(path, "r");
+
+    *count = 0;
+    if (NULL == fp)
+    {
+        fprintf(stderr, "Failed to open baseline %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) && *count < capacity)
+    {
+        const char *name = strstr(line, "\"name\": \"");
+        const char *ns = strstr(line, "\"ns_per_op\": ");
+        const char *end;
+        size_t len;
+
+        if (NULL == name || NULL == ns)
+        {
+            continue;
+        }
+
+        name += strlen("\"name\": \"");
+        end = strchr(name, '"');
+        if (NULL == end)
+        {
+            continue;
+        }
+        len = (size_t)(end - name);
+        if (len >= TP_BENCH_MICRO_NAME_MAX)
+        {
+            continue;
+        }
+
+        memset(&baseline[*count], 0, sizeof(baseline[*count]));
+        memcpy(baseline[*count].name, name, len);
+        baseline[*count].ns_per_op = strtod(ns + strlen("\"ns_per_op\": "), NULL);
+        (*count)++;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+static const tp_bench_micro_result_t *tp_bench_find_baseline(
+    const tp_bench_micro_result_t *baseline,
+    size_t count,
+    const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (0 == strcmp(baseline[i].name, name))
+        {
+            return &baseline[i];
+        }
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct
+    {
+        const char *name;
+        tp_bench_micro_fn_t fn;
+    }
+    cases[] =
+    {
+        { "producer.encode_tensor_header", bench_encode_tensor_header },
+        { "producer.prepare_tensor_header", bench_prepare_tensor_header },
+        { "producer.slot_header_setters", bench_slot_header_setters },
+        { "producer.zero_slot_padding", bench_zero_slot_padding },
+        { "consumer.slot_decode", bench_slot_decode },
+        { "consumer.tensor_header_decode", bench_tensor_header_decode },
+        { "consumer.tensor_header_validate", bench_tensor_header_validate },
+        { "consumer.decode_all", bench_consumer_decode_all }
+    };
+    tp_bench_micro_fixture_t *fixture = NULL;
+    tp_bench_micro_result_t results[TP_BENCH_MICRO_MAX_CASES];
+    tp_bench_micro_result_t baseline[TP_BENCH_MICRO_MAX_CASES];
+    size_t result_count = 0;
+    size_t baseline_count = 0;
+    uint64_t iterations = 1000000;
+    int repetitions = 5;
+    double threshold_pct = 10.0;
+    const char *filter = NULL;
+    const char *baseline_path = NULL;
+    int perf_fd;
+    int regressions = 0;
+    int opt;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "i:r:f:b:t:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+                iterations = (uint64_t)strtoull(optarg, NULL, 10);
+                break;
+            case 'r':
+                repetitions = (int)strtol(optarg, NULL, 10);
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            case 't':
+                threshold_pct = strtod(optarg, NULL);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (iterations == 0 || repetitions <= 0 || optind < argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (baseline_path && tp_bench_load_baseline(baseline_path, baseline, TP_BENCH_MICRO_MAX_CASES, &baseline_count) < 0)
+    {
+        return 1;
+    }
+
+    fixture = (tp_bench_micro_fixture_t *)calloc(1, sizeof(*fixture));
+    if (NULL == fixture || tp_bench_fixture_init(fixture) < 0)
+    {
+        fprintf(stderr, "Fixture init failed: %s\n", tp_errmsg());
+        free(fixture);
+        return 1;
+    }
+
+    perf_fd = tp_bench_perf_open();
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (filter && NULL == strstr(cases[i].name, filter))
+        {
+            continue;
+        }
+        tp_bench_run_case(fixture, cases[i].name, cases[i].fn, iterations, repetitions, perf_fd, &results[result_count++]);
+    }
+
+    for (i = 1; i <= TP_BENCH_MICRO_MAX_POOLS; i++)
+    {
+        char name[TP_BENCH_MICRO_NAME_MAX];
+
+        snprintf(name, sizeof(name), "producer.find_pool_for_length.pools_%zu", i);
+        if (filter && NULL == strstr(name, filter))
+        {
+            continue;
+        }
+        fixture->producer.pool_count = i;
+        tp_bench_run_case(fixture, name, bench_find_pool_for_length, iterations, repetitions, perf_fd, &results[result_count++]);
+    }
+
+    fixture->copy_src = (uint8_t *)malloc(TP_BENCH_MICRO_COPY_BYTES);
+    fixture->copy_dst = (uint8_t *)malloc((size_t)TP_BENCH_MICRO_COPY_BYTES * TP_BENCH_MICRO_COPY_SLOTS);
+    if (NULL != fixture->copy_src && NULL != fixture->copy_dst)
+    {
+        static const tp_copy_engine_t engines[] =
+        {
+            TP_COPY_ENGINE_MEMCPY,
+            TP_COPY_ENGINE_SSE2,
+            TP_COPY_ENGINE_AVX2,
+            TP_COPY_ENGINE_AVX512
+        };
+        uint64_t copy_iterations = iterations / 4096u + TP_BENCH_MICRO_COPY_SLOTS;
+        size_t e;
+
+        memset(fixture->copy_src, 0x5a, TP_BENCH_MICRO_COPY_BYTES);
+        memset(fixture->copy_dst, 0, (size_t)TP_BENCH_MICRO_COPY_BYTES * TP_BENCH_MICRO_COPY_SLOTS);
+        for (e = 0; e < sizeof(engines) / sizeof(engines[0]); e++)
+        {
+            char name[TP_BENCH_MICRO_NAME_MAX];
+
+            if (tp_copy_engine_resolve(engines[e]) != engines[e])
+            {
+                continue;
+            }
+            snprintf(name, sizeof(name), "payload_copy.%s.4MiB", tp_copy_engine_name(engines[e]));
+            if (filter && NULL == strstr(name, filter))
+            {
+                continue;
+            }
+            fixture->copy_fn = tp_copy_engine_fn(engines[e]);
+            tp_bench_run_case(fixture, name, bench_payload_copy, copy_iterations, repetitions, perf_fd, &results[result_count]);
+            results[result_count++].bytes_per_op = (double)TP_BENCH_MICRO_COPY_BYTES;
+        }
+    }
+
+    printf("{\n  \"iterations\": %" PRIu64 ",\n  \"repetitions\": %d,\n  \"results\": [\n", iterations, repetitions);
+    for (i = 0; i < result_count; i++)
+    {
+        const tp_bench_micro_result_t *base = tp_bench_find_baseline(baseline, baseline_count, results[i].name);
+
+        printf("    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"instructions_per_op\": ",
+            results[i].name,
+            results[i].ns_per_op,
+            results[i].ops_per_sec);
+        if (results[i].has_instructions)
+        {
+            printf("%.1f", results[i].instructions_per_op);
+        }
+        else
+        {
+            printf("null");
+        }
+        if (base && base->ns_per_op > 0.0)
+        {
+            double delta_pct = ((results[i].ns_per_op - base->ns_per_op) / base->ns_per_op) * 100.0;
+            bool regressed = delta_pct > threshold_pct;
+
+            printf(", \"baseline_ns_per_op\": %.3f, \"delta_pct\": %.1f, \"regression\": %s",
+                base->ns_per_op,
+                delta_pct,
+                regressed ? "true" : "false");
+            if (regressed)
+            {
+                regressions++;
+            }
+        }
+        if (results[i].bytes_per_op > 0.0 && results[i].ns_per_op > 0.0)
+        {
+            printf(", \"gb_per_sec\": %.2f", results[i].bytes_per_op / results[i].ns_per_op);
+        }
+        printf("}%s\n", (i + 1 < result_count) ? "," : "");
+    }
+    printf("  ],\n  \"regressions\": %d\n}\n", regressions);
+
+    if (perf_fd >= 0)
+    {
+        close(perf_fd);
+    }
+    free(fixture->copy_src);
+    free(fixture->copy_dst);
+    free(fixture);
+    return regressions > 0 ? 2 : 0;
+}
@@ -0,0 +1,588 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/tp.h"
+#include "tp_bench_util.h"
+#include "tp_sample_util.h"
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TP_BENCH_THROUGHPUT_MAX_COUNTS 16
+#define TP_BENCH_THROUGHPUT_MAX_CONSUMERS 1024
+#define TP_BENCH_THROUGHPUT_PER_CONSUMER_STREAM_BASE 20000
+#define TP_BENCH_THROUGHPUT_SETUP_NS (1000LL * 1000 * 1000)
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Drives the producer as fast as possible with N consumers attached via the consumer manager.\n"
+        "Options:\n"
+        "  -a <dir>     Aeron directory (default: embedded driver if available, else $AERON_DIR)\n"
+        "  -c <chan>    Control channel (default: aeron:ipc)\n"
+        "  -s <id>      Stream id (default: 10000)\n"
+        "  -N <list>    Comma separated consumer counts (default: 1,4,16,64)\n"
+        "  -b <bytes>   Payload bytes (default: 4096)\n"
+        "  -n <nslots>  Header/pool nslots (default: 1024)\n"
+        "  -d <ms>      Measured duration per consumer count (default: 2000)\n"
+        "  -P <n>       Every n-th consumer uses a per-consumer descriptor stream (0 = none, default: 2)\n"
+        "  -R <n>       Every n-th consumer requests RATE_LIMITED on a per-consumer stream (0 = none, default: 4)\n"
+        "  -z <hz>      max_rate_hz for RATE_LIMITED consumers (default: 1000)\n"
+        "  -C           Publish with tp_producer_try_claim/commit_claim instead of offer_frame\n"
+        "  -h           Show help\n",
+        name);
+}
+
+typedef struct tp_bench_consumer_slot_stct
+{
+    tp_consumer_t *consumer;
+    uint64_t frames;
+    uint64_t bytes;
+    uint64_t errors;
+}
+tp_bench_consumer_slot_t;
+
+typedef struct tp_bench_throughput_run_stct
+{
+    tp_producer_t *producer;
+    tp_bench_consumer_slot_t *consumers;
+    size_t consumer_count;
+    const uint8_t *payload;
+    uint32_t payload_len;
+    bool use_claim;
+    int64_t duration_ns;
+    atomic_bool running;
+    uint64_t offered;
+    uint64_t offer_failures;
+    int64_t elapsed_ns;
+}
+tp_bench_throughput_run_t;
+
+static void on_descriptor(void *clientd, const tp_frame_descriptor_t *desc)
+{
+    tp_bench_consumer_slot_t *slot = (tp_bench_consumer_slot_t *)clientd;
+    tp_frame_view_t view;
+    int read_result;
+
+    read_result = tp_consumer_read_frame(slot->consumer, desc->seq, &view);
+    if (read_result == 0)
+    {
+        slot->frames++;
+        slot->bytes += view.payload_len;
+    }
+    else if (read_result < 0)
+    {
+        slot->errors++;
+    }
+}
+
+static void *producer_thread(void *arg)
+{
+    tp_bench_throughput_run_t *run = (tp_bench_throughput_run_t *)arg;
+    tp_tensor_header_t header;
+    tp_frame_t frame;
+    tp_frame_metadata_t meta;
+    int64_t start_ns;
+    int64_t deadline_ns;
+    uint64_t i = 0;
+
+    memset(&header, 0, sizeof(header));
+    header.dtype = TP_DTYPE_UINT8;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = (int32_t)run->payload_len;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.tensor = &header;
+    frame.payload = run->payload;
+    frame.payload_len = run->payload_len;
+    frame.pool_id = 1;
+
+    start_ns = tp_clock_now_ns();
+    deadline_ns = start_ns + run->duration_ns;
+    while (true)
+    {
+        int result;
+
+        if ((i & 63) == 0)
+        {
+            tp_producer_poll_control(run->producer, 10);
+            if (tp_clock_now_ns() >= deadline_ns)
+            {
+                break;
+            }
+        }
+
+        meta.timestamp_ns = 0;
+        meta.meta_version = 0;
+        if (run->use_claim)
+        {
+            tp_buffer_claim_t claim;
+
+            if (tp_producer_try_claim(run->producer, run->payload_len, &claim) < 0)
+            {
+                run->offer_failures++;
+                i++;
+                continue;
+            }
+            memcpy(claim.payload, run->payload, run->payload_len);
+            claim.tensor = header;
+            result = tp_producer_commit_claim(run->producer, &claim, &meta);
+        }
+        else
+        {
+            result = tp_producer_offer_frame(run->producer, &frame, &meta) < 0 ? -1 : 0;
+        }
+
+        if (result < 0)
+        {
+            run->offer_failures++;
+        }
+        else
+        {
+            run->offered++;
+        }
+        i++;
+    }
+
+    run->elapsed_ns = tp_clock_now_ns() - start_ns;
+    atomic_store(&run->running, false);
+    return NULL;
+}
+
+static void *consumer_thread(void *arg)
+{
+    tp_bench_throughput_run_t *run = (tp_bench_throughput_run_t *)arg;
+    uint64_t rounds = 0;
+
+    while (atomic_load(&run->running))
+    {
+        size_t i;
+
+        for (i = 0; i < run->consumer_count; i++)
+        {
+            tp_consumer_poll_descriptors(run->consumers[i].consumer, 64);
+            if ((rounds & 255) == 0)
+            {
+                tp_consumer_poll_control(run->consumers[i].consumer, 10);
+            }
+        }
+        rounds++;
+    }
+
+    return NULL;
+}
+
+static int run_count(
+    tp_client_t *producer_client,
+    tp_client_t *consumer_client,
+    uint32_t stream_id,
+    uint64_t epoch,
+    uint32_t nslots,
+    uint32_t payload_len,
+    size_t consumer_count,
+    uint32_t per_consumer_every,
+    uint32_t rate_limited_every,
+    uint32_t max_rate_hz,
+    int64_t duration_ns,
+    bool use_claim)
+{
+    tp_bench_regions_t regions;
+    tp_bench_throughput_run_t run;
+    tp_payload_pool_config_t producer_pool;
+    tp_consumer_pool_config_t consumer_pool;
+    tp_producer_config_t producer_cfg;
+    tp_consumer_config_t consumer_cfg;
+    tp_bench_consumer_slot_t *consumers = NULL;
+    uint8_t *payload = NULL;
+    uint32_t stride = tp_bench_round_stride(payload_len);
+    uint64_t delivered = 0;
+    uint64_t delivered_bytes = 0;
+    uint64_t drops_gap = 0;
+    uint64_t drops_late = 0;
+    uint64_t errors = 0;
+    size_t per_consumer = 0;
+    size_t rate_limited = 0;
+    pthread_t producer_tid;
+    pthread_t consumer_tid;
+    double seconds;
+    int result = -1;
+    size_t i;
+
+    memset(&run, 0, sizeof(run));
+    if (tp_bench_create_regions(&regions, stream_id, epoch, 1, nslots, stride) < 0)
+    {
+        return -1;
+    }
+
+    payload = (uint8_t *)malloc(payload_len);
+    consumers = (tp_bench_consumer_slot_t *)calloc(consumer_count, sizeof(*consumers));
+    if (NULL == payload || NULL == consumers)
+    {
+        goto cleanup;
+    }
+    memset(payload, 0x5a, payload_len);
+
+    if (tp_producer_init_simple(&run.producer, producer_client, stream_id, 1, false) < 0 ||
+        tp_producer_enable_consumer_manager(run.producer, consumer_count) < 0)
+    {
+        fprintf(stderr, "Producer init failed: %s\n", tp_errmsg());
+        goto cleanup;
+    }
+
+    memset(&producer_pool, 0, sizeof(producer_pool));
+    producer_pool.pool_id = 1;
+    producer_pool.nslots = nslots;
+    producer_pool.stride_bytes = stride;
+    producer_pool.uri = regions.pool_uri;
+
+    memset(&producer_cfg, 0, sizeof(producer_cfg));
+    producer_cfg.stream_id = stream_id;
+    producer_cfg.producer_id = 1;
+    producer_cfg.epoch = epoch;
+    producer_cfg.layout_version = TP_LAYOUT_VERSION;
+    producer_cfg.header_nslots = nslots;
+    producer_cfg.header_uri = regions.header_uri;
+    producer_cfg.pools = &producer_pool;
+    producer_cfg.pool_count = 1;
+
+    if (tp_producer_attach(run.producer, &producer_cfg) < 0)
+    {
+        fprintf(stderr, "Producer attach failed: %s\n", tp_errmsg());
+        goto cleanup;
+    }
+
+    memset(&consumer_pool, 0, sizeof(consumer_pool));
+    consumer_pool.pool_id = 1;
+    consumer_pool.nslots = nslots;
+    consumer_pool.stride_bytes = stride;
+    consumer_pool.uri = regions.pool_uri;
+
+    memset(&consumer_cfg, 0, sizeof(consumer_cfg));
+    consumer_cfg.stream_id = stream_id;
+    consumer_cfg.epoch = epoch;
+    consumer_cfg.layout_version = TP_LAYOUT_VERSION;
+    consumer_cfg.header_nslots = nslots;
+    consumer_cfg.header_uri = regions.header_uri;
+    consumer_cfg.pools = &consumer_pool;
+    consumer_cfg.pool_count = 1;
+
+    for (i = 0; i < consumer_count; i++)
+    {
+        tp_consumer_context_t ctx;
+        uint32_t ordinal = (uint32_t)i + 1;
+        bool is_rate_limited = rate_limited_every > 0 && (ordinal % rate_limited_every) == 0;
+        bool is_per_consumer = is_rate_limited || (per_consumer_every > 0 && (ordinal % per_consumer_every) == 0);
+
+        if (tp_consumer_context_init_default(&ctx, stream_id, 100 + ordinal, false) < 0)
+        {
+            goto cleanup;
+        }
+        if (is_per_consumer)
+        {
+            ctx.hello.descriptor_channel = "aeron:ipc";
+            ctx.hello.descriptor_stream_id = TP_BENCH_THROUGHPUT_PER_CONSUMER_STREAM_BASE + ordinal;
+            per_consumer++;
+        }
+        if (is_rate_limited)
+        {
+            ctx.hello.mode = TP_MODE_RATE_LIMITED;
+            ctx.hello.max_rate_hz = max_rate_hz;
+            rate_limited++;
+        }
+
+        if (tp_consumer_init(&consumers[i].consumer, consumer_client, &ctx) < 0 ||
+            tp_consumer_attach(consumers[i].consumer, &consumer_cfg) < 0)
+        {
+            fprintf(stderr, "Consumer %zu init/attach failed: %s\n", i, tp_errmsg());
+            goto cleanup;
+        }
+        tp_consumer_set_descriptor_handler(consumers[i].consumer, on_descriptor, &consumers[i]);
+    }
+
+    /* Let the producer accept every hello and the consumers switch to their assigned streams. */
+    {
+        int64_t deadline = tp_clock_now_ns() + TP_BENCH_THROUGHPUT_SETUP_NS;
+        while (tp_clock_now_ns() < deadline)
+        {
+            tp_producer_poll_control(run.producer, 100);
+            for (i = 0; i < consumer_count; i++)
+            {
+                tp_consumer_poll_control(consumers[i].consumer, 10);
+            }
+        }
+    }
+
+    run.consumers = consumers;
+    run.consumer_count = consumer_count;
+    run.payload = payload;
+    run.payload_len = payload_len;
+    run.use_claim = use_claim;
+    run.duration_ns = duration_ns;
+    atomic_store(&run.running, true);
+
+    if (pthread_create(&consumer_tid, NULL, consumer_thread, &run) != 0)
+    {
+        goto cleanup;
+    }
+    if (pthread_create(&producer_tid, NULL, producer_thread, &run) != 0)
+    {
+        atomic_store(&run.running, false);
+        pthread_join(consumer_tid, NULL);
+        goto cleanup;
+    }
+    pthread_join(producer_tid, NULL);
+    pthread_join(consumer_tid, NULL);
+
+    for (i = 0; i < consumer_count; i++)
+    {
+        uint64_t gap = 0;
+        uint64_t late = 0;
+
+        tp_consumer_get_drop_counts(consumers[i].consumer, &gap, &late, NULL);
+        drops_gap += gap;
+        drops_late += late;
+        delivered += consumers[i].frames;
+        delivered_bytes += consumers[i].bytes;
+        errors += consumers[i].errors;
+    }
+
+    seconds = (double)run.elapsed_ns / 1e9;
+    printf("%9zu %6zu %6zu %12" PRIu64 " %12.0f %9.3f %12" PRIu64 " %9.3f %10" PRIu64 " %10" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n",
+        consumer_count,
+        per_consumer,
+        rate_limited,
+        run.offered,
+        seconds > 0.0 ? (double)run.offered / seconds : 0.0,
+        seconds > 0.0 ? ((double)run.offered * payload_len) / seconds / 1e9 : 0.0,
+        delivered,
+        seconds > 0.0 ? (double)delivered_bytes / seconds / 1e9 : 0.0,
+        drops_gap,
+        drops_late,
+        run.offer_failures,
+        errors);
+    fflush(stdout);
+    result = 0;
+
+cleanup:
+    if (consumers)
+    {
+        for (i = 0; i < consumer_count; i++)
+        {
+            if (consumers[i].consumer)
+            {
+                tp_consumer_close(consumers[i].consumer);
+            }
+        }
+    }
+    if (run.producer)
+    {
+        tp_producer_close(run.producer);
+    }
+    free(consumers);
+    free(payload);
+    tp_bench_remove_regions(&regions);
+    return result;
+}
+
+static size_t parse_counts(const char *list, size_t *counts, size_t capacity)
+{
+    size_t count = 0;
+    const char *cursor = list;
+
+    while (cursor && *cursor != '\0' && count < capacity)
+    {
+        char *end = NULL;
+        unsigned long value = strtoul(cursor, &end, 10);
+
+        if (end == cursor || value == 0 || value > TP_BENCH_THROUGHPUT_MAX_CONSUMERS)
+        {
+            return 0;
+        }
+        counts[count++] = (size_t)value;
+        cursor = (*end == ',') ? end + 1 : end;
+    }
+
+    return count;
+}
+
+static int init_client(tp_client_t **client, const char *aeron_dir, const char *channel)
+{
+    tp_context_t *context = NULL;
+    const char *allowed_paths[] = { "/dev/shm", "/tmp" };
+
+    if (tp_example_init_client_context_nodriver(&context, aeron_dir, channel, allowed_paths, 2) < 0)
+    {
+        fprintf(stderr, "Failed to init context\n");
+        return -1;
+    }
+
+    if (tp_client_init(client, context) < 0 || tp_client_start(*client) < 0)
+    {
+        fprintf(stderr, "Client init failed: %s\n", tp_errmsg());
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    tp_client_t *producer_client = NULL;
+    tp_client_t *consumer_client = NULL;
+    char embedded_dir[4096];
+    const char *aeron_dir = NULL;
+    const char *channel = "aeron:ipc";
+    const char *count_list = "1,4,16,64";
+    size_t counts[TP_BENCH_THROUGHPUT_MAX_COUNTS];
+    size_t count_len;
+    uint32_t stream_id = 10000;
+    uint32_t payload_len = 4096;
+    uint32_t nslots = 1024;
+    uint32_t per_consumer_every = 2;
+    uint32_t rate_limited_every = 4;
+    uint32_t max_rate_hz = 1000;
+    int64_t duration_ms = 2000;
+    uint64_t epoch = 1;
+    bool use_claim = false;
+    bool embedded = false;
+    int result = 1;
+    int opt;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "a:c:s:N:b:n:d:P:R:z:Ch")) != -1)
+    {
+        switch (opt)
+        {
+            case 'a':
+                aeron_dir = optarg;
+                break;
+            case 'c':
+                channel = optarg;
+                break;
+            case 's':
+                stream_id = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'N':
+                count_list = optarg;
+                break;
+            case 'b':
+                payload_len = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                nslots = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                duration_ms = (int64_t)strtoll(optarg, NULL, 10);
+                break;
+            case 'P':
+                per_consumer_every = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'R':
+                rate_limited_every = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'z':
+                max_rate_hz = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'C':
+                use_claim = true;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    count_len = parse_counts(count_list, counts, TP_BENCH_THROUGHPUT_MAX_COUNTS);
+    if (count_len == 0 || stream_id == 0 || payload_len == 0 || duration_ms <= 0 ||
+        nslots == 0 || (nslots & (nslots - 1)) != 0 || optind < argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (NULL == aeron_dir)
+    {
+        if (tp_bench_start_embedded_driver(embedded_dir, sizeof(embedded_dir)) == 0)
+        {
+            aeron_dir = embedded_dir;
+            embedded = true;
+        }
+        else
+        {
+            aeron_dir = getenv("AERON_DIR");
+        }
+    }
+    if (NULL == aeron_dir || aeron_dir[0] == '\0')
+    {
+        fprintf(stderr, "No Aeron directory: pass -a or set AERON_DIR\n");
+        return 1;
+    }
+
+    if (init_client(&producer_client, aeron_dir, channel) < 0 ||
+        init_client(&consumer_client, aeron_dir, channel) < 0)
+    {
+        goto cleanup;
+    }
+
+    printf("# aeron_dir=%s embedded_driver=%d payload=%u nslots=%u duration_ms=%" PRId64 " api=%s max_rate_hz=%u\n",
+        aeron_dir,
+        embedded ? 1 : 0,
+        payload_len,
+        nslots,
+        duration_ms,
+        use_claim ? "try_claim" : "offer_frame",
+        max_rate_hz);
+    printf("%9s %6s %6s %12s %12s %9s %12s %9s %10s %10s %8s %8s\n",
+        "consumers", "per_c", "rate_l", "frames", "frames/s", "GB/s", "delivered", "rx_GB/s",
+        "drops_gap", "drops_late", "offer_f", "errors");
+
+    for (i = 0; i < count_len; i++)
+    {
+        if (run_count(
+                producer_client,
+                consumer_client,
+                stream_id,
+                epoch++,
+                nslots,
+                payload_len,
+                counts[i],
+                per_consumer_every,
+                rate_limited_every,
+                max_rate_hz,
+                duration_ms * 1000LL * 1000LL,
+                use_claim) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    result = 0;
+
+cleanup:
+    if (consumer_client)
+    {
+        tp_client_close(consumer_client);
+    }
+    if (producer_client)
+    {
+        tp_client_close(producer_client);
+    }
+    if (embedded)
+    {
+        tp_bench_stop_embedded_driver();
+    }
+    return result;
+}
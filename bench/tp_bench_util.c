@@ -0,0 +1,290 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tp_bench_util.h"
+
+#include "tensor_pool/tp.h"
+
+#include "wire/tensor_pool/regionType.h"
+#include "wire/tensor_pool/shmRegionSuperblock.h"
+
+#ifdef TP_BENCH_EMBEDDED_DRIVER
+#include "aeronmd.h"
+#include "aeronc.h"
+#include "aeron_common.h"
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+uint32_t tp_bench_round_stride(uint32_t length)
+{
+    uint32_t stride = (length + 63u) & ~63u;
+    return stride == 0 ? 64u : stride;
+}
+
+int tp_bench_parse_copy_engine(const char *name, tp_copy_engine_t *out)
+{
+    static const struct
+    {
+        const char *name;
+        tp_copy_engine_t engine;
+    }
+    engines[] =
+    {
+        { "memcpy", TP_COPY_ENGINE_MEMCPY },
+        { "auto", TP_COPY_ENGINE_AUTO },
+        { "sse2", TP_COPY_ENGINE_SSE2 },
+        { "avx2", TP_COPY_ENGINE_AVX2 },
+        { "avx512", TP_COPY_ENGINE_AVX512 }
+    };
+    size_t i;
+
+    if (NULL == name || NULL == out)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < sizeof(engines) / sizeof(engines[0]); i++)
+    {
+        if (0 == strcmp(name, engines[i].name))
+        {
+            *out = engines[i].engine;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static int tp_bench_write_region(
+    const char *path,
+    uint32_t stream_id,
+    uint64_t epoch,
+    int16_t region_type,
+    uint16_t pool_id,
+    uint32_t nslots,
+    uint32_t slot_bytes,
+    uint32_t stride_bytes,
+    size_t file_size)
+{
+    uint8_t buffer[TP_SUPERBLOCK_SIZE_BYTES];
+    struct tensor_pool_shmRegionSuperblock block;
+    int fd;
+
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+    {
+        fprintf(stderr, "open %s failed: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(fd, (off_t)file_size) != 0)
+    {
+        fprintf(stderr, "ftruncate %s failed: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+    tensor_pool_shmRegionSuperblock_wrap_for_encode(&block, (char *)buffer, 0, sizeof(buffer));
+    tensor_pool_shmRegionSuperblock_set_magic(&block, TP_MAGIC_U64);
+    tensor_pool_shmRegionSuperblock_set_layoutVersion(&block, TP_LAYOUT_VERSION);
+    tensor_pool_shmRegionSuperblock_set_epoch(&block, epoch);
+    tensor_pool_shmRegionSuperblock_set_streamId(&block, stream_id);
+    tensor_pool_shmRegionSuperblock_set_regionType(&block, region_type);
+    tensor_pool_shmRegionSuperblock_set_poolId(&block, pool_id);
+    tensor_pool_shmRegionSuperblock_set_nslots(&block, nslots);
+    tensor_pool_shmRegionSuperblock_set_slotBytes(&block, slot_bytes);
+    tensor_pool_shmRegionSuperblock_set_strideBytes(&block, stride_bytes);
+    tensor_pool_shmRegionSuperblock_set_pid(&block, (uint64_t)getpid());
+    tensor_pool_shmRegionSuperblock_set_startTimestampNs(&block, (uint64_t)tp_clock_now_ns());
+    tensor_pool_shmRegionSuperblock_set_activityTimestampNs(&block, (uint64_t)tp_clock_now_ns());
+
+    if (pwrite(fd, buffer, sizeof(buffer), 0) != (ssize_t)sizeof(buffer))
+    {
+        fprintf(stderr, "superblock write %s failed: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    close(fd);
+    return 0;
+}
+
+int tp_bench_create_regions(
+    tp_bench_regions_t *regions,
+    uint32_t stream_id,
+    uint64_t epoch,
+    uint16_t pool_id,
+    uint32_t nslots,
+    uint32_t stride_bytes)
+{
+    struct stat st;
+    const char *base = "/tmp";
+
+    if (NULL == regions || nslots == 0 || stride_bytes == 0)
+    {
+        return -1;
+    }
+
+    memset(regions, 0, sizeof(*regions));
+    if (stat("/dev/shm", &st) == 0 && S_ISDIR(st.st_mode))
+    {
+        base = "/dev/shm";
+    }
+
+    snprintf(regions->dir, sizeof(regions->dir), "%s/tp_bench_XXXXXX", base);
+    if (NULL == mkdtemp(regions->dir))
+    {
+        fprintf(stderr, "mkdtemp failed: %s\n", strerror(errno));
+        regions->dir[0] = '\0';
+        return -1;
+    }
+
+    snprintf(regions->header_path, sizeof(regions->header_path), "%s/header.ring", regions->dir);
+    snprintf(regions->pool_path, sizeof(regions->pool_path), "%s/%u.pool", regions->dir, (unsigned)pool_id);
+    snprintf(regions->header_uri, sizeof(regions->header_uri), "shm:file?path=%s", regions->header_path);
+    snprintf(regions->pool_uri, sizeof(regions->pool_uri), "shm:file?path=%s", regions->pool_path);
+
+    if (tp_bench_write_region(
+            regions->header_path,
+            stream_id,
+            epoch,
+            tensor_pool_regionType_HEADER_RING,
+            0,
+            nslots,
+            TP_HEADER_SLOT_BYTES,
+            0,
+            TP_SUPERBLOCK_SIZE_BYTES + ((size_t)nslots * TP_HEADER_SLOT_BYTES)) < 0 ||
+        tp_bench_write_region(
+            regions->pool_path,
+            stream_id,
+            epoch,
+            tensor_pool_regionType_PAYLOAD_POOL,
+            pool_id,
+            nslots,
+            TP_NULL_U32,
+            stride_bytes,
+            TP_SUPERBLOCK_SIZE_BYTES + ((size_t)nslots * stride_bytes)) < 0)
+    {
+        tp_bench_remove_regions(regions);
+        return -1;
+    }
+
+    return 0;
+}
+
+void tp_bench_remove_regions(tp_bench_regions_t *regions)
+{
+    if (NULL == regions || regions->dir[0] == '\0')
+    {
+        return;
+    }
+
+    if (regions->header_path[0] != '\0')
+    {
+        unlink(regions->header_path);
+    }
+    if (regions->pool_path[0] != '\0')
+    {
+        unlink(regions->pool_path);
+    }
+    rmdir(regions->dir);
+    regions->dir[0] = '\0';
+}
+
+#ifdef TP_BENCH_EMBEDDED_DRIVER
+typedef struct tp_bench_driver_state_stct
+{
+    aeron_driver_context_t *context;
+    aeron_driver_t *driver;
+    char dir[AERON_MAX_PATH];
+}
+tp_bench_driver_state_t;
+
+static tp_bench_driver_state_t tp_bench_driver_state;
+
+void tp_bench_stop_embedded_driver(void)
+{
+    tp_bench_driver_state_t *state = &tp_bench_driver_state;
+
+    if (state->driver)
+    {
+        aeron_driver_close(state->driver);
+        state->driver = NULL;
+    }
+    if (state->context)
+    {
+        aeron_driver_context_close(state->context);
+        state->context = NULL;
+    }
+    if (state->dir[0] != '\0')
+    {
+        aeron_delete_directory(state->dir);
+        state->dir[0] = '\0';
+    }
+}
+
+int tp_bench_start_embedded_driver(char *aeron_dir, size_t aeron_dir_len)
+{
+    tp_bench_driver_state_t *state = &tp_bench_driver_state;
+    char dir_template[] = "/dev/shm/tp_aeron_bench_XXXXXX";
+    aeron_cnc_t *cnc = NULL;
+    char *dir;
+
+    if (NULL == aeron_dir || aeron_dir_len == 0)
+    {
+        return -1;
+    }
+
+    memset(state, 0, sizeof(*state));
+    dir = mkdtemp(dir_template);
+    if (NULL == dir)
+    {
+        return -1;
+    }
+    strncpy(state->dir, dir, sizeof(state->dir) - 1);
+
+    if (aeron_driver_context_init(&state->context) < 0 ||
+        aeron_driver_context_set_dir(state->context, state->dir) < 0 ||
+        aeron_driver_context_set_dir_delete_on_start(state->context, true) < 0 ||
+        aeron_driver_context_set_dir_delete_on_shutdown(state->context, true) < 0 ||
+        aeron_driver_context_set_threading_mode(state->context, AERON_THREADING_MODE_DEDICATED) < 0 ||
+        aeron_driver_init(&state->driver, state->context) < 0 ||
+        aeron_driver_start(state->driver, false) < 0)
+    {
+        tp_bench_stop_embedded_driver();
+        return -1;
+    }
+
+    if (aeron_cnc_init(&cnc, state->dir, 1000) < 0)
+    {
+        tp_bench_stop_embedded_driver();
+        return -1;
+    }
+    aeron_cnc_close(cnc);
+
+    strncpy(aeron_dir, state->dir, aeron_dir_len - 1);
+    aeron_dir[aeron_dir_len - 1] = '\0';
+    return 0;
+}
+#else
+int tp_bench_start_embedded_driver(char *aeron_dir, size_t aeron_dir_len)
+{
+    (void)aeron_dir;
+    (void)aeron_dir_len;
+    return -1;
+}
+
+void tp_bench_stop_embedded_driver(void)
+{
+}
+#endif
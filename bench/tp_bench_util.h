@@ -0,0 +1,47 @@
+#ifndef TENSOR_POOL_TP_BENCH_UTIL_H
+#define TENSOR_POOL_TP_BENCH_UTIL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensor_pool/tp_copy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tp_bench_regions_stct
+{
+    char dir[4096];
+    char header_path[4096];
+    char pool_path[4096];
+    char header_uri[4200];
+    char pool_uri[4200];
+}
+tp_bench_regions_t;
+
+/* Creates a header ring and a single payload pool with valid superblocks in a fresh temp dir. */
+int tp_bench_create_regions(
+    tp_bench_regions_t *regions,
+    uint32_t stream_id,
+    uint64_t epoch,
+    uint16_t pool_id,
+    uint32_t nslots,
+    uint32_t stride_bytes);
+void tp_bench_remove_regions(tp_bench_regions_t *regions);
+
+/* Starts an in-process Aeron media driver when built with TP_BENCH_EMBEDDED_DRIVER, else returns -1. */
+int tp_bench_start_embedded_driver(char *aeron_dir, size_t aeron_dir_len);
+void tp_bench_stop_embedded_driver(void);
+
+uint32_t tp_bench_round_stride(uint32_t length);
+
+/* Parses memcpy|auto|sse2|avx2|avx512 into a copy engine; returns -1 on an unknown name. */
+int tp_bench_parse_copy_engine(const char *name, tp_copy_engine_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -64,7 +64,7 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     producer.header_region.addr = header_region;
     producer.pool_count = 1;
     producer.pools = &pool;
-    producer.next_seq = tp_fuzz_u32(data, size, &offset);
+    atomic_store(&producer.next_seq, tp_fuzz_u32(data, size, &offset));
 
     pool.pool_id = (uint16_t)(tp_fuzz_u32(data, size, &offset) | 1u);
     pool.nslots = nslots;
@@ -9,6 +9,7 @@
 #include "tensor_pool/tp_driver_client.h"
 #include "tensor_pool/tp_handles.h"
 #include "tensor_pool/tp_join_barrier.h"
+#include "tensor_pool/tp_latency.h"
 #include "tensor_pool/tp_log.h"
 #include "tensor_pool/tp_tracelink.h"
 
@@ -58,7 +59,8 @@ tp_metadata_handlers_t;
 typedef enum tp_qos_event_type_enum
 {
     TP_QOS_EVENT_PRODUCER,
-    TP_QOS_EVENT_CONSUMER
+    TP_QOS_EVENT_CONSUMER,
+    TP_QOS_EVENT_CONSUMER_LATENCY
 }
 tp_qos_event_type_t;
 
@@ -75,6 +77,8 @@ typedef struct tp_qos_event_stct
     uint64_t drops_gap;
     uint64_t drops_late;
     tp_mode_t mode;
+    tp_latency_summary_t arrival_latency;
+    tp_latency_summary_t read_latency;
 }
 tp_qos_event_t;
 
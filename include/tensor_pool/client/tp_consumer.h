@@ -7,10 +7,12 @@
 #include "tensor_pool/tp_client.h"
 #include "tensor_pool/tp_driver_client.h"
 #include "tensor_pool/tp_control.h"
+#include "tensor_pool/tp_copy.h"
 #include "tensor_pool/tp_shm.h"
 #include "tensor_pool/tp_tensor.h"
 #include "tensor_pool/tp_types.h"
 #include "tensor_pool/tp_handles.h"
+#include "tensor_pool/tp_latency.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,6 +20,7 @@ extern "C" {
 
 typedef struct tp_consumer_stct tp_consumer_t;
 typedef struct tp_frame_progress_stct tp_frame_progress_t;
+typedef struct tp_consumer_mapping_stct tp_consumer_mapping_t;
 
 typedef struct tp_consumer_pool_config_stct
 {
@@ -57,6 +60,11 @@ typedef struct tp_consumer_context_stct
     bool use_conductor_polling;
     tp_driver_attach_request_t driver_request;
     tp_consumer_hello_t hello;
+    tp_copy_engine_t payload_copy_engine;
+    size_t payload_copy_threshold;
+    bool follow_ring;
+    bool latest_only;
+    bool track_latency;
 }
 tp_consumer_context_t;
 
@@ -89,12 +97,30 @@ typedef struct tp_frame_view_stct
     uint32_t payload_slot;
     uint64_t timestamp_ns;
     uint32_t meta_version;
+    uint64_t seq;
 }
 tp_frame_view_t;
 
 int tp_consumer_context_init(tp_consumer_context_t *ctx);
 int tp_consumer_context_init_default(tp_consumer_context_t *ctx, uint32_t stream_id, uint32_t consumer_id, bool use_driver);
 void tp_consumer_context_set_use_conductor_polling(tp_consumer_context_t *ctx, bool enabled);
+void tp_consumer_context_set_payload_copy_engine(
+    tp_consumer_context_t *ctx,
+    tp_copy_engine_t engine,
+    size_t threshold_bytes);
+void tp_consumer_context_set_follow_ring(tp_consumer_context_t *ctx, bool enabled);
+/*
+ * Conflating mode: each descriptor poll delivers only the newest descriptor it received, and
+ * tp_consumer_poll_frames returns at most one frame. Superseded frames are counted by
+ * tp_consumer_conflated_count.
+ */
+void tp_consumer_context_set_latest_only(tp_consumer_context_t *ctx, bool enabled);
+/*
+ * Records descriptor arrival and read completion latency against the slot timestamp_ns of
+ * every frame read, and publishes percentiles in QosConsumerLatency. Only meaningful when the
+ * producer stamps slots from the same monotonic clock as tp_clock_now_ns.
+ */
+void tp_consumer_context_set_track_latency(tp_consumer_context_t *ctx, bool enabled);
 int tp_consumer_init(tp_consumer_t **consumer, tp_client_t *client, const tp_consumer_context_t *context);
 int tp_consumer_init_simple(
     tp_consumer_t **consumer,
@@ -109,11 +135,43 @@ void tp_consumer_clear_reattach(tp_consumer_t *consumer);
 void tp_consumer_set_descriptor_handler(tp_consumer_t *consumer, tp_frame_descriptor_handler_t handler, void *clientd);
 void tp_consumer_set_descriptor_handler_self(tp_consumer_t *consumer, tp_frame_descriptor_handler_t handler);
 int tp_consumer_read_frame(tp_consumer_t *consumer, uint64_t seq, tp_frame_view_t *out);
+/*
+ * Copies the payload into dst and re-checks seq_commit afterwards; out->payload points at dst.
+ * Returns 1 and counts drops_late if the producer overwrote the slot during the copy.
+ */
+int tp_consumer_read_frame_copy(
+    tp_consumer_t *consumer,
+    uint64_t seq,
+    tp_frame_view_t *out,
+    void *dst,
+    size_t dst_len);
+/*
+ * For zero-copy readers: call after finishing with a view from tp_consumer_read_frame.
+ * Returns 0 if the slot still holds seq, or 1 (counted as drops_late) if it was overwritten.
+ */
+int tp_consumer_validate_frame(tp_consumer_t *consumer, uint64_t seq);
+/*
+ * Reads the newest committed frame in the header ring, scanning the seq_commit words directly.
+ * Returns 1 when nothing newer than the previous call is committed.
+ */
+int tp_consumer_read_latest(tp_consumer_t *consumer, tp_frame_view_t *out);
 int tp_consumer_validate_progress(const tp_consumer_t *consumer, const tp_frame_progress_t *progress);
 int tp_consumer_get_drop_counts(const tp_consumer_t *consumer, uint64_t *drops_gap, uint64_t *drops_late, uint64_t *last_seq_seen);
 int tp_consumer_attach_driver_async(tp_consumer_t *consumer, tp_async_attach_t **out);
 int tp_consumer_attach_driver_poll(tp_consumer_t *consumer, tp_async_attach_t *async);
 int tp_consumer_poll_descriptors(tp_consumer_t *consumer, int fragment_limit);
+/*
+ * Polls up to max_frames descriptors and reads the matching frames as a batch, bypassing the
+ * descriptor handler. Returns the number of views written to out; frames that fail the
+ * seqlock checks are skipped and counted the same way as tp_consumer_read_frame.
+ */
+int tp_consumer_poll_frames(tp_consumer_t *consumer, tp_frame_view_t *out, size_t max_frames);
+/*
+ * Same-host ring following: reads frames straight from the header ring by expected seq
+ * without waiting for descriptors. Laps are counted in drops_gap. With follow_ring set the
+ * descriptor stream still drives the descriptor handler (trace_id) but not gap accounting.
+ */
+int tp_consumer_poll_ring(tp_consumer_t *consumer, tp_frame_view_t *out, size_t max_frames);
 int tp_consumer_poll_control(tp_consumer_t *consumer, int fragment_limit);
 int tp_consumer_set_progress_handler(tp_consumer_t *consumer, tp_frame_progress_handler_t handler, void *clientd);
 void tp_consumer_set_progress_handler_self(tp_consumer_t *consumer, tp_frame_progress_handler_t handler);
@@ -122,6 +180,43 @@ tp_subscription_t *tp_consumer_descriptor_subscription(tp_consumer_t *consumer);
 tp_subscription_t *tp_consumer_control_subscription(tp_consumer_t *consumer);
 tp_publication_t *tp_consumer_control_publication(tp_consumer_t *consumer);
 tp_publication_t *tp_consumer_qos_publication(tp_consumer_t *consumer);
+/*
+ * Descriptors skipped locally because hello.mode is RATE_LIMITED and the consumer is still on
+ * the shared descriptor stream. These frames were never read from SHM and are not drops.
+ */
+uint64_t tp_consumer_rate_limited_count(const tp_consumer_t *consumer);
+/* Frames superseded on purpose by latest-only reads. These are not losses. */
+uint64_t tp_consumer_conflated_count(const tp_consumer_t *consumer);
+/*
+ * Pins the current epoch's mapping so frame views read from it stay valid after a remap or
+ * unmap. Call on the consumer thread; release may happen on any thread. Returns NULL when
+ * nothing is mapped.
+ */
+tp_consumer_mapping_t *tp_consumer_hold_mapping(tp_consumer_t *consumer);
+void tp_consumer_release_mapping(tp_consumer_mapping_t *mapping);
+/*
+ * Epoch remaps completed so far and the time from the first frame that could not be read on
+ * the old epoch to the first frame read on the new one.
+ */
+int tp_consumer_get_remap_stats(
+    const tp_consumer_t *consumer,
+    uint64_t *remap_count,
+    uint64_t *last_gap_ns,
+    uint64_t *max_gap_ns);
+/*
+ * Copies the arrival (descriptor received minus slot timestamp) and read (read complete minus
+ * slot timestamp) histograms into the non-NULL outputs. Fails unless track_latency was set.
+ */
+int tp_consumer_get_latency(
+    const tp_consumer_t *consumer,
+    tp_latency_histogram_t *arrival,
+    tp_latency_histogram_t *read);
+int tp_consumer_reset_latency(tp_consumer_t *consumer);
+/*
+ * NUMA node holding the first slot of a mapped region, for pinning reader threads next to the
+ * payload. pool_id 0 selects the header ring. Hosts without NUMA report node 0.
+ */
+int tp_consumer_get_numa_node(const tp_consumer_t *consumer, uint16_t pool_id, int *node);
 uint32_t tp_consumer_assigned_descriptor_stream_id(const tp_consumer_t *consumer);
 uint32_t tp_consumer_assigned_control_stream_id(const tp_consumer_t *consumer);
 const char *tp_consumer_payload_fallback_uri(const tp_consumer_t *consumer);
@@ -0,0 +1,54 @@
+#ifndef TENSOR_POOL_TP_CONSUMER_GROUP_H
+#define TENSOR_POOL_TP_CONSUMER_GROUP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensor_pool/client/tp_consumer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tp_consumer_group_stct tp_consumer_group_t;
+
+typedef struct tp_consumer_group_context_stct
+{
+    uint32_t stream_budget;
+    int control_fragment_limit;
+}
+tp_consumer_group_context_t;
+
+int tp_consumer_group_context_init(tp_consumer_group_context_t *ctx);
+
+/*
+ * Polls many consumers from one loop. Consumers whose descriptor subscriptions share a channel
+ * and stream are served by a single subscription, with descriptors routed by stream_id; the
+ * client's control and announce streams are polled once per group poll and handed to every
+ * member. Members must not also be polled directly or by the conductor.
+ */
+int tp_consumer_group_init(tp_consumer_group_t **group, tp_client_t *client, const tp_consumer_group_context_t *ctx);
+int tp_consumer_group_close(tp_consumer_group_t *group);
+
+/*
+ * Adds a consumer keyed by its context stream_id, which must be unique in the group. Its
+ * descriptor subscription moves into the group, so close the group before its members.
+ */
+int tp_consumer_group_add(tp_consumer_group_t *group, tp_consumer_t *consumer);
+
+/*
+ * Polls up to fragment_limit descriptor fragments across all members. Subscriptions are
+ * visited round-robin from a rotating start, each taking at most stream_budget fragments per
+ * stream it serves per round, so one busy stream cannot starve the rest.
+ */
+int tp_consumer_group_poll(tp_consumer_group_t *group, int fragment_limit);
+
+size_t tp_consumer_group_member_count(const tp_consumer_group_t *group);
+/* Descriptors on a shared subscription whose stream_id has no member. */
+uint64_t tp_consumer_group_unrouted_count(const tp_consumer_group_t *group);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
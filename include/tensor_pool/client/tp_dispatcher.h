@@ -0,0 +1,60 @@
+#ifndef TENSOR_POOL_TP_DISPATCHER_H
+#define TENSOR_POOL_TP_DISPATCHER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensor_pool/client/tp_consumer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tp_dispatcher_stct tp_dispatcher_t;
+
+typedef void (*tp_dispatcher_process_fn_t)(void *clientd, const tp_frame_view_t *view, uint32_t worker_index);
+typedef void (*tp_dispatcher_complete_fn_t)(void *clientd, const tp_frame_view_t *view, bool valid);
+
+typedef struct tp_dispatcher_context_stct
+{
+    uint32_t worker_count;
+    uint32_t queue_capacity;
+    bool validate_after_process;
+    tp_dispatcher_process_fn_t process;
+    tp_dispatcher_complete_fn_t ordered_complete;
+    void *clientd;
+}
+tp_dispatcher_context_t;
+
+int tp_dispatcher_context_init(tp_dispatcher_context_t *ctx);
+
+/*
+ * Fans frames polled from one consumer out to worker threads. Each worker has its own queue
+ * and steals from its siblings when it runs dry. process runs on the workers in any order;
+ * when ordered_complete is set it is called once per frame in seq order after processing,
+ * with valid=false if validate_after_process found the slot overwritten while it was in use.
+ * Queued frames pin their epoch's mapping, so an epoch remap does not unmap them mid-process;
+ * close the dispatcher before the consumer.
+ */
+int tp_dispatcher_init(tp_dispatcher_t **dispatcher, tp_consumer_t *consumer, const tp_dispatcher_context_t *ctx);
+int tp_dispatcher_close(tp_dispatcher_t *dispatcher);
+
+/*
+ * Polls up to max_frames frames from the consumer and queues them, following the ring directly
+ * when the consumer was configured with follow_ring. Call from the thread that owns the
+ * consumer. Only as many frames as there is queue space for are polled.
+ */
+int tp_dispatcher_poll(tp_dispatcher_t *dispatcher, size_t max_frames);
+
+int tp_dispatcher_get_counts(
+    const tp_dispatcher_t *dispatcher,
+    uint64_t *processed,
+    uint64_t *stolen,
+    uint64_t *torn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
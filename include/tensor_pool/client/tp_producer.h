@@ -7,6 +7,7 @@
 
 #include "tensor_pool/tp_client.h"
 #include "tensor_pool/tp_control.h"
+#include "tensor_pool/tp_copy.h"
 #include "tensor_pool/tp_driver_client.h"
 #include "tensor_pool/tp_shm.h"
 #include "tensor_pool/tp_tensor.h"
@@ -63,6 +64,13 @@ typedef struct tp_producer_context_stct
     tp_driver_attach_request_t driver_request;
     void (*payload_flush)(void *clientd, void *payload, size_t length);
     void *payload_flush_clientd;
+    tp_copy_engine_t payload_copy_engine;
+    size_t payload_copy_threshold;
+    uint32_t payload_copy_threads;
+    size_t payload_copy_parallel_threshold;
+    size_t payload_copy_stripe_bytes;
+    bool concurrent_claims;
+    uint32_t reorder_window;
 }
 tp_producer_context_t;
 
@@ -92,6 +100,13 @@ typedef struct tp_frame_stct
 }
 tp_frame_t;
 
+typedef struct tp_iovec_stct
+{
+    const void *base;
+    size_t length;
+}
+tp_iovec_t;
+
 typedef struct tp_buffer_claim_stct
 {
     uint64_t seq;
@@ -127,6 +142,16 @@ void tp_producer_context_set_payload_flush(
     tp_producer_context_t *ctx,
     void (*payload_flush)(void *clientd, void *payload, size_t length),
     void *clientd);
+void tp_producer_context_set_payload_copy_engine(
+    tp_producer_context_t *ctx,
+    tp_copy_engine_t engine,
+    size_t threshold_bytes);
+void tp_producer_context_set_payload_copy_threads(
+    tp_producer_context_t *ctx,
+    uint32_t helper_threads,
+    size_t threshold_bytes,
+    size_t stripe_bytes);
+void tp_producer_context_set_concurrent_claims(tp_producer_context_t *ctx, bool enabled, uint32_t reorder_window);
 
 int tp_producer_init(tp_producer_t **producer, tp_client_t *client, const tp_producer_context_t *ctx);
 int tp_producer_init_simple(
@@ -137,7 +162,21 @@ int tp_producer_init_simple(
     bool use_driver);
 int tp_producer_attach(tp_producer_t *producer, const tp_producer_config_t *config);
 int64_t tp_producer_offer_frame(tp_producer_t *producer, const tp_frame_t *frame, tp_frame_metadata_t *meta);
+/*
+ * Gathers iov segments back to back into one payload slot under a single seqlock commit.
+ * frame->payload and frame->payload_len are ignored; the payload length is the segment sum.
+ */
+int64_t tp_producer_offer_framev(
+    tp_producer_t *producer,
+    const tp_frame_t *frame,
+    const tp_iovec_t *iov,
+    size_t iovcnt,
+    tp_frame_metadata_t *meta);
 int64_t tp_producer_try_claim(tp_producer_t *producer, size_t length, tp_buffer_claim_t *claim);
+/*
+ * A claim ends with exactly one commit or one abort. A failed commit has already released
+ * the claimed seq, so do not call tp_producer_abort_claim after it.
+ */
 int tp_producer_commit_claim(tp_producer_t *producer, tp_buffer_claim_t *claim, const tp_frame_metadata_t *meta);
 int tp_producer_abort_claim(tp_producer_t *producer, tp_buffer_claim_t *claim);
 int64_t tp_producer_queue_claim(tp_producer_t *producer, tp_buffer_claim_t *claim);
@@ -0,0 +1,38 @@
+#ifndef TENSOR_POOL_TP_COPY_H
+#define TENSOR_POOL_TP_COPY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum tp_copy_engine_enum
+{
+    TP_COPY_ENGINE_MEMCPY = 0,
+    TP_COPY_ENGINE_AUTO = 1,
+    TP_COPY_ENGINE_SSE2 = 2,
+    TP_COPY_ENGINE_AVX2 = 3,
+    TP_COPY_ENGINE_AVX512 = 4
+}
+tp_copy_engine_t;
+
+#define TP_COPY_NT_THRESHOLD_DEFAULT (256u * 1024u)
+#define TP_COPY_PARALLEL_THRESHOLD_DEFAULT (8u * 1024u * 1024u)
+
+typedef void (*tp_copy_fn_t)(void *dst, const void *src, size_t length);
+
+/*
+ * Non-temporal engines write the destination with streaming stores and end with a store fence,
+ * so the copied bytes bypass the producer's cache and are ordered before a following commit.
+ * Requesting an engine the CPU does not support resolves to the best supported one below it.
+ */
+tp_copy_engine_t tp_copy_engine_resolve(tp_copy_engine_t engine);
+tp_copy_fn_t tp_copy_engine_fn(tp_copy_engine_t engine);
+const char *tp_copy_engine_name(tp_copy_engine_t engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef TENSOR_POOL_TP_LATENCY_H
+#define TENSOR_POOL_TP_LATENCY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Log-linear latency histogram: values below 16ns get their own bucket, and every power of two
+ * above that is split into 16 linear sub-buckets, so a bucket is never wider than 1/16 of its
+ * value. Values at or above 2^40ns (about 18 minutes) land in the last bucket.
+ */
+enum
+{
+    TP_LATENCY_SUB_BUCKET_BITS = 4,
+    TP_LATENCY_SUB_BUCKETS = 1 << TP_LATENCY_SUB_BUCKET_BITS,
+    TP_LATENCY_MAX_BITS = 40,
+    TP_LATENCY_BUCKETS = (TP_LATENCY_MAX_BITS - TP_LATENCY_SUB_BUCKET_BITS + 1) * TP_LATENCY_SUB_BUCKETS
+};
+
+typedef struct tp_latency_histogram_stct
+{
+    uint64_t counts[TP_LATENCY_BUCKETS];
+    uint64_t count;
+    uint64_t min_ns;
+    uint64_t max_ns;
+}
+tp_latency_histogram_t;
+
+typedef struct tp_latency_summary_stct
+{
+    uint64_t count;
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+}
+tp_latency_summary_t;
+
+void tp_latency_histogram_reset(tp_latency_histogram_t *histogram);
+void tp_latency_histogram_record(tp_latency_histogram_t *histogram, uint64_t value_ns);
+
+/*
+ * Returns the upper bound of the bucket holding the given percentile (0-100), capped at the
+ * largest recorded value, or 0 when the histogram is empty.
+ */
+uint64_t tp_latency_histogram_percentile(const tp_latency_histogram_t *histogram, double percentile);
+int tp_latency_histogram_summarize(const tp_latency_histogram_t *histogram, tp_latency_summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
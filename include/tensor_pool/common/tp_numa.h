@@ -0,0 +1,56 @@
+#ifndef TENSOR_POOL_TP_NUMA_H
+#define TENSOR_POOL_TP_NUMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum
+{
+    TP_NUMA_MAX_NODES = 64
+};
+
+typedef enum tp_numa_mode_enum
+{
+    TP_NUMA_DEFAULT = 0,
+    TP_NUMA_PREFERRED = 1,
+    TP_NUMA_BIND = 2,
+    TP_NUMA_INTERLEAVE = 3
+}
+tp_numa_mode_t;
+
+/*
+ * Memory placement for a mapped range. nodes holds one bit per node id; PREFERRED uses the
+ * lowest set node, and an empty INTERLEAVE set spreads over every node the process may use.
+ */
+typedef struct tp_numa_policy_stct
+{
+    tp_numa_mode_t mode;
+    uint64_t nodes;
+}
+tp_numa_policy_t;
+
+int tp_numa_parse_mode(const char *name, tp_numa_mode_t *out);
+const char *tp_numa_mode_name(tp_numa_mode_t mode);
+
+/* Number of memory nodes on the host; 1 when the kernel exposes no NUMA topology. */
+int tp_numa_node_count(void);
+
+/*
+ * Applies policy to the pages backing [addr, addr + length). For tmpfs files the policy sticks
+ * to the file, so pages allocated later through any mapping or fallocate follow it. Fails
+ * with ENOSYS where the platform has no NUMA support and EINVAL for nodes the host lacks.
+ */
+int tp_numa_apply(void *addr, size_t length, const tp_numa_policy_t *policy);
+
+/* Node holding the page at addr, faulting it in if needed; 0 on hosts without NUMA support. */
+int tp_numa_node_of(const void *addr, int *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
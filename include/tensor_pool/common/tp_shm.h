@@ -13,6 +13,9 @@
 extern "C" {
 #endif
 
+/* PMD size of a transparent hugepage on 4 KiB-page x86_64 and arm64 kernels. */
+#define TP_SHM_TRANSPARENT_HUGEPAGE_BYTES (2u * 1024u * 1024u)
+
 typedef struct tp_allowed_paths_stct
 {
     const char **paths;
@@ -26,6 +29,8 @@ typedef struct tp_allowed_paths_stct
 }
 tp_allowed_paths_t;
 
+typedef struct tp_shm_shared_stct tp_shm_shared_t;
+
 typedef struct tp_shm_region_stct
 {
     int fd;
@@ -33,6 +38,7 @@ typedef struct tp_shm_region_stct
     void *addr;
     tp_shm_uri_t uri;
     uint64_t pid;
+    tp_shm_shared_t *shared;
 }
 tp_shm_region_t;
 
@@ -50,12 +56,37 @@ typedef struct tp_shm_expected_stct
 tp_shm_expected_t;
 
 int tp_shm_map(tp_shm_region_t *region, const char *uri, int writable, const tp_allowed_paths_t *allowed, tp_log_t *log);
+/*
+ * Read-only map through the process-wide cache: regions mapped for the same canonical path and
+ * epoch share one mapping and fd, which is unmapped when the last of them goes through
+ * tp_shm_unmap. Mapping a newer epoch of a path, or a file replaced at the same path, never
+ * reuses the old mapping. region->fd belongs to the cache and must not be closed directly.
+ */
+int tp_shm_map_shared(
+    tp_shm_region_t *region,
+    const char *uri,
+    uint64_t epoch,
+    const tp_allowed_paths_t *allowed,
+    tp_log_t *log);
 int tp_shm_unmap(tp_shm_region_t *region, tp_log_t *log);
+/* Cached mappings currently open, and lifetime hit/miss counts for tp_shm_map_shared. */
+int tp_shm_cache_get_stats(size_t *entries, uint64_t *hits, uint64_t *misses);
 int tp_shm_validate_superblock(const tp_shm_region_t *region, const tp_shm_expected_t *expected, tp_log_t *log);
 int tp_shm_validate_stride_alignment(const char *uri, uint32_t stride_bytes, tp_log_t *log);
 int tp_shm_update_activity_timestamp(tp_shm_region_t *region, uint64_t now_ns, tp_log_t *log);
 int tp_shm_read_activity_timestamp(const tp_shm_region_t *region, uint64_t *out, tp_log_t *log);
 int tp_shm_read_pid(const tp_shm_region_t *region, uint64_t *out, tp_log_t *log);
+/*
+ * Returns 1 when files under path are on a tmpfs mount that can back MADV_HUGEPAGE mappings
+ * with transparent hugepages (huge=advise, always or within_size, or shmem_enabled=force),
+ * 0 when they cannot, -1 on error.
+ */
+int tp_shm_transparent_hugepages_supported(const char *path);
+/*
+ * Reads /proc/self/smaps for the mappings overlapping [addr, addr + length) and reports how
+ * many resident bytes are mapped with hugepages. Pages not yet faulted in count towards neither.
+ */
+int tp_shm_hugepage_coverage(const void *addr, size_t length, size_t *huge_bytes, size_t *resident_bytes);
 
 #ifdef __cplusplus
 }
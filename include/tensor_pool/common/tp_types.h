@@ -87,6 +87,7 @@ tp_response_code_t;
 #define TP_HUGEPAGES_UNSPECIFIED tensor_pool_hugepagesPolicy_UNSPECIFIED
 #define TP_HUGEPAGES_STANDARD tensor_pool_hugepagesPolicy_STANDARD
 #define TP_HUGEPAGES_HUGEPAGES tensor_pool_hugepagesPolicy_HUGEPAGES
+#define TP_HUGEPAGES_TRANSPARENT tensor_pool_hugepagesPolicy_TRANSPARENT
 #define TP_HUGEPAGES_NULL tensor_pool_hugepagesPolicy_NULL_VALUE
 
 #define TP_DTYPE_UNKNOWN tensor_pool_dtype_UNKNOWN
@@ -14,6 +14,7 @@ typedef struct tp_shm_uri_stct
 {
     char path[4096];
     bool require_hugepages;
+    bool transparent_hugepages;
 }
 tp_shm_uri_t;
 
@@ -9,6 +9,7 @@
 #include "tensor_pool/tp_context.h"
 #include "tensor_pool/tp_handles.h"
 #include "tensor_pool/tp_log.h"
+#include "tensor_pool/tp_numa.h"
 #include "tensor_pool/tp_supervisor.h"
 
 #ifdef __cplusplus
@@ -28,6 +29,7 @@ typedef struct tp_driver_profile_stct
     uint32_t header_nslots;
     tp_driver_pool_def_t *pools;
     size_t pool_count;
+    tp_numa_policy_t numa;
 }
 tp_driver_profile_t;
 
@@ -36,6 +38,8 @@ typedef struct tp_driver_stream_def_stct
     char name[128];
     uint32_t stream_id;
     tp_driver_profile_t *profile;
+    tp_numa_policy_t numa;
+    bool numa_configured;
 }
 tp_driver_stream_def_t;
 
@@ -61,6 +65,7 @@ typedef struct tp_driver_config_stct
     char shm_base_dir[4096];
     char shm_namespace[256];
     bool require_hugepages;
+    bool transparent_hugepages;
     uint32_t page_size_bytes;
     uint32_t permissions_mode;
     char **allowed_base_dirs;
@@ -72,6 +77,8 @@ typedef struct tp_driver_config_stct
     uint32_t lease_expiry_grace_intervals;
     bool prefault_shm;
     bool mlock_shm;
+    uint32_t provision_workers;
+    bool spare_epochs;
     bool epoch_gc_enabled;
     uint32_t epoch_gc_keep;
     uint64_t epoch_gc_min_age_ns;
@@ -107,6 +114,10 @@ typedef struct tp_driver_stct
     void *node_id_cooldowns;
     size_t node_id_cooldown_count;
     size_t node_id_cooldown_capacity;
+    void *provisioner;
+    void *pending_attaches;
+    size_t pending_attach_count;
+    size_t pending_attach_capacity;
     bool supervisor_enabled;
     tp_supervisor_t supervisor;
 }
@@ -10,6 +10,7 @@
 #include "tensor_pool/tp_control.h"
 #include "tensor_pool/client/tp_control_view.h"
 #include "tensor_pool/tp_handles.h"
+#include "tensor_pool/tp_latency.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,6 +61,7 @@ typedef struct tp_supervisor_stct
     uint64_t config_count;
     uint64_t qos_consumer_count;
     uint64_t qos_producer_count;
+    uint64_t qos_latency_count;
     uint64_t announce_count;
     uint64_t metadata_count;
 }
@@ -71,11 +73,21 @@ typedef struct tp_supervisor_stats_stct
     uint64_t config_count;
     uint64_t qos_consumer_count;
     uint64_t qos_producer_count;
+    uint64_t qos_latency_count;
     uint64_t announce_count;
     uint64_t metadata_count;
 }
 tp_supervisor_stats_t;
 
+typedef struct tp_supervisor_consumer_latency_stct
+{
+    uint32_t consumer_id;
+    uint64_t last_report_ns;
+    tp_latency_summary_t arrival;
+    tp_latency_summary_t read;
+}
+tp_supervisor_consumer_latency_t;
+
 int tp_supervisor_config_init(tp_supervisor_config_t *config);
 int tp_supervisor_config_load(tp_supervisor_config_t *config, const char *path);
 void tp_supervisor_config_close(tp_supervisor_config_t *config);
@@ -90,6 +102,14 @@ int tp_supervisor_handle_hello(
     const tp_consumer_hello_view_t *hello,
     tp_consumer_config_msg_t *out_config);
 int tp_supervisor_get_stats(const tp_supervisor_t *supervisor, tp_supervisor_stats_t *out);
+/*
+ * Fills out with the registered consumers that have reported QosConsumerLatency, slowest read
+ * p99 first, and returns how many were written (at most capacity).
+ */
+int tp_supervisor_rank_consumers_by_latency(
+    tp_supervisor_t *supervisor,
+    tp_supervisor_consumer_latency_t *out,
+    size_t capacity);
 
 #ifdef __cplusplus
 }
@@ -3,16 +3,21 @@
 
 #include "tensor_pool/client/tp_client.h"
 #include "tensor_pool/client/tp_consumer.h"
+#include "tensor_pool/client/tp_consumer_group.h"
 #include "tensor_pool/client/tp_control.h"
 #include "tensor_pool/client/tp_discovery_client.h"
+#include "tensor_pool/client/tp_dispatcher.h"
 #include "tensor_pool/client/tp_driver_client.h"
 #include "tensor_pool/client/tp_producer.h"
 #include "tensor_pool/common/tp_clock.h"
 #include "tensor_pool/common/tp_agent.h"
+#include "tensor_pool/common/tp_copy.h"
 #include "tensor_pool/common/tp_error.h"
 #include "tensor_pool/common/tp_join_barrier.h"
+#include "tensor_pool/common/tp_latency.h"
 #include "tensor_pool/common/tp_log.h"
 #include "tensor_pool/common/tp_merge_map.h"
+#include "tensor_pool/common/tp_numa.h"
 #include "tensor_pool/common/tp_shm.h"
 #include "tensor_pool/common/tp_trace.h"
 #include "tensor_pool/common/tp_tracelink.h"
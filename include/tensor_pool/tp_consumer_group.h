@@ -0,0 +1,6 @@
+#ifndef TENSOR_POOL_tp_consumer_group_h
+#define TENSOR_POOL_tp_consumer_group_h
+
+#include "tensor_pool/client/tp_consumer_group.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TENSOR_POOL_tp_copy_h
+#define TENSOR_POOL_tp_copy_h
+
+#include "tensor_pool/common/tp_copy.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TENSOR_POOL_tp_dispatcher_h
+#define TENSOR_POOL_tp_dispatcher_h
+
+#include "tensor_pool/client/tp_dispatcher.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TENSOR_POOL_tp_latency_h
+#define TENSOR_POOL_tp_latency_h
+
+#include "tensor_pool/common/tp_latency.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TENSOR_POOL_tp_numa_h
+#define TENSOR_POOL_tp_numa_h
+
+#include "tensor_pool/common/tp_numa.h"
+
+#endif
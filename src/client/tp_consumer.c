@@ -4,6 +4,7 @@
 
 #include <errno.h>
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -11,6 +12,7 @@
 
 #include "tensor_pool/tp_clock.h"
 #include "tensor_pool/tp_error.h"
+#include "tensor_pool/tp_numa.h"
 #include "tensor_pool/internal/tp_qos.h"
 #include "tensor_pool/internal/tp_control_adapter.h"
 #include "tensor_pool/internal/tp_context.h"
@@ -31,6 +33,9 @@
 #include "wire/tensor_pool/tensorHeader.h"
 
 enum { TP_CONSUMER_DEFAULT_FRAGMENT_LIMIT = 10 };
+enum { TP_CONSUMER_BATCH_MAX = 64 };
+enum { TP_CONSUMER_CACHE_LINE_BYTES = 64 };
+enum { TP_CONSUMER_LATEST_ATTEMPTS = 3 };
 
 static int tp_consumer_poll_dispatch(void *clientd, int fragment_limit);
 
@@ -56,6 +61,216 @@ static int tp_is_power_of_two(uint32_t value)
     return value != 0 && (value & (value - 1)) == 0;
 }
 
+static void tp_consumer_free_header_cache(tp_consumer_t *consumer)
+{
+    if (consumer->header_cache)
+    {
+        aeron_free(consumer->header_cache);
+        consumer->header_cache = NULL;
+    }
+}
+
+static bool tp_consumer_header_cache_load(
+    const tp_consumer_t *consumer,
+    uint32_t header_index,
+    uint64_t seq_commit,
+    tp_slot_view_t *slot_view,
+    tp_tensor_header_t *tensor,
+    const uint8_t **payload)
+{
+    const tp_consumer_header_cache_entry_t *entry;
+
+    if (NULL == consumer->header_cache)
+    {
+        return false;
+    }
+
+    entry = &consumer->header_cache[header_index];
+    if (atomic_load_explicit(&entry->seq_commit, memory_order_acquire) != seq_commit)
+    {
+        return false;
+    }
+
+    *tensor = entry->tensor;
+    slot_view->seq_commit = seq_commit;
+    slot_view->values_len_bytes = entry->values_len_bytes;
+    slot_view->payload_slot = entry->payload_slot;
+    slot_view->pool_id = entry->pool_id;
+    slot_view->payload_offset = 0;
+    slot_view->timestamp_ns = entry->timestamp_ns;
+    slot_view->meta_version = entry->meta_version;
+    slot_view->header_bytes_length = 0;
+    slot_view->header_bytes = NULL;
+    *payload = entry->payload;
+
+    /* The copy is only good if no store rewrote the entry while it was being read. */
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&entry->seq_commit, memory_order_relaxed) == seq_commit;
+}
+
+static void tp_consumer_header_cache_store(
+    const tp_consumer_t *consumer,
+    uint32_t header_index,
+    uint64_t seq_commit,
+    const tp_slot_view_t *slot_view,
+    const tp_tensor_header_t *tensor,
+    const uint8_t *payload)
+{
+    tp_consumer_header_cache_entry_t *entry;
+
+    if (NULL == consumer->header_cache)
+    {
+        return;
+    }
+
+    entry = &consumer->header_cache[header_index];
+    if (atomic_exchange_explicit(&entry->filling, true, memory_order_acquire))
+    {
+        return;
+    }
+
+    atomic_store_explicit(&entry->seq_commit, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    entry->tensor = *tensor;
+    entry->values_len_bytes = slot_view->values_len_bytes;
+    entry->payload_slot = slot_view->payload_slot;
+    entry->pool_id = slot_view->pool_id;
+    entry->timestamp_ns = slot_view->timestamp_ns;
+    entry->meta_version = slot_view->meta_version;
+    entry->payload = payload;
+    atomic_store_explicit(&entry->seq_commit, seq_commit, memory_order_release);
+    atomic_store_explicit(&entry->filling, false, memory_order_release);
+}
+
+static void tp_consumer_unmap_mapping(tp_consumer_t *consumer, tp_consumer_mapping_t *mapping)
+{
+    size_t i;
+
+    for (i = 0; i < mapping->pool_count; i++)
+    {
+        tp_shm_unmap(&mapping->pools[i].region, &consumer->client->context->log);
+    }
+
+    tp_shm_unmap(&mapping->header_region, &consumer->client->context->log);
+
+    if (mapping->pools)
+    {
+        aeron_free(mapping->pools);
+    }
+    if (mapping->header_cache)
+    {
+        aeron_free(mapping->header_cache);
+    }
+    aeron_free(mapping);
+}
+
+/*
+ * Moves the current regions into the consumer's mapping so they outlive the consumer fields.
+ * The consumer is left with nothing mapped; the caller retires or restores the result.
+ */
+static tp_consumer_mapping_t *tp_consumer_detach_mapping(tp_consumer_t *consumer)
+{
+    tp_consumer_mapping_t *mapping = consumer->mapping;
+
+    mapping->epoch = consumer->mapped_epoch;
+    mapping->layout_version = consumer->layout_version;
+    mapping->header_nslots = consumer->header_nslots;
+    mapping->header_region = consumer->header_region;
+    mapping->pools = consumer->pools;
+    mapping->pool_count = consumer->pool_count;
+    mapping->header_cache = consumer->header_cache;
+
+    consumer->mapping = NULL;
+    memset(&consumer->header_region, 0, sizeof(consumer->header_region));
+    consumer->header_region.fd = -1;
+    consumer->pools = NULL;
+    consumer->pool_count = 0;
+    consumer->header_cache = NULL;
+    consumer->header_nslots = 0;
+    consumer->state = TP_CONSUMER_STATE_UNMAPPED;
+    consumer->shm_mapped = false;
+    consumer->mapped_epoch = 0;
+    return mapping;
+}
+
+static void tp_consumer_restore_mapping(tp_consumer_t *consumer, tp_consumer_mapping_t *mapping)
+{
+    consumer->mapping = mapping;
+    consumer->epoch = mapping->epoch;
+    consumer->layout_version = mapping->layout_version;
+    consumer->header_nslots = mapping->header_nslots;
+    consumer->header_region = mapping->header_region;
+    consumer->pools = mapping->pools;
+    consumer->pool_count = mapping->pool_count;
+    consumer->header_cache = mapping->header_cache;
+    consumer->state = TP_CONSUMER_STATE_MAPPED;
+    consumer->shm_mapped = true;
+    consumer->mapped_epoch = mapping->epoch;
+
+    mapping->pools = NULL;
+    mapping->pool_count = 0;
+    mapping->header_cache = NULL;
+    memset(&mapping->header_region, 0, sizeof(mapping->header_region));
+    mapping->header_region.fd = -1;
+}
+
+/* Unmaps a detached mapping now, or parks it until the last held view is released. */
+static void tp_consumer_retire_mapping(tp_consumer_t *consumer, tp_consumer_mapping_t *mapping)
+{
+    consumer->retired_epoch = mapping->epoch;
+    consumer->has_retired_epoch = true;
+
+    if (atomic_load_explicit(&mapping->holds, memory_order_acquire) == 0)
+    {
+        tp_consumer_unmap_mapping(consumer, mapping);
+        return;
+    }
+
+    mapping->next = consumer->retired_mappings;
+    consumer->retired_mappings = mapping;
+}
+
+static void tp_consumer_reap_mappings(tp_consumer_t *consumer, bool force)
+{
+    tp_consumer_mapping_t **link = &consumer->retired_mappings;
+
+    while (NULL != *link)
+    {
+        tp_consumer_mapping_t *mapping = *link;
+
+        if (!force && atomic_load_explicit(&mapping->holds, memory_order_acquire) != 0)
+        {
+            link = &mapping->next;
+            continue;
+        }
+
+        *link = mapping->next;
+        tp_consumer_unmap_mapping(consumer, mapping);
+    }
+}
+
+/* Closes the remap gap on the first frame read from the new epoch. */
+static void tp_consumer_note_remap_frame(tp_consumer_t *consumer)
+{
+    uint64_t now_ns;
+    uint64_t gap_ns;
+
+    if (consumer->remap_started_ns == 0)
+    {
+        return;
+    }
+
+    now_ns = (uint64_t)tp_clock_now_ns();
+    gap_ns = now_ns > consumer->remap_started_ns ? now_ns - consumer->remap_started_ns : 0;
+    consumer->remap_gap_last_ns = gap_ns;
+    if (gap_ns > consumer->remap_gap_max_ns)
+    {
+        consumer->remap_gap_max_ns = gap_ns;
+    }
+    consumer->remap_count++;
+    consumer->remap_started_ns = 0;
+}
+
 static void tp_consumer_unmap_regions(tp_consumer_t *consumer)
 {
     size_t i;
@@ -65,17 +280,25 @@ static void tp_consumer_unmap_regions(tp_consumer_t *consumer)
         return;
     }
 
-    for (i = 0; i < consumer->pool_count; i++)
+    if (consumer->mapping)
     {
-        tp_shm_unmap(&consumer->pools[i].region, &consumer->client->context->log);
+        tp_consumer_retire_mapping(consumer, tp_consumer_detach_mapping(consumer));
     }
+    else
+    {
+        for (i = 0; i < consumer->pool_count; i++)
+        {
+            tp_shm_unmap(&consumer->pools[i].region, &consumer->client->context->log);
+        }
 
-    tp_shm_unmap(&consumer->header_region, &consumer->client->context->log);
+        tp_shm_unmap(&consumer->header_region, &consumer->client->context->log);
 
-    if (consumer->pools)
-    {
-        aeron_free(consumer->pools);
-        consumer->pools = NULL;
+        if (consumer->pools)
+        {
+            aeron_free(consumer->pools);
+            consumer->pools = NULL;
+        }
+        tp_consumer_free_header_cache(consumer);
     }
 
     consumer->pool_count = 0;
@@ -85,8 +308,14 @@ static void tp_consumer_unmap_regions(tp_consumer_t *consumer)
     consumer->mapped_epoch = 0;
     consumer->attach_time_ns = 0;
     consumer->last_seq_seen = 0;
+    consumer->ring_primed = false;
+    consumer->has_latest_read = false;
     consumer->drops_gap = 0;
     consumer->drops_late = 0;
+    consumer->drops_conflated = 0;
+    consumer->has_pending_latest = false;
+    consumer->frames_rate_limited = 0;
+    consumer->has_rate_gate = false;
     consumer->last_qos_ns = 0;
 }
 
@@ -268,6 +497,7 @@ static int tp_consumer_apply_announce(tp_consumer_t *consumer, const tp_shm_pool
 {
     tp_consumer_config_t config;
     tp_consumer_pool_config_t *pool_cfg = NULL;
+    tp_consumer_mapping_t *previous = NULL;
     char *header_uri = NULL;
     char **pool_uris = NULL;
     size_t i;
@@ -345,12 +575,39 @@ static int tp_consumer_apply_announce(tp_consumer_t *consumer, const tp_shm_pool
     config.pools = pool_cfg;
     config.pool_count = announce->pool_count;
 
-    tp_consumer_unmap_regions(consumer);
+    /*
+     * The previous epoch stays mapped until the new one is fully validated, so a failed remap
+     * leaves the consumer reading the old epoch and views held across the switch stay valid.
+     */
+    if (consumer->mapping)
+    {
+        previous = tp_consumer_detach_mapping(consumer);
+    }
+    else
+    {
+        tp_consumer_unmap_regions(consumer);
+    }
+
     if (tp_consumer_attach_config(consumer, &config) < 0)
     {
+        if (previous)
+        {
+            tp_consumer_restore_mapping(consumer, previous);
+            previous = NULL;
+        }
         goto cleanup;
     }
 
+    if (previous)
+    {
+        if (previous->epoch != announce->epoch && consumer->remap_started_ns == 0)
+        {
+            consumer->remap_started_ns = (uint64_t)tp_clock_now_ns();
+        }
+        tp_consumer_retire_mapping(consumer, previous);
+        previous = NULL;
+    }
+
     if (consumer->state == TP_CONSUMER_STATE_FALLBACK)
     {
         result = 0;
@@ -445,9 +702,16 @@ static int tp_consumer_add_subscription(
     int32_t stream_id,
     tp_subscription_t **out_sub);
 
-static void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
+/*
+ * Decodes a FrameDescriptor and applies the mapping, epoch and gap accounting shared by the
+ * callback and batch paths. Returns true when the descriptor should be delivered.
+ */
+static bool tp_consumer_accept_descriptor(
+    tp_consumer_t *consumer,
+    const uint8_t *buffer,
+    size_t length,
+    tp_frame_descriptor_t *out)
 {
-    tp_consumer_t *consumer = (tp_consumer_t *)clientd;
     struct tensor_pool_messageHeader msg_header;
     struct tensor_pool_frameDescriptor descriptor;
     tp_frame_descriptor_t view;
@@ -456,16 +720,9 @@ static void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer,
     uint32_t stream_id;
     uint64_t epoch;
 
-    (void)header;
-
-    if (NULL == consumer || NULL == buffer)
-    {
-        return;
-    }
-
     if (length < tensor_pool_messageHeader_encoded_length())
     {
-        return;
+        return false;
     }
 
     tensor_pool_messageHeader_wrap(
@@ -480,7 +737,7 @@ static void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer,
     if (schema_id != tensor_pool_frameDescriptor_sbe_schema_id() ||
         template_id != tensor_pool_frameDescriptor_sbe_template_id())
     {
-        return;
+        return false;
     }
 
     tensor_pool_frameDescriptor_wrap_for_decode(
@@ -513,11 +770,34 @@ static void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer,
     if (!consumer->shm_mapped)
     {
         tp_log_emit(&consumer->client->context->log, TP_LOG_DEBUG, "%s", "descriptor drop: shm not mapped");
-        return;
+        return false;
     }
 
     if (consumer->mapped_epoch != epoch)
     {
+        /* The producer has moved on; keep reading nothing until its announce remaps us. */
+        if (epoch > consumer->mapped_epoch)
+        {
+            if (consumer->remap_started_ns == 0)
+            {
+                consumer->remap_started_ns = (uint64_t)tp_clock_now_ns();
+            }
+            tp_log_emit(
+                &consumer->client->context->log,
+                TP_LOG_DEBUG,
+                "descriptor drop: awaiting announce for epoch=%" PRIu64 " mapped=%" PRIu64,
+                epoch,
+                consumer->mapped_epoch);
+            return false;
+        }
+
+        /* Descriptors still in flight from the epoch we just left. */
+        if (consumer->has_retired_epoch && epoch == consumer->retired_epoch)
+        {
+            consumer->drops_late++;
+            return false;
+        }
+
         tp_log_emit(
             &consumer->client->context->log,
             TP_LOG_DEBUG,
@@ -525,16 +805,135 @@ static void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer,
             epoch,
             consumer->mapped_epoch);
         tp_consumer_unmap_regions(consumer);
+        return false;
+    }
+
+    tp_consumer_note_remap_frame(consumer);
+
+    if (NULL != consumer->arrival_latency)
+    {
+        consumer->descriptor_rx_ns = (uint64_t)tp_clock_now_ns();
+        consumer->descriptor_rx_seq = view.seq;
+        consumer->has_descriptor_rx = true;
+    }
+
+    /* Ring-following consumers account gaps from the ring itself. */
+    if (!consumer->context.follow_ring)
+    {
+        if (consumer->last_seq_seen != 0 && view.seq > consumer->last_seq_seen + 1)
+        {
+            consumer->drops_gap += (view.seq - consumer->last_seq_seen - 1);
+        }
+        if (view.seq > consumer->last_seq_seen)
+        {
+            consumer->last_seq_seen = view.seq;
+        }
+    }
+
+    *out = view;
+    return true;
+}
+
+/*
+ * Gate timestamp per spec §11: the descriptor timestamp when present, else the slot header
+ * timestamp if the slot still holds this seq, else the local monotonic clock.
+ */
+static uint64_t tp_consumer_rate_gate_timestamp(tp_consumer_t *consumer, const tp_frame_descriptor_t *desc)
+{
+    tp_slot_view_t slot_view;
+    const uint8_t *slot;
+
+    if (desc->timestamp_ns != TP_NULL_U64 && desc->timestamp_ns != 0)
+    {
+        return desc->timestamp_ns;
+    }
+
+    if (consumer->header_nslots > 0)
+    {
+        slot = tp_slot_at(consumer->header_region.addr, (uint32_t)(desc->seq & (consumer->header_nslots - 1)));
+        if (tp_slot_decode(&slot_view, slot, TP_HEADER_SLOT_BYTES, &consumer->client->context->log) == 0 &&
+            slot_view.seq_commit == tp_seq_committed(desc->seq) &&
+            slot_view.timestamp_ns != 0 &&
+            slot_view.timestamp_ns != TP_NULL_U64)
+        {
+            return slot_view.timestamp_ns;
+        }
+    }
+
+    return (uint64_t)tp_clock_now_ns();
+}
+
+/*
+ * Local RATE_LIMITED enforcement for consumers left on the shared descriptor stream; per-consumer
+ * streams are already paced by the producer. Returns true when the descriptor should be skipped.
+ */
+static bool tp_consumer_rate_limited(tp_consumer_t *consumer, const tp_frame_descriptor_t *desc)
+{
+    uint64_t interval_ns;
+    uint64_t timestamp_ns;
+
+    if (consumer->context.hello.mode != TP_MODE_RATE_LIMITED ||
+        consumer->context.hello.max_rate_hz == 0 ||
+        consumer->assigned_descriptor_stream_id != 0)
+    {
+        return false;
+    }
+
+    interval_ns = 1000000000ULL / consumer->context.hello.max_rate_hz;
+    timestamp_ns = tp_consumer_rate_gate_timestamp(consumer, desc);
+    if (consumer->has_rate_gate &&
+        timestamp_ns >= consumer->last_rate_gate_ns &&
+        timestamp_ns - consumer->last_rate_gate_ns < interval_ns)
+    {
+        consumer->frames_rate_limited++;
+        return true;
+    }
+
+    consumer->last_rate_gate_ns = timestamp_ns;
+    consumer->has_rate_gate = true;
+    return false;
+}
+
+void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
+{
+    tp_consumer_t *consumer = (tp_consumer_t *)clientd;
+    tp_frame_descriptor_t view;
+
+    (void)header;
+
+    if (NULL == consumer || NULL == buffer)
+    {
+        return;
+    }
+
+    if (!tp_consumer_accept_descriptor(consumer, buffer, length, &view) ||
+        tp_consumer_rate_limited(consumer, &view))
+    {
         return;
     }
 
-    if (consumer->last_seq_seen != 0 && view.seq > consumer->last_seq_seen + 1)
+    if (NULL != consumer->batch_descriptors)
     {
-        consumer->drops_gap += (view.seq - consumer->last_seq_seen - 1);
+        if (consumer->batch_count < consumer->batch_capacity)
+        {
+            consumer->batch_descriptors[consumer->batch_count++] = view;
+        }
+        return;
     }
-    if (view.seq > consumer->last_seq_seen)
+
+    if (consumer->context.latest_only)
     {
-        consumer->last_seq_seen = view.seq;
+        if (consumer->has_pending_latest)
+        {
+            consumer->drops_conflated++;
+            if (view.seq <= consumer->pending_latest.seq)
+            {
+                return;
+            }
+        }
+        consumer->pending_latest = view;
+        consumer->has_pending_latest = true;
+        return;
     }
 
     if (consumer->descriptor_handler)
@@ -543,7 +942,7 @@ static void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer,
     }
 }
 
-static void tp_consumer_control_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
+void tp_consumer_control_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
 {
     tp_consumer_t *consumer = (tp_consumer_t *)clientd;
     tp_shm_pool_announce_view_t announce;
@@ -623,7 +1022,6 @@ static void tp_consumer_control_handler(void *clientd, const uint8_t *buffer, si
                 tp_control_shm_pool_announce_close(&announce);
                 return;
             }
-            tp_consumer_unmap_regions(consumer);
         }
 
         if (consumer->last_announce_epoch != 0 && announce.epoch < consumer->last_announce_epoch)
@@ -943,6 +1341,50 @@ void tp_consumer_context_set_use_conductor_polling(tp_consumer_context_t *ctx, b
     ctx->use_conductor_polling = enabled;
 }
 
+void tp_consumer_context_set_payload_copy_engine(
+    tp_consumer_context_t *ctx,
+    tp_copy_engine_t engine,
+    size_t threshold_bytes)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->payload_copy_engine = engine;
+    ctx->payload_copy_threshold = threshold_bytes;
+}
+
+void tp_consumer_context_set_follow_ring(tp_consumer_context_t *ctx, bool enabled)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->follow_ring = enabled;
+}
+
+void tp_consumer_context_set_latest_only(tp_consumer_context_t *ctx, bool enabled)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->latest_only = enabled;
+}
+
+void tp_consumer_context_set_track_latency(tp_consumer_context_t *ctx, bool enabled)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->track_latency = enabled;
+}
+
 int tp_consumer_init(tp_consumer_t **consumer, tp_client_t *client, const tp_consumer_context_t *context)
 {
     tp_consumer_t *instance = NULL;
@@ -965,6 +1407,26 @@ int tp_consumer_init(tp_consumer_t **consumer, tp_client_t *client, const tp_con
     instance->context = *context;
     instance->use_shm = true;
     instance->payload_fallback_uri[0] = '\0';
+    if (instance->context.payload_copy_engine != TP_COPY_ENGINE_MEMCPY)
+    {
+        if (instance->context.payload_copy_threshold == 0)
+        {
+            instance->context.payload_copy_threshold = TP_COPY_NT_THRESHOLD_DEFAULT;
+        }
+        instance->payload_copy = tp_copy_engine_fn(instance->context.payload_copy_engine);
+    }
+
+    if (instance->context.track_latency)
+    {
+        if (aeron_alloc((void **)&instance->arrival_latency, sizeof(*instance->arrival_latency)) < 0 ||
+            aeron_alloc((void **)&instance->read_latency, sizeof(*instance->read_latency)) < 0)
+        {
+            TP_SET_ERR(ENOMEM, "%s", "tp_consumer_init: latency histogram allocation failed");
+            goto cleanup;
+        }
+        tp_latency_histogram_reset(instance->arrival_latency);
+        tp_latency_histogram_reset(instance->read_latency);
+    }
 
     if (client->context->descriptor_channel[0] != '\0' && client->context->descriptor_stream_id >= 0)
     {
@@ -1190,6 +1652,12 @@ static int tp_consumer_attach_config(tp_consumer_t *consumer, const tp_consumer_
         return -1;
     }
 
+    /* Attaching over a live mapping retires it rather than dropping views still in use. */
+    if (consumer->mapping)
+    {
+        tp_consumer_retire_mapping(consumer, tp_consumer_detach_mapping(consumer));
+    }
+
     consumer->stream_id = config->stream_id;
     consumer->epoch = config->epoch;
     consumer->layout_version = config->layout_version;
@@ -1218,10 +1686,10 @@ static int tp_consumer_attach_config(tp_consumer_t *consumer, const tp_consumer_
         }
     }
 
-    if (tp_shm_map(
+    if (tp_shm_map_shared(
         &consumer->header_region,
         config->header_uri,
-        0,
+        config->epoch,
         &consumer->client->context->allowed_paths,
         &consumer->client->context->log) < 0)
     {
@@ -1279,10 +1747,10 @@ static int tp_consumer_attach_config(tp_consumer_t *consumer, const tp_consumer_
             goto cleanup;
         }
 
-        if (tp_shm_map(
+        if (tp_shm_map_shared(
             &pool->region,
             pool_cfg->uri,
-            0,
+            config->epoch,
             &consumer->client->context->allowed_paths,
             &consumer->client->context->log) < 0)
         {
@@ -1313,6 +1781,23 @@ static int tp_consumer_attach_config(tp_consumer_t *consumer, const tp_consumer_
         }
     }
 
+    /* Decoded slot headers are only valid for this mapping, so the cache starts empty. */
+    tp_consumer_free_header_cache(consumer);
+    if (aeron_alloc(
+        (void **)&consumer->header_cache,
+        sizeof(tp_consumer_header_cache_entry_t) * config->header_nslots) < 0)
+    {
+        consumer->header_cache = NULL;
+        goto cleanup;
+    }
+
+    if (aeron_alloc((void **)&consumer->mapping, sizeof(tp_consumer_mapping_t)) < 0)
+    {
+        consumer->mapping = NULL;
+        goto cleanup;
+    }
+    atomic_init(&consumer->mapping->holds, 0);
+
     if (consumer->control_publication)
     {
         tp_consumer_hello_t hello;
@@ -1326,8 +1811,14 @@ static int tp_consumer_attach_config(tp_consumer_t *consumer, const tp_consumer_
     consumer->attach_time_ns = (uint64_t)tp_clock_now_ns();
     consumer->last_announce_epoch = config->epoch;
     consumer->last_seq_seen = 0;
+    consumer->ring_primed = false;
+    consumer->has_latest_read = false;
     consumer->drops_gap = 0;
     consumer->drops_late = 0;
+    consumer->drops_conflated = 0;
+    consumer->has_pending_latest = false;
+    consumer->frames_rate_limited = 0;
+    consumer->has_rate_gate = false;
     consumer->last_qos_ns = 0;
     tp_consumer_clear_reattach(consumer);
     return 0;
@@ -1348,6 +1839,7 @@ cleanup:
         aeron_free(consumer->pools);
         consumer->pools = NULL;
     }
+    tp_consumer_free_header_cache(consumer);
 
     consumer->pool_count = 0;
     consumer->header_nslots = 0;
@@ -1357,6 +1849,10 @@ cleanup:
     consumer->last_seq_seen = 0;
     consumer->drops_gap = 0;
     consumer->drops_late = 0;
+    consumer->drops_conflated = 0;
+    consumer->has_pending_latest = false;
+    consumer->frames_rate_limited = 0;
+    consumer->has_rate_gate = false;
     consumer->last_qos_ns = 0;
     if (result != 0 && consumer->payload_fallback_uri[0] != '\0')
     {
@@ -1558,11 +2054,44 @@ int tp_consumer_attach(tp_consumer_t *consumer, const tp_consumer_config_t *conf
     return tp_consumer_attach_config(consumer, config);
 }
 
-int tp_consumer_read_frame(tp_consumer_t *consumer, uint64_t seq, tp_frame_view_t *out)
+/*
+ * Slot timestamps from another clock domain, or ahead of the local monotonic clock, are
+ * skipped rather than recorded as bogus latencies.
+ */
+static void tp_consumer_record_latency(tp_consumer_t *consumer, uint64_t seq, uint64_t timestamp_ns)
+{
+    uint64_t now_ns;
+
+    if (timestamp_ns == 0 || timestamp_ns == TP_NULL_U64)
+    {
+        return;
+    }
+
+    now_ns = (uint64_t)tp_clock_now_ns();
+    if (timestamp_ns > now_ns)
+    {
+        return;
+    }
+
+    tp_latency_histogram_record(consumer->read_latency, now_ns - timestamp_ns);
+
+    /* Count arrival once per descriptor, even if the frame is read again. */
+    if (consumer->has_descriptor_rx && consumer->descriptor_rx_seq == seq)
+    {
+        if (consumer->descriptor_rx_ns >= timestamp_ns)
+        {
+            tp_latency_histogram_record(consumer->arrival_latency, consumer->descriptor_rx_ns - timestamp_ns);
+        }
+        consumer->has_descriptor_rx = false;
+    }
+}
+
+int tp_consumer_read_frame(tp_consumer_t *consumer, uint64_t seq, tp_frame_view_t *out)
 {
     uint8_t *slot;
     tp_slot_view_t slot_view;
     tp_consumer_pool_t *pool;
+    const uint8_t *payload = NULL;
     uint32_t header_index;
     uint64_t seq_first;
     uint64_t seq_second;
@@ -1605,68 +2134,158 @@ int tp_consumer_read_frame(tp_consumer_t *consumer, uint64_t seq, tp_frame_view_
         return 1;
     }
 
-    if (tp_slot_decode(&slot_view, slot, TP_HEADER_SLOT_BYTES, &consumer->client->context->log) < 0)
+    if (tp_consumer_header_cache_load(consumer, header_index, seq_first, &slot_view, &out->tensor, &payload))
     {
-        return -1;
+        if (tp_seq_value(seq_first) != seq)
+        {
+            consumer->drops_late++;
+            return 1;
+        }
     }
-
-    if (slot_view.payload_offset != 0)
+    else
     {
-        return 1;
+        if (tp_slot_decode(&slot_view, slot, TP_HEADER_SLOT_BYTES, &consumer->client->context->log) < 0)
+        {
+            return -1;
+        }
+
+        if (slot_view.payload_offset != 0)
+        {
+            return 1;
+        }
+
+        if (slot_view.payload_slot != header_index)
+        {
+            return 1;
+        }
+
+        pool = tp_consumer_find_pool(consumer, slot_view.pool_id);
+        if (NULL == pool)
+        {
+            return 1;
+        }
+
+        if (slot_view.values_len_bytes > pool->stride_bytes)
+        {
+            return 1;
+        }
+
+        if (slot_view.header_bytes_length != (tensor_pool_messageHeader_encoded_length() + tensor_pool_tensorHeader_sbe_block_length()))
+        {
+            return 1;
+        }
+
+        if (tp_tensor_header_decode(&out->tensor, slot_view.header_bytes, slot_view.header_bytes_length, &consumer->client->context->log) < 0)
+        {
+            return 1;
+        }
+
+        if (tp_tensor_header_validate(&out->tensor, &consumer->client->context->log) < 0)
+        {
+            return 1;
+        }
+
+        seq_second = tp_atomic_load_u64((uint64_t *)slot);
+        if (seq_second != seq_first || !tp_seq_is_committed(seq_second))
+        {
+            consumer->drops_late++;
+            return 1;
+        }
+
+        if (tp_seq_value(seq_second) != seq)
+        {
+            consumer->drops_late++;
+            return 1;
+        }
+
+        payload = (const uint8_t *)pool->region.addr + TP_SUPERBLOCK_SIZE_BYTES + (slot_view.payload_slot * pool->stride_bytes);
+        tp_consumer_header_cache_store(consumer, header_index, seq_second, &slot_view, &out->tensor, payload);
     }
 
-    if (slot_view.payload_slot != header_index)
+    out->payload_len = slot_view.values_len_bytes;
+    out->payload = payload;
+    out->pool_id = slot_view.pool_id;
+    out->payload_slot = slot_view.payload_slot;
+    out->timestamp_ns = slot_view.timestamp_ns;
+    out->meta_version = slot_view.meta_version;
+    out->seq = seq;
+
+    if (NULL != consumer->read_latency)
     {
-        return 1;
+        tp_consumer_record_latency(consumer, seq, slot_view.timestamp_ns);
     }
 
-    pool = tp_consumer_find_pool(consumer, slot_view.pool_id);
-    if (NULL == pool)
+    return 0;
+}
+
+int tp_consumer_validate_frame(tp_consumer_t *consumer, uint64_t seq)
+{
+    uint8_t *slot;
+    uint64_t seq_commit;
+
+    if (NULL == consumer)
     {
-        return 1;
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_validate_frame: null input");
+        return -1;
     }
 
-    if (slot_view.values_len_bytes > pool->stride_bytes)
+    if (!consumer->shm_mapped || consumer->header_nslots == 0)
     {
         return 1;
     }
 
-    if (slot_view.header_bytes_length != (tensor_pool_messageHeader_encoded_length() + tensor_pool_tensorHeader_sbe_block_length()))
+    slot = tp_slot_at(consumer->header_region.addr, (uint32_t)(seq & (consumer->header_nslots - 1)));
+
+    /* Payload loads made by the caller must complete before seq_commit is re-read. */
+    atomic_thread_fence(memory_order_acquire);
+    seq_commit = tp_atomic_load_u64((uint64_t *)slot);
+    if (seq_commit != tp_seq_committed(seq))
     {
+        consumer->drops_late++;
         return 1;
     }
 
-    if (tp_tensor_header_decode(&out->tensor, slot_view.header_bytes, slot_view.header_bytes_length, &consumer->client->context->log) < 0)
+    return 0;
+}
+
+int tp_consumer_read_frame_copy(
+    tp_consumer_t *consumer,
+    uint64_t seq,
+    tp_frame_view_t *out,
+    void *dst,
+    size_t dst_len)
+{
+    int result;
+
+    if (NULL == consumer || NULL == out || NULL == dst)
     {
-        return 1;
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_read_frame_copy: null input");
+        return -1;
     }
 
-    if (tp_tensor_header_validate(&out->tensor, &consumer->client->context->log) < 0)
+    result = tp_consumer_read_frame(consumer, seq, out);
+    if (result != 0)
     {
-        return 1;
+        return result;
     }
 
-    out->payload_len = slot_view.values_len_bytes;
-    out->payload = (const uint8_t *)pool->region.addr + TP_SUPERBLOCK_SIZE_BYTES + (slot_view.payload_slot * pool->stride_bytes);
-    out->pool_id = slot_view.pool_id;
-    out->payload_slot = slot_view.payload_slot;
-    out->timestamp_ns = slot_view.timestamp_ns;
-    out->meta_version = slot_view.meta_version;
-
-    seq_second = tp_atomic_load_u64((uint64_t *)slot);
-    if (seq_second != seq_first || !tp_seq_is_committed(seq_second))
+    if (out->payload_len > dst_len)
     {
-        consumer->drops_late++;
-        return 1;
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_read_frame_copy: destination too small");
+        return -1;
     }
 
-    if (tp_seq_value(seq_second) != seq)
+    if (NULL != consumer->payload_copy && out->payload_len >= consumer->context.payload_copy_threshold)
     {
-        consumer->drops_late++;
-        return 1;
+        consumer->payload_copy(dst, out->payload, out->payload_len);
+    }
+    else
+    {
+        memcpy(dst, out->payload, out->payload_len);
     }
+    out->payload = (const uint8_t *)dst;
 
-    return 0;
+    return tp_consumer_validate_frame(consumer, seq);
 }
 
 int tp_consumer_validate_progress(const tp_consumer_t *consumer, const tp_frame_progress_t *progress)
@@ -1675,6 +2294,7 @@ int tp_consumer_validate_progress(const tp_consumer_t *consumer, const tp_frame_
     tp_slot_view_t slot_view;
     tp_consumer_pool_t *pool;
     tp_tensor_header_t tensor;
+    const uint8_t *payload = NULL;
     uint32_t header_index;
     uint64_t seq_commit_begin;
     uint64_t seq_commit_end;
@@ -1726,6 +2346,17 @@ int tp_consumer_validate_progress(const tp_consumer_t *consumer, const tp_frame_
         return -1;
     }
 
+    /* Progress for a partially written frame arrives repeatedly for the same seq_commit. */
+    if (tp_consumer_header_cache_load(consumer, header_index, seq_commit_begin, &slot_view, &tensor, &payload))
+    {
+        if (progress->payload_bytes_filled > slot_view.values_len_bytes)
+        {
+            TP_SET_ERR(EINVAL, "%s", "tp_consumer_validate_progress: payload bytes exceed values");
+            return -1;
+        }
+        return 0;
+    }
+
     if (tp_slot_decode(&slot_view, slot, TP_HEADER_SLOT_BYTES, &consumer->client->context->log) < 0)
     {
         return -1;
@@ -1794,6 +2425,15 @@ int tp_consumer_validate_progress(const tp_consumer_t *consumer, const tp_frame_
         return -1;
     }
 
+    /* Cache only what tp_consumer_read_frame would also accept, and only if the decode was not torn. */
+    if (slot_view.payload_offset == 0 &&
+        slot_view.payload_slot == header_index &&
+        tp_atomic_load_u64((uint64_t *)slot) == seq_commit_begin)
+    {
+        payload = (const uint8_t *)pool->region.addr + TP_SUPERBLOCK_SIZE_BYTES + (slot_view.payload_slot * pool->stride_bytes);
+        tp_consumer_header_cache_store(consumer, header_index, seq_commit_begin, &slot_view, &tensor, payload);
+    }
+
     return 0;
 }
 
@@ -1821,6 +2461,21 @@ int tp_consumer_get_drop_counts(const tp_consumer_t *consumer, uint64_t *drops_g
     return 0;
 }
 
+void tp_consumer_finish_descriptor_poll(tp_consumer_t *consumer)
+{
+    if (consumer->has_pending_latest)
+    {
+        consumer->has_pending_latest = false;
+        if (consumer->descriptor_handler)
+        {
+            consumer->descriptor_handler(consumer->descriptor_clientd, &consumer->pending_latest);
+        }
+    }
+
+    tp_consumer_check_activity_liveness(consumer, (uint64_t)tp_clock_now_ns());
+    tp_consumer_check_pid_liveness(consumer);
+}
+
 static int tp_consumer_poll_descriptors_internal(tp_consumer_t *consumer, int fragment_limit, bool drive_client)
 {
     if (NULL == consumer || NULL == consumer->descriptor_subscription)
@@ -1828,6 +2483,8 @@ static int tp_consumer_poll_descriptors_internal(tp_consumer_t *consumer, int fr
         return 0;
     }
 
+    tp_consumer_reap_mappings(consumer, false);
+
     if (NULL == consumer->descriptor_assembler)
     {
         if (tp_fragment_assembler_create(
@@ -1849,8 +2506,7 @@ static int tp_consumer_poll_descriptors_internal(tp_consumer_t *consumer, int fr
         return -1;
     }
 
-    tp_consumer_check_activity_liveness(consumer, (uint64_t)tp_clock_now_ns());
-    tp_consumer_check_pid_liveness(consumer);
+    tp_consumer_finish_descriptor_poll(consumer);
     if (drive_client)
     {
         tp_client_do_work(consumer->client);
@@ -1863,9 +2519,277 @@ int tp_consumer_poll_descriptors(tp_consumer_t *consumer, int fragment_limit)
     return tp_consumer_poll_descriptors_internal(consumer, fragment_limit, true);
 }
 
+static inline void tp_consumer_prefetch(const void *addr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 0, 3);
+#else
+    (void)addr;
+#endif
+}
+
+/*
+ * Resolves a polled batch in two passes: the first touches every header slot (and, with a
+ * single pool, the first payload lines) so the misses overlap, the second decodes them.
+ */
+static size_t tp_consumer_resolve_batch(
+    tp_consumer_t *consumer,
+    const tp_frame_descriptor_t *descriptors,
+    size_t count,
+    tp_frame_view_t *out)
+{
+    size_t produced = 0;
+    size_t i;
+
+    if (!consumer->shm_mapped || consumer->header_nslots == 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        uint32_t header_index = (uint32_t)(descriptors[i].seq & (consumer->header_nslots - 1));
+        const uint8_t *slot = tp_slot_at(consumer->header_region.addr, header_index);
+        size_t line;
+
+        for (line = 0; line < TP_HEADER_SLOT_BYTES; line += TP_CONSUMER_CACHE_LINE_BYTES)
+        {
+            tp_consumer_prefetch(slot + line);
+        }
+
+        if (consumer->pool_count == 1)
+        {
+            const tp_consumer_pool_t *pool = &consumer->pools[0];
+            const uint8_t *payload = (const uint8_t *)pool->region.addr + TP_SUPERBLOCK_SIZE_BYTES +
+                ((size_t)header_index * pool->stride_bytes);
+
+            tp_consumer_prefetch(payload);
+            tp_consumer_prefetch(payload + TP_CONSUMER_CACHE_LINE_BYTES);
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (NULL != consumer->arrival_latency)
+        {
+            /* The whole batch arrived within this poll; charge each frame the last receive time. */
+            consumer->descriptor_rx_seq = descriptors[i].seq;
+            consumer->has_descriptor_rx = true;
+        }
+        if (tp_consumer_read_frame(consumer, descriptors[i].seq, &out[produced]) == 0)
+        {
+            produced++;
+        }
+    }
+
+    return produced;
+}
+
+static bool tp_consumer_newest_committed(const tp_consumer_t *consumer, uint64_t *out_seq)
+{
+    uint64_t newest = 0;
+    bool found = false;
+    uint32_t i;
+
+    for (i = 0; i < consumer->header_nslots; i++)
+    {
+        uint64_t seq_commit = tp_atomic_load_u64((uint64_t *)tp_slot_at(consumer->header_region.addr, i));
+        if (tp_seq_is_committed(seq_commit) && (!found || tp_seq_value(seq_commit) > newest))
+        {
+            newest = tp_seq_value(seq_commit);
+            found = true;
+        }
+    }
+
+    *out_seq = newest;
+    return found;
+}
+
+/*
+ * Starts ring following just past the newest committed slot, so a consumer that maps an
+ * active ring only sees frames written after it joined.
+ */
+static void tp_consumer_prime_ring(tp_consumer_t *consumer)
+{
+    uint64_t newest;
+
+    consumer->next_seq = tp_consumer_newest_committed(consumer, &newest) ? newest + 1 : 0;
+    consumer->ring_primed = true;
+}
+
+int tp_consumer_read_latest(tp_consumer_t *consumer, tp_frame_view_t *out)
+{
+    int attempt;
+
+    if (NULL == consumer || NULL == out)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_read_latest: null input");
+        return -1;
+    }
+
+    if (!consumer->use_shm || !consumer->shm_mapped || consumer->header_nslots == 0)
+    {
+        return 1;
+    }
+
+    /* A read that loses to the producer means a newer frame exists, so rescan a few times. */
+    for (attempt = 0; attempt < TP_CONSUMER_LATEST_ATTEMPTS; attempt++)
+    {
+        uint64_t newest;
+        int result;
+
+        if (!tp_consumer_newest_committed(consumer, &newest))
+        {
+            return 1;
+        }
+
+        if (consumer->has_latest_read && newest <= consumer->latest_read_seq)
+        {
+            return 1;
+        }
+
+        result = tp_consumer_read_frame(consumer, newest, out);
+        if (result < 0)
+        {
+            return -1;
+        }
+        if (result == 0)
+        {
+            if (consumer->has_latest_read && newest > consumer->latest_read_seq + 1)
+            {
+                consumer->drops_conflated += newest - consumer->latest_read_seq - 1;
+            }
+            consumer->latest_read_seq = newest;
+            consumer->has_latest_read = true;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int tp_consumer_poll_ring(tp_consumer_t *consumer, tp_frame_view_t *out, size_t max_frames)
+{
+    size_t produced = 0;
+    uint64_t nslots;
+
+    if (NULL == consumer || NULL == out)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_poll_ring: null input");
+        return -1;
+    }
+
+    tp_consumer_reap_mappings(consumer, false);
+
+    if (!consumer->use_shm || !consumer->shm_mapped || consumer->header_nslots == 0)
+    {
+        return 0;
+    }
+
+    if (!consumer->ring_primed)
+    {
+        tp_consumer_prime_ring(consumer);
+    }
+
+    nslots = consumer->header_nslots;
+    while (produced < max_frames)
+    {
+        uint64_t next = consumer->next_seq;
+        const uint8_t *slot = tp_slot_at(consumer->header_region.addr, (uint32_t)(next & (nslots - 1)));
+        uint64_t seq_commit = tp_atomic_load_u64((uint64_t *)slot);
+        uint64_t slot_seq = tp_seq_value(seq_commit);
+
+        if (slot_seq < next || (slot_seq == next && !tp_seq_is_committed(seq_commit)))
+        {
+            break;
+        }
+
+        if (slot_seq != next)
+        {
+            /* Lapped: everything older than one ring behind the slot's seq is gone. */
+            uint64_t oldest = slot_seq - next >= nslots ? slot_seq - nslots + 1 : next + 1;
+            consumer->drops_gap += oldest - next;
+            consumer->next_seq = oldest;
+            continue;
+        }
+
+        consumer->next_seq = next + 1;
+        consumer->last_seq_seen = next;
+        if (tp_consumer_read_frame(consumer, next, &out[produced]) == 0)
+        {
+            produced++;
+        }
+    }
+
+    if (produced > 0)
+    {
+        tp_consumer_note_remap_frame(consumer);
+    }
+
+    return (int)produced;
+}
+
+int tp_consumer_poll_frames(tp_consumer_t *consumer, tp_frame_view_t *out, size_t max_frames)
+{
+    tp_frame_descriptor_t descriptors[TP_CONSUMER_BATCH_MAX];
+    size_t produced = 0;
+
+    if (NULL == consumer || NULL == out)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_poll_frames: null input");
+        return -1;
+    }
+
+    while (produced < max_frames)
+    {
+        size_t limit = consumer->context.latest_only ? TP_CONSUMER_BATCH_MAX : max_frames - produced;
+        int fragments;
+
+        if (limit > TP_CONSUMER_BATCH_MAX)
+        {
+            limit = TP_CONSUMER_BATCH_MAX;
+        }
+
+        consumer->batch_descriptors = descriptors;
+        consumer->batch_capacity = limit;
+        consumer->batch_count = 0;
+        fragments = tp_consumer_poll_descriptors_internal(consumer, (int)limit, false);
+        consumer->batch_descriptors = NULL;
+        consumer->batch_capacity = 0;
+        if (fragments < 0)
+        {
+            return -1;
+        }
+
+        if (consumer->context.latest_only && consumer->batch_count > 1)
+        {
+            size_t newest = 0;
+            size_t j;
+
+            for (j = 1; j < consumer->batch_count; j++)
+            {
+                if (descriptors[j].seq > descriptors[newest].seq)
+                {
+                    newest = j;
+                }
+            }
+            consumer->drops_conflated += consumer->batch_count - 1;
+            descriptors[0] = descriptors[newest];
+            consumer->batch_count = 1;
+        }
+
+        produced += tp_consumer_resolve_batch(consumer, descriptors, consumer->batch_count, out + produced);
+        if (consumer->context.latest_only || (size_t)fragments < limit)
+        {
+            break;
+        }
+    }
+
+    return (int)produced;
+}
+
 static int tp_consumer_poll_control_internal(tp_consumer_t *consumer, int fragment_limit, bool drive_client)
 {
-    uint64_t now_ns;
     int fragments = 0;
     int polled;
 
@@ -1915,7 +2839,19 @@ static int tp_consumer_poll_control_internal(tp_consumer_t *consumer, int fragme
         fragments += polled;
     }
 
-    now_ns = (uint64_t)tp_clock_now_ns();
+    tp_consumer_finish_control_poll(consumer, (uint64_t)tp_clock_now_ns());
+
+    if (drive_client)
+    {
+        tp_client_do_work(consumer->client);
+    }
+    return fragments;
+}
+
+void tp_consumer_finish_control_poll(tp_consumer_t *consumer, uint64_t now_ns)
+{
+    tp_consumer_reap_mappings(consumer, false);
+
     if (consumer->qos_publication && consumer->client->context->announce_period_ns > 0)
     {
         uint64_t period = consumer->client->context->announce_period_ns;
@@ -1928,18 +2864,16 @@ static int tp_consumer_poll_control_internal(tp_consumer_t *consumer, int fragme
                 consumer->drops_gap,
                 consumer->drops_late,
                 consumer->context.hello.mode);
+            if (NULL != consumer->read_latency)
+            {
+                tp_qos_publish_consumer_latency(consumer, consumer->context.consumer_id);
+            }
             consumer->last_qos_ns = now_ns;
         }
     }
 
     tp_consumer_check_activity_liveness(consumer, now_ns);
     tp_consumer_check_pid_liveness(consumer);
-
-    if (drive_client)
-    {
-        tp_client_do_work(consumer->client);
-    }
-    return fragments;
 }
 
 int tp_consumer_poll_control(tp_consumer_t *consumer, int fragment_limit)
@@ -1967,6 +2901,155 @@ tp_publication_t *tp_consumer_qos_publication(tp_consumer_t *consumer)
     return NULL == consumer ? NULL : consumer->qos_publication;
 }
 
+uint64_t tp_consumer_rate_limited_count(const tp_consumer_t *consumer)
+{
+    return NULL == consumer ? 0 : consumer->frames_rate_limited;
+}
+
+uint64_t tp_consumer_conflated_count(const tp_consumer_t *consumer)
+{
+    return NULL == consumer ? 0 : consumer->drops_conflated;
+}
+
+tp_consumer_mapping_t *tp_consumer_hold_mapping(tp_consumer_t *consumer)
+{
+    if (NULL == consumer || NULL == consumer->mapping)
+    {
+        return NULL;
+    }
+
+    atomic_fetch_add_explicit(&consumer->mapping->holds, 1, memory_order_relaxed);
+    return consumer->mapping;
+}
+
+void tp_consumer_release_mapping(tp_consumer_mapping_t *mapping)
+{
+    if (NULL == mapping)
+    {
+        return;
+    }
+
+    /* Pairs with the acquire load in retire/reap so the regions are unmapped after last use. */
+    atomic_fetch_sub_explicit(&mapping->holds, 1, memory_order_release);
+}
+
+int tp_consumer_get_remap_stats(
+    const tp_consumer_t *consumer,
+    uint64_t *remap_count,
+    uint64_t *last_gap_ns,
+    uint64_t *max_gap_ns)
+{
+    if (NULL == consumer)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_get_remap_stats: null input");
+        return -1;
+    }
+
+    if (remap_count)
+    {
+        *remap_count = consumer->remap_count;
+    }
+    if (last_gap_ns)
+    {
+        *last_gap_ns = consumer->remap_gap_last_ns;
+    }
+    if (max_gap_ns)
+    {
+        *max_gap_ns = consumer->remap_gap_max_ns;
+    }
+    return 0;
+}
+
+int tp_consumer_get_latency(
+    const tp_consumer_t *consumer,
+    tp_latency_histogram_t *arrival,
+    tp_latency_histogram_t *read)
+{
+    if (NULL == consumer)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_get_latency: null input");
+        return -1;
+    }
+
+    if (NULL == consumer->read_latency)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_get_latency: latency tracking disabled");
+        return -1;
+    }
+
+    if (arrival)
+    {
+        *arrival = *consumer->arrival_latency;
+    }
+    if (read)
+    {
+        *read = *consumer->read_latency;
+    }
+    return 0;
+}
+
+int tp_consumer_reset_latency(tp_consumer_t *consumer)
+{
+    if (NULL == consumer)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_reset_latency: null input");
+        return -1;
+    }
+
+    if (NULL == consumer->read_latency)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_reset_latency: latency tracking disabled");
+        return -1;
+    }
+
+    tp_latency_histogram_reset(consumer->arrival_latency);
+    tp_latency_histogram_reset(consumer->read_latency);
+    consumer->has_descriptor_rx = false;
+    return 0;
+}
+
+int tp_consumer_get_numa_node(const tp_consumer_t *consumer, uint16_t pool_id, int *node)
+{
+    const tp_shm_region_t *region = NULL;
+    size_t i;
+
+    if (NULL == consumer || NULL == node)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_get_numa_node: null input");
+        return -1;
+    }
+
+    if (!consumer->shm_mapped)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_get_numa_node: regions not mapped");
+        return -1;
+    }
+
+    if (pool_id == 0)
+    {
+        region = &consumer->header_region;
+    }
+    else
+    {
+        for (i = 0; i < consumer->pool_count; i++)
+        {
+            if (consumer->pools[i].pool_id == pool_id)
+            {
+                region = &consumer->pools[i].region;
+                break;
+            }
+        }
+    }
+
+    if (NULL == region || NULL == region->addr || region->length <= TP_SUPERBLOCK_SIZE_BYTES)
+    {
+        TP_SET_ERR(EINVAL, "tp_consumer_get_numa_node: unknown pool_id %u", (unsigned)pool_id);
+        return -1;
+    }
+
+    return tp_numa_node_of((const uint8_t *)region->addr + TP_SUPERBLOCK_SIZE_BYTES, node);
+}
+
 uint32_t tp_consumer_assigned_descriptor_stream_id(const tp_consumer_t *consumer)
 {
     return NULL == consumer ? 0 : consumer->assigned_descriptor_stream_id;
@@ -2031,6 +3114,7 @@ int tp_consumer_close(tp_consumer_t *consumer)
     }
 
     tp_consumer_unmap_regions(consumer);
+    tp_consumer_reap_mappings(consumer, true);
 
     if (consumer->driver_attached)
     {
@@ -2052,6 +3136,8 @@ int tp_consumer_close(tp_consumer_t *consumer)
         consumer->driver_initialized = false;
     }
 
+    aeron_free(consumer->arrival_latency);
+    aeron_free(consumer->read_latency);
     aeron_free(consumer);
     return 0;
 }
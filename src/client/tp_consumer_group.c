@@ -0,0 +1,608 @@
+#include "tensor_pool/client/tp_consumer_group.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tensor_pool/internal/tp_client_internal.h"
+#include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/internal/tp_progress_poller.h"
+#include "tensor_pool/tp_clock.h"
+#include "tensor_pool/tp_error.h"
+#include "tp_aeron_wrap.h"
+
+#include "wire/tensor_pool/frameDescriptor.h"
+#include "wire/tensor_pool/messageHeader.h"
+
+enum
+{
+    TP_CONSUMER_GROUP_STREAM_BUDGET_DEFAULT = 16,
+    TP_CONSUMER_GROUP_CONTROL_LIMIT_DEFAULT = 10,
+    TP_CONSUMER_GROUP_ROUTE_MIN = 16
+};
+
+#define TP_CONSUMER_GROUP_NO_SOURCE UINT32_MAX
+
+typedef struct tp_consumer_group_source_stct
+{
+    tp_consumer_group_t *group;
+    tp_subscription_t *subscription;
+    tp_fragment_assembler_t *assembler;
+    uint32_t member_count;
+}
+tp_consumer_group_source_t;
+
+typedef struct tp_consumer_group_member_stct
+{
+    tp_consumer_t *consumer;
+    uint32_t stream_id;
+    uint32_t source_index;
+}
+tp_consumer_group_member_t;
+
+struct tp_consumer_group_stct
+{
+    tp_client_t *client;
+    tp_consumer_group_context_t context;
+    tp_consumer_group_member_t *members;
+    size_t member_count;
+    size_t member_capacity;
+    tp_consumer_group_source_t **sources;
+    size_t source_count;
+    /* Open-addressed stream_id -> member index + 1; 0 marks an empty slot. */
+    uint32_t *routes;
+    size_t route_mask;
+    tp_fragment_assembler_t *control_assembler;
+    size_t cursor;
+    uint64_t unrouted;
+};
+
+static size_t tp_consumer_group_route_slot(uint32_t stream_id, size_t mask)
+{
+    return (size_t)(stream_id * 2654435761u) & mask;
+}
+
+static tp_consumer_group_member_t *tp_consumer_group_find(const tp_consumer_group_t *group, uint32_t stream_id)
+{
+    size_t slot;
+
+    if (NULL == group->routes)
+    {
+        return NULL;
+    }
+
+    slot = tp_consumer_group_route_slot(stream_id, group->route_mask);
+    while (group->routes[slot] != 0)
+    {
+        tp_consumer_group_member_t *member = &group->members[group->routes[slot] - 1];
+
+        if (member->stream_id == stream_id)
+        {
+            return member;
+        }
+        slot = (slot + 1) & group->route_mask;
+    }
+
+    return NULL;
+}
+
+static int tp_consumer_group_rebuild_routes(tp_consumer_group_t *group, size_t member_count)
+{
+    size_t capacity = TP_CONSUMER_GROUP_ROUTE_MIN;
+    uint32_t *routes;
+    size_t i;
+
+    /* Keep the table at most half full so probes stay short. */
+    while (capacity < member_count * 2)
+    {
+        capacity <<= 1;
+    }
+
+    routes = (uint32_t *)calloc(capacity, sizeof(*routes));
+    if (NULL == routes)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_consumer_group_add: route table allocation failed");
+        return -1;
+    }
+
+    for (i = 0; i < member_count; i++)
+    {
+        size_t slot = tp_consumer_group_route_slot(group->members[i].stream_id, capacity - 1);
+
+        while (routes[slot] != 0)
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        routes[slot] = (uint32_t)(i + 1);
+    }
+
+    free(group->routes);
+    group->routes = routes;
+    group->route_mask = capacity - 1;
+    return 0;
+}
+
+static void tp_consumer_group_descriptor_handler(
+    void *clientd,
+    const uint8_t *buffer,
+    size_t length,
+    aeron_header_t *header)
+{
+    tp_consumer_group_source_t *source = (tp_consumer_group_source_t *)clientd;
+    struct tensor_pool_messageHeader msg_header;
+    struct tensor_pool_frameDescriptor descriptor;
+    tp_consumer_group_member_t *member;
+
+    if (NULL == source || NULL == buffer || length < tensor_pool_messageHeader_encoded_length())
+    {
+        return;
+    }
+
+    tensor_pool_messageHeader_wrap(
+        &msg_header,
+        (char *)buffer,
+        0,
+        tensor_pool_messageHeader_sbe_schema_version(),
+        length);
+    if (tensor_pool_messageHeader_schemaId(&msg_header) != tensor_pool_frameDescriptor_sbe_schema_id() ||
+        tensor_pool_messageHeader_templateId(&msg_header) != tensor_pool_frameDescriptor_sbe_template_id())
+    {
+        return;
+    }
+
+    tensor_pool_frameDescriptor_wrap_for_decode(
+        &descriptor,
+        (char *)buffer,
+        tensor_pool_messageHeader_encoded_length(),
+        tensor_pool_frameDescriptor_sbe_block_length(),
+        tensor_pool_frameDescriptor_sbe_schema_version(),
+        length);
+
+    member = tp_consumer_group_find(source->group, tensor_pool_frameDescriptor_streamId(&descriptor));
+    if (NULL == member)
+    {
+        source->group->unrouted++;
+        return;
+    }
+
+    /* A member with its own descriptor stream reads it there; the shared copy is a duplicate. */
+    if (member->consumer->assigned_descriptor_stream_id != 0)
+    {
+        return;
+    }
+
+    tp_consumer_descriptor_handler(member->consumer, buffer, length, header);
+}
+
+static void tp_consumer_group_control_handler(
+    void *clientd,
+    const uint8_t *buffer,
+    size_t length,
+    aeron_header_t *header)
+{
+    tp_consumer_group_t *group = (tp_consumer_group_t *)clientd;
+    size_t i;
+
+    if (NULL == group || NULL == buffer)
+    {
+        return;
+    }
+
+    /* Control traffic is low rate and each handler filters on its own stream and consumer id. */
+    for (i = 0; i < group->member_count; i++)
+    {
+        tp_consumer_t *consumer = group->members[i].consumer;
+
+        tp_consumer_control_handler(consumer, buffer, length, header);
+        if (consumer->progress_poller_initialized && NULL == consumer->control_subscription)
+        {
+            tp_progress_poller_handle_fragment(&consumer->progress_poller, buffer, length);
+        }
+    }
+}
+
+int tp_consumer_group_context_init(tp_consumer_group_context_t *ctx)
+{
+    if (NULL == ctx)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_group_context_init: null input");
+        return -1;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->stream_budget = TP_CONSUMER_GROUP_STREAM_BUDGET_DEFAULT;
+    ctx->control_fragment_limit = TP_CONSUMER_GROUP_CONTROL_LIMIT_DEFAULT;
+    return 0;
+}
+
+int tp_consumer_group_init(tp_consumer_group_t **group, tp_client_t *client, const tp_consumer_group_context_t *ctx)
+{
+    tp_consumer_group_t *instance;
+
+    if (NULL == group || NULL == client || NULL == ctx || ctx->stream_budget == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_group_init: invalid input");
+        return -1;
+    }
+
+    *group = NULL;
+    instance = (tp_consumer_group_t *)calloc(1, sizeof(*instance));
+    if (NULL == instance)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_consumer_group_init: allocation failed");
+        return -1;
+    }
+
+    instance->client = client;
+    instance->context = *ctx;
+    if (instance->context.control_fragment_limit <= 0)
+    {
+        instance->context.control_fragment_limit = TP_CONSUMER_GROUP_CONTROL_LIMIT_DEFAULT;
+    }
+
+    *group = instance;
+    return 0;
+}
+
+int tp_consumer_group_close(tp_consumer_group_t *group)
+{
+    size_t i;
+
+    if (NULL == group)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < group->source_count; i++)
+    {
+        tp_fragment_assembler_close(&group->sources[i]->assembler);
+        tp_subscription_close(&group->sources[i]->subscription);
+        free(group->sources[i]);
+    }
+
+    tp_fragment_assembler_close(&group->control_assembler);
+    free(group->sources);
+    free(group->members);
+    free(group->routes);
+    free(group);
+    return 0;
+}
+
+static tp_consumer_group_source_t *tp_consumer_group_find_source(
+    tp_consumer_group_t *group,
+    const tp_subscription_t *subscription,
+    uint32_t *index)
+{
+    size_t i;
+
+    for (i = 0; i < group->source_count; i++)
+    {
+        const tp_subscription_t *shared = group->sources[i]->subscription;
+
+        if (shared->stream_id == subscription->stream_id &&
+            NULL != shared->channel && NULL != subscription->channel &&
+            strcmp(shared->channel, subscription->channel) == 0)
+        {
+            *index = (uint32_t)i;
+            return group->sources[i];
+        }
+    }
+
+    return NULL;
+}
+
+static tp_consumer_group_source_t *tp_consumer_group_adopt_source(
+    tp_consumer_group_t *group,
+    tp_subscription_t *subscription,
+    uint32_t *index)
+{
+    tp_consumer_group_source_t **sources;
+    tp_consumer_group_source_t *source;
+
+    sources = (tp_consumer_group_source_t **)realloc(
+        group->sources, (group->source_count + 1) * sizeof(*group->sources));
+    if (NULL == sources)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_consumer_group_add: source allocation failed");
+        return NULL;
+    }
+    group->sources = sources;
+
+    source = (tp_consumer_group_source_t *)calloc(1, sizeof(*source));
+    if (NULL == source)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_consumer_group_add: source allocation failed");
+        return NULL;
+    }
+
+    source->group = group;
+    if (tp_fragment_assembler_create(&source->assembler, tp_consumer_group_descriptor_handler, source) < 0)
+    {
+        free(source);
+        return NULL;
+    }
+
+    source->subscription = subscription;
+    *index = (uint32_t)group->source_count;
+    group->sources[group->source_count++] = source;
+    return source;
+}
+
+int tp_consumer_group_add(tp_consumer_group_t *group, tp_consumer_t *consumer)
+{
+    tp_consumer_group_member_t *member;
+    tp_consumer_group_source_t *source = NULL;
+    uint32_t source_index = TP_CONSUMER_GROUP_NO_SOURCE;
+    uint32_t stream_id;
+
+    if (NULL == group || NULL == consumer || consumer->client != group->client)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_group_add: invalid input");
+        return -1;
+    }
+
+    if (consumer->conductor_poll_registered)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_group_add: consumer is polled by the conductor");
+        return -1;
+    }
+
+    stream_id = consumer->context.stream_id;
+    if (NULL != tp_consumer_group_find(group, stream_id))
+    {
+        TP_SET_ERR(EEXIST, "%s", "tp_consumer_group_add: stream already in group");
+        return -1;
+    }
+
+    if (group->member_count == group->member_capacity)
+    {
+        size_t capacity = group->member_capacity == 0 ? 8 : group->member_capacity * 2;
+        tp_consumer_group_member_t *members = (tp_consumer_group_member_t *)realloc(
+            group->members, capacity * sizeof(*members));
+
+        if (NULL == members)
+        {
+            TP_SET_ERR(ENOMEM, "%s", "tp_consumer_group_add: member allocation failed");
+            return -1;
+        }
+        group->members = members;
+        group->member_capacity = capacity;
+    }
+
+    /* Only the shared descriptor stream is merged; a per-consumer assignment stays with its consumer. */
+    if (NULL != consumer->descriptor_subscription && consumer->assigned_descriptor_stream_id == 0)
+    {
+        source = tp_consumer_group_find_source(group, consumer->descriptor_subscription, &source_index);
+        if (NULL == source)
+        {
+            source = tp_consumer_group_adopt_source(group, consumer->descriptor_subscription, &source_index);
+            if (NULL == source)
+            {
+                return -1;
+            }
+            consumer->descriptor_subscription = NULL;
+        }
+    }
+
+    member = &group->members[group->member_count];
+    member->consumer = consumer;
+    member->stream_id = stream_id;
+    member->source_index = source_index;
+
+    if (tp_consumer_group_rebuild_routes(group, group->member_count + 1) < 0)
+    {
+        if (NULL != source && source->member_count == 0)
+        {
+            /* Hand a just-adopted subscription back rather than lose it. */
+            consumer->descriptor_subscription = source->subscription;
+            tp_fragment_assembler_close(&source->assembler);
+            free(source);
+            group->source_count--;
+        }
+        return -1;
+    }
+    group->member_count++;
+
+    if (NULL != source)
+    {
+        source->member_count++;
+        tp_subscription_close(&consumer->descriptor_subscription);
+        tp_fragment_assembler_close(&consumer->descriptor_assembler);
+    }
+
+    return 0;
+}
+
+static int tp_consumer_group_poll_member(tp_consumer_t *consumer, int limit)
+{
+    if (NULL == consumer->descriptor_assembler)
+    {
+        if (tp_fragment_assembler_create(
+            &consumer->descriptor_assembler,
+            tp_consumer_descriptor_handler,
+            consumer) < 0)
+        {
+            return -1;
+        }
+    }
+
+    return aeron_subscription_poll(
+        tp_subscription_handle(consumer->descriptor_subscription),
+        aeron_fragment_assembler_handler,
+        tp_fragment_assembler_handle(consumer->descriptor_assembler),
+        limit);
+}
+
+static int tp_consumer_group_poll_descriptors(tp_consumer_group_t *group, int fragment_limit)
+{
+    size_t targets = group->source_count + group->member_count;
+    int remaining = fragment_limit;
+    int total = 0;
+    int round_work;
+    size_t k;
+
+    if (targets == 0)
+    {
+        return 0;
+    }
+
+    /*
+     * Targets are the shared sources followed by members that poll their own subscription.
+     * The start rotates every poll and each round caps every target, so work is spread evenly
+     * when the total budget runs out.
+     */
+    do
+    {
+        round_work = 0;
+        for (k = 0; k < targets && remaining > 0; k++)
+        {
+            size_t index = (group->cursor + k) % targets;
+            uint64_t budget;
+            int polled;
+
+            if (index < group->source_count)
+            {
+                tp_consumer_group_source_t *source = group->sources[index];
+
+                budget = (uint64_t)group->context.stream_budget * source->member_count;
+                if (budget > (uint64_t)remaining)
+                {
+                    budget = (uint64_t)remaining;
+                }
+                polled = aeron_subscription_poll(
+                    tp_subscription_handle(source->subscription),
+                    aeron_fragment_assembler_handler,
+                    tp_fragment_assembler_handle(source->assembler),
+                    (size_t)budget);
+            }
+            else
+            {
+                tp_consumer_t *consumer = group->members[index - group->source_count].consumer;
+
+                if (NULL == consumer->descriptor_subscription)
+                {
+                    continue;
+                }
+                budget = group->context.stream_budget;
+                if (budget > (uint64_t)remaining)
+                {
+                    budget = (uint64_t)remaining;
+                }
+                polled = tp_consumer_group_poll_member(consumer, (int)budget);
+            }
+
+            if (polled < 0)
+            {
+                return -1;
+            }
+            remaining -= polled;
+            round_work += polled;
+            total += polled;
+        }
+    }
+    while (remaining > 0 && round_work > 0);
+
+    group->cursor = (group->cursor + 1) % targets;
+    return total;
+}
+
+static int tp_consumer_group_poll_control(tp_consumer_group_t *group)
+{
+    tp_subscription_t *subscriptions[2];
+    int fragments = 0;
+    size_t i;
+
+    if (NULL == group->control_assembler)
+    {
+        if (tp_fragment_assembler_create(&group->control_assembler, tp_consumer_group_control_handler, group) < 0)
+        {
+            return -1;
+        }
+    }
+
+    subscriptions[0] = tp_client_control_subscription(group->client);
+    subscriptions[1] = tp_client_announce_subscription(group->client);
+    for (i = 0; i < 2; i++)
+    {
+        int polled;
+
+        if (NULL == subscriptions[i])
+        {
+            continue;
+        }
+
+        polled = aeron_subscription_poll(
+            tp_subscription_handle(subscriptions[i]),
+            aeron_fragment_assembler_handler,
+            tp_fragment_assembler_handle(group->control_assembler),
+            group->context.control_fragment_limit);
+        if (polled < 0)
+        {
+            return -1;
+        }
+        fragments += polled;
+    }
+
+    return fragments;
+}
+
+int tp_consumer_group_poll(tp_consumer_group_t *group, int fragment_limit)
+{
+    uint64_t now_ns;
+    int total = 0;
+    int work;
+    size_t i;
+
+    if (NULL == group)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_consumer_group_poll: null input");
+        return -1;
+    }
+
+    work = tp_consumer_group_poll_control(group);
+    if (work < 0)
+    {
+        return -1;
+    }
+    total += work;
+
+    work = tp_consumer_group_poll_descriptors(group, fragment_limit);
+    if (work < 0)
+    {
+        return -1;
+    }
+    total += work;
+
+    now_ns = (uint64_t)tp_clock_now_ns();
+    for (i = 0; i < group->member_count; i++)
+    {
+        tp_consumer_t *consumer = group->members[i].consumer;
+
+        tp_consumer_finish_descriptor_poll(consumer);
+        tp_consumer_finish_control_poll(consumer, now_ns);
+
+        /* Progress on a per-consumer control stream is not seen by the shared control poll. */
+        if (consumer->progress_poller_initialized && NULL != consumer->control_subscription)
+        {
+            work = tp_consumer_poll_progress(consumer, (int)group->context.stream_budget);
+            if (work < 0)
+            {
+                return -1;
+            }
+            total += work;
+        }
+    }
+
+    tp_client_do_work(group->client);
+    return total;
+}
+
+size_t tp_consumer_group_member_count(const tp_consumer_group_t *group)
+{
+    return NULL == group ? 0 : group->member_count;
+}
+
+uint64_t tp_consumer_group_unrouted_count(const tp_consumer_group_t *group)
+{
+    return NULL == group ? 0 : group->unrouted;
+}
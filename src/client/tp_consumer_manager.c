@@ -57,23 +57,12 @@ static int tp_consumer_manager_add_publication(
 
 static tp_consumer_entry_t *tp_consumer_manager_find_entry(tp_consumer_manager_t *manager, uint32_t consumer_id)
 {
-    size_t i;
-
     if (NULL == manager)
     {
         return NULL;
     }
 
-    for (i = 0; i < manager->registry.capacity; i++)
-    {
-        tp_consumer_entry_t *entry = &manager->registry.entries[i];
-        if (entry->in_use && entry->consumer_id == consumer_id)
-        {
-            return entry;
-        }
-    }
-
-    return NULL;
+    return tp_consumer_registry_find(&manager->registry, consumer_id);
 }
 
 int tp_consumer_manager_init(tp_consumer_manager_t *manager, tp_producer_t *producer, size_t capacity)
@@ -177,52 +166,52 @@ int tp_consumer_manager_handle_hello(
 
     if (request.descriptor_requested)
     {
-        if (NULL == entry->descriptor_publication)
+        if (NULL == entry->hot->descriptor_publication)
         {
             if (tp_consumer_manager_add_publication(
                 manager->producer,
                 entry->descriptor_channel,
                 (int32_t)entry->descriptor_stream_id,
-                &entry->descriptor_publication) < 0)
+                &entry->hot->descriptor_publication) < 0)
             {
-                entry->descriptor_publication = NULL;
+                entry->hot->descriptor_publication = NULL;
             }
         }
 
-        if (NULL != entry->descriptor_publication)
+        if (NULL != entry->hot->descriptor_publication)
         {
             descriptor_channel = entry->descriptor_channel;
             descriptor_stream_id = entry->descriptor_stream_id;
         }
     }
-    else if (entry->descriptor_publication)
+    else if (entry->hot->descriptor_publication)
     {
-        tp_publication_close(&entry->descriptor_publication);
+        tp_publication_close(&entry->hot->descriptor_publication);
     }
 
     if (request.control_requested)
     {
-        if (NULL == entry->control_publication)
+        if (NULL == entry->hot->control_publication)
         {
             if (tp_consumer_manager_add_publication(
                 manager->producer,
                 entry->control_channel,
                 (int32_t)entry->control_stream_id,
-                &entry->control_publication) < 0)
+                &entry->hot->control_publication) < 0)
             {
-                entry->control_publication = NULL;
+                entry->hot->control_publication = NULL;
             }
         }
 
-        if (NULL != entry->control_publication)
+        if (NULL != entry->hot->control_publication)
         {
             control_channel = entry->control_channel;
             control_stream_id = entry->control_stream_id;
         }
     }
-    else if (entry->control_publication)
+    else if (entry->hot->control_publication)
     {
-        tp_publication_close(&entry->control_publication);
+        tp_publication_close(&entry->hot->control_publication);
     }
 
     memset(&config, 0, sizeof(config));
@@ -372,9 +361,9 @@ int tp_consumer_manager_publish_descriptor(
     }
 
     entry = tp_consumer_manager_find_entry(manager, consumer_id);
-    if (entry && entry->descriptor_publication)
+    if (entry && entry->hot->descriptor_publication)
     {
-        publication = entry->descriptor_publication;
+        publication = entry->hot->descriptor_publication;
     }
     else
     {
@@ -407,9 +396,9 @@ int tp_consumer_manager_publish_progress(
     }
 
     entry = tp_consumer_manager_find_entry(manager, consumer_id);
-    if (entry && entry->control_publication)
+    if (entry && entry->hot->control_publication)
     {
-        publication = entry->control_publication;
+        publication = entry->hot->control_publication;
     }
     else
     {
@@ -92,6 +92,13 @@ int tp_consumer_registry_init(tp_consumer_registry_t *registry, size_t capacity)
         return -1;
     }
 
+    if (aeron_alloc((void **)&registry->active, sizeof(tp_consumer_hot_t) * capacity) < 0)
+    {
+        aeron_free(registry->entries);
+        registry->entries = NULL;
+        return -1;
+    }
+
     registry->capacity = capacity;
     return 0;
 }
@@ -105,28 +112,36 @@ void tp_consumer_registry_close(tp_consumer_registry_t *registry)
         return;
     }
 
-    for (i = 0; i < registry->capacity; i++)
+    for (i = 0; i < registry->active_count; i++)
     {
-        tp_consumer_entry_t *entry = &registry->entries[i];
-        tp_publication_close(&entry->descriptor_publication);
-        tp_publication_close(&entry->control_publication);
+        tp_consumer_hot_t *hot = &registry->active[i];
+        tp_publication_close(&hot->descriptor_publication);
+        tp_publication_close(&hot->control_publication);
     }
 
+    aeron_free(registry->active);
     aeron_free(registry->entries);
+    registry->active = NULL;
     registry->entries = NULL;
+    registry->active_count = 0;
     registry->capacity = 0;
 }
 
-static tp_consumer_entry_t *tp_consumer_registry_find(tp_consumer_registry_t *registry, uint32_t consumer_id)
+tp_consumer_entry_t *tp_consumer_registry_find(tp_consumer_registry_t *registry, uint32_t consumer_id)
 {
     size_t i;
 
-    for (i = 0; i < registry->capacity; i++)
+    if (NULL == registry || NULL == registry->entries)
     {
-        tp_consumer_entry_t *entry = &registry->entries[i];
-        if (entry->in_use && entry->consumer_id == consumer_id)
+        return NULL;
+    }
+
+    for (i = 0; i < registry->active_count; i++)
+    {
+        const tp_consumer_hot_t *hot = &registry->active[i];
+        if (hot->consumer_id == consumer_id)
         {
-            return entry;
+            return &registry->entries[hot->entry_index];
         }
     }
 
@@ -137,14 +152,25 @@ static tp_consumer_entry_t *tp_consumer_registry_alloc(tp_consumer_registry_t *r
 {
     size_t i;
 
+    if (registry->active_count >= registry->capacity)
+    {
+        return NULL;
+    }
+
     for (i = 0; i < registry->capacity; i++)
     {
         tp_consumer_entry_t *entry = &registry->entries[i];
         if (!entry->in_use)
         {
+            tp_consumer_hot_t *hot = &registry->active[registry->active_count++];
+
             memset(entry, 0, sizeof(*entry));
+            memset(hot, 0, sizeof(*hot));
             entry->in_use = true;
             entry->consumer_id = consumer_id;
+            entry->hot = hot;
+            hot->consumer_id = consumer_id;
+            hot->entry_index = (uint32_t)i;
             return entry;
         }
     }
@@ -152,6 +178,25 @@ static tp_consumer_entry_t *tp_consumer_registry_alloc(tp_consumer_registry_t *r
     return NULL;
 }
 
+static void tp_consumer_registry_remove(tp_consumer_registry_t *registry, tp_consumer_entry_t *entry)
+{
+    tp_consumer_hot_t *hot = entry->hot;
+    tp_consumer_hot_t *last = &registry->active[registry->active_count - 1];
+
+    tp_publication_close(&hot->descriptor_publication);
+    tp_publication_close(&hot->control_publication);
+
+    if (hot != last)
+    {
+        *hot = *last;
+        registry->entries[hot->entry_index].hot = hot;
+    }
+
+    registry->active_count--;
+    entry->hot = NULL;
+    entry->in_use = false;
+}
+
 int tp_consumer_registry_update(
     tp_consumer_registry_t *registry,
     const tp_consumer_hello_view_t *hello,
@@ -160,6 +205,7 @@ int tp_consumer_registry_update(
 {
     tp_consumer_request_t request;
     tp_consumer_entry_t *entry;
+    tp_consumer_hot_t *hot;
 
     if (NULL == registry || NULL == hello)
     {
@@ -183,9 +229,16 @@ int tp_consumer_registry_update(
         }
     }
 
+    hot = entry->hot;
+    hot->mode = hello->mode;
+    hot->max_rate_hz = hello->max_rate_hz;
+    hot->descriptor_interval_ns = 0;
+    if (hello->mode == TP_MODE_RATE_LIMITED && hello->max_rate_hz > 0)
+    {
+        hot->descriptor_interval_ns = 1000000000ULL / hello->max_rate_hz;
+    }
+
     entry->last_seen_ns = now_ns;
-    entry->mode = hello->mode;
-    entry->max_rate_hz = hello->max_rate_hz;
     entry->supports_progress = hello->supports_progress;
     entry->progress_interval_us = hello->progress_interval_us;
     entry->progress_bytes_delta = hello->progress_bytes_delta;
@@ -240,9 +293,7 @@ int tp_consumer_registry_sweep(tp_consumer_registry_t *registry, uint64_t now_ns
 
         if (now_ns - entry->last_seen_ns > stale_ns)
         {
-            tp_publication_close(&entry->descriptor_publication);
-            tp_publication_close(&entry->control_publication);
-            entry->in_use = false;
+            tp_consumer_registry_remove(registry, entry);
             cleaned++;
         }
     }
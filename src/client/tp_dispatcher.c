@@ -0,0 +1,489 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/client/tp_dispatcher.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/tp_error.h"
+#include "tensor_pool/tp_seqlock.h"
+#include "tensor_pool/tp_slot.h"
+#include "tp_steal_queue.h"
+
+enum
+{
+    TP_DISPATCHER_QUEUE_CAPACITY_DEFAULT = 256,
+    TP_DISPATCHER_POLL_BATCH = 64,
+    TP_DISPATCHER_IDLE_SPINS = 64,
+    TP_DISPATCHER_IDLE_YIELDS = 256,
+    TP_DISPATCHER_IDLE_SLEEP_NS = 50000
+};
+
+enum
+{
+    TP_DISPATCH_ITEM_FREE = 0,
+    TP_DISPATCH_ITEM_QUEUED = 1,
+    TP_DISPATCH_ITEM_DONE = 2,
+    TP_DISPATCH_ITEM_TORN = 3
+};
+
+/*
+ * Frames live in a ticket ring; worker queues carry tickets. A ticket is reclaimed only once
+ * every earlier ticket is done, which is also what gives ordered_complete its seq order.
+ * Each queued frame holds the consumer mapping it was read from until it is reclaimed.
+ */
+typedef struct tp_dispatch_item_stct
+{
+    tp_frame_view_t view;
+    const uint64_t *seq_commit;
+    tp_consumer_mapping_t *mapping;
+    _Atomic uint32_t state;
+}
+tp_dispatch_item_t;
+
+typedef struct tp_dispatch_worker_stct
+{
+    tp_dispatcher_t *dispatcher;
+    tp_steal_queue_t queue;
+    pthread_t thread;
+    uint32_t index;
+}
+tp_dispatch_worker_t;
+
+struct tp_dispatcher_stct
+{
+    tp_consumer_t *consumer;
+    tp_dispatcher_context_t context;
+    tp_dispatch_worker_t *workers;
+    uint32_t started;
+    uint32_t next_worker;
+    tp_dispatch_item_t *items;
+    uint64_t item_mask;
+    uint64_t next_ticket;
+    _Atomic bool stop;
+    _Atomic bool draining;
+    _Alignas(64) _Atomic uint64_t completed_ticket;
+    _Alignas(64) _Atomic uint64_t processed;
+    _Atomic uint64_t stolen;
+    _Atomic uint64_t torn;
+};
+
+static uint64_t tp_dispatcher_round_pow2(uint64_t value)
+{
+    uint64_t result = 1;
+
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+int tp_dispatcher_context_init(tp_dispatcher_context_t *ctx)
+{
+    if (NULL == ctx)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_dispatcher_context_init: null input");
+        return -1;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->worker_count = 1;
+    ctx->queue_capacity = TP_DISPATCHER_QUEUE_CAPACITY_DEFAULT;
+    ctx->validate_after_process = true;
+    return 0;
+}
+
+static void tp_dispatcher_drain_completed(tp_dispatcher_t *dispatcher)
+{
+    for (;;)
+    {
+        uint64_t ticket;
+
+        if (atomic_exchange_explicit(&dispatcher->draining, true, memory_order_acquire))
+        {
+            return;
+        }
+
+        ticket = atomic_load_explicit(&dispatcher->completed_ticket, memory_order_relaxed);
+        for (;;)
+        {
+            tp_dispatch_item_t *item = &dispatcher->items[ticket & dispatcher->item_mask];
+            uint32_t state = atomic_load_explicit(&item->state, memory_order_acquire);
+
+            if (state != TP_DISPATCH_ITEM_DONE && state != TP_DISPATCH_ITEM_TORN)
+            {
+                break;
+            }
+
+            if (NULL != dispatcher->context.ordered_complete)
+            {
+                dispatcher->context.ordered_complete(
+                    dispatcher->context.clientd, &item->view, state == TP_DISPATCH_ITEM_DONE);
+            }
+            tp_consumer_release_mapping(item->mapping);
+            item->mapping = NULL;
+            atomic_store_explicit(&item->state, TP_DISPATCH_ITEM_FREE, memory_order_relaxed);
+            ticket++;
+            atomic_store_explicit(&dispatcher->completed_ticket, ticket, memory_order_release);
+        }
+
+        atomic_store_explicit(&dispatcher->draining, false, memory_order_release);
+
+        /*
+         * A worker that finished the head ticket while we held the flag would otherwise be lost.
+         * The fence pairs with the one in run_item: either that worker wins the flag or we see
+         * its state here.
+         */
+        atomic_thread_fence(memory_order_seq_cst);
+        {
+            tp_dispatch_item_t *head = &dispatcher->items[ticket & dispatcher->item_mask];
+            uint32_t state = atomic_load_explicit(&head->state, memory_order_acquire);
+
+            if (state != TP_DISPATCH_ITEM_DONE && state != TP_DISPATCH_ITEM_TORN)
+            {
+                return;
+            }
+        }
+    }
+}
+
+static void tp_dispatcher_run_item(tp_dispatcher_t *dispatcher, uint64_t ticket, uint32_t worker_index)
+{
+    tp_dispatch_item_t *item = &dispatcher->items[ticket & dispatcher->item_mask];
+    uint32_t state = TP_DISPATCH_ITEM_DONE;
+
+    dispatcher->context.process(dispatcher->context.clientd, &item->view, worker_index);
+
+    if (dispatcher->context.validate_after_process && NULL != item->seq_commit)
+    {
+        /* Payload loads made by process must complete before seq_commit is re-read. */
+        atomic_thread_fence(memory_order_acquire);
+        if (tp_atomic_load_u64(item->seq_commit) != tp_seq_committed(item->view.seq))
+        {
+            state = TP_DISPATCH_ITEM_TORN;
+            atomic_fetch_add_explicit(&dispatcher->torn, 1, memory_order_relaxed);
+        }
+    }
+
+    atomic_fetch_add_explicit(&dispatcher->processed, 1, memory_order_relaxed);
+    atomic_store_explicit(&item->state, state, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+    tp_dispatcher_drain_completed(dispatcher);
+}
+
+static bool tp_dispatcher_take(tp_dispatcher_t *dispatcher, uint32_t index, uint64_t *ticket)
+{
+    uint32_t count = dispatcher->context.worker_count;
+    uint32_t i;
+
+    if (tp_steal_queue_take(&dispatcher->workers[index].queue, ticket))
+    {
+        return true;
+    }
+
+    for (i = 1; i < count; i++)
+    {
+        if (tp_steal_queue_take(&dispatcher->workers[(index + i) % count].queue, ticket))
+        {
+            atomic_fetch_add_explicit(&dispatcher->stolen, 1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void *tp_dispatcher_worker(void *arg)
+{
+    tp_dispatch_worker_t *worker = (tp_dispatch_worker_t *)arg;
+    tp_dispatcher_t *dispatcher = worker->dispatcher;
+    uint32_t idle = 0;
+
+    for (;;)
+    {
+        uint64_t ticket;
+
+        if (tp_dispatcher_take(dispatcher, worker->index, &ticket))
+        {
+            tp_dispatcher_run_item(dispatcher, ticket, worker->index);
+            idle = 0;
+            continue;
+        }
+
+        /* Close only sets stop once polling has ended, so empty queues stay empty. */
+        if (atomic_load_explicit(&dispatcher->stop, memory_order_acquire))
+        {
+            if (!tp_dispatcher_take(dispatcher, worker->index, &ticket))
+            {
+                break;
+            }
+            tp_dispatcher_run_item(dispatcher, ticket, worker->index);
+            continue;
+        }
+
+        idle++;
+        if (idle < TP_DISPATCHER_IDLE_SPINS)
+        {
+            continue;
+        }
+        if (idle < TP_DISPATCHER_IDLE_SPINS + TP_DISPATCHER_IDLE_YIELDS)
+        {
+            sched_yield();
+        }
+        else
+        {
+            struct timespec pause = { 0, TP_DISPATCHER_IDLE_SLEEP_NS };
+            nanosleep(&pause, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+int tp_dispatcher_init(tp_dispatcher_t **dispatcher, tp_consumer_t *consumer, const tp_dispatcher_context_t *ctx)
+{
+    tp_dispatcher_t *instance;
+    uint64_t queue_capacity;
+    uint64_t item_count;
+    uint32_t i;
+
+    if (NULL == dispatcher || NULL == consumer || NULL == ctx || NULL == ctx->process || ctx->worker_count == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_dispatcher_init: invalid input");
+        return -1;
+    }
+
+    *dispatcher = NULL;
+    instance = (tp_dispatcher_t *)calloc(1, sizeof(*instance));
+    if (NULL == instance)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_dispatcher_init: allocation failed");
+        return -1;
+    }
+
+    instance->consumer = consumer;
+    instance->context = *ctx;
+    queue_capacity = tp_dispatcher_round_pow2(
+        ctx->queue_capacity == 0 ? TP_DISPATCHER_QUEUE_CAPACITY_DEFAULT : ctx->queue_capacity);
+    item_count = tp_dispatcher_round_pow2(queue_capacity * ctx->worker_count);
+    atomic_init(&instance->stop, false);
+    atomic_init(&instance->draining, false);
+    atomic_init(&instance->completed_ticket, 0);
+    atomic_init(&instance->processed, 0);
+    atomic_init(&instance->stolen, 0);
+    atomic_init(&instance->torn, 0);
+
+    instance->items = (tp_dispatch_item_t *)calloc(item_count, sizeof(*instance->items));
+    instance->workers = (tp_dispatch_worker_t *)calloc(ctx->worker_count, sizeof(*instance->workers));
+    if (NULL == instance->items || NULL == instance->workers)
+    {
+        free(instance->items);
+        free(instance->workers);
+        free(instance);
+        TP_SET_ERR(ENOMEM, "%s", "tp_dispatcher_init: allocation failed");
+        return -1;
+    }
+    instance->item_mask = item_count - 1;
+    for (i = 0; i < item_count; i++)
+    {
+        atomic_init(&instance->items[i].state, TP_DISPATCH_ITEM_FREE);
+    }
+
+    for (i = 0; i < ctx->worker_count; i++)
+    {
+        instance->workers[i].dispatcher = instance;
+        instance->workers[i].index = i;
+        if (tp_steal_queue_init(&instance->workers[i].queue, (size_t)queue_capacity) < 0)
+        {
+            tp_dispatcher_close(instance);
+            return -1;
+        }
+    }
+
+    for (i = 0; i < ctx->worker_count; i++)
+    {
+        int err = pthread_create(&instance->workers[i].thread, NULL, tp_dispatcher_worker, &instance->workers[i]);
+        if (err != 0)
+        {
+            tp_dispatcher_close(instance);
+            TP_SET_ERR(err, "%s", "tp_dispatcher_init: pthread_create failed");
+            return -1;
+        }
+        instance->started++;
+    }
+
+    *dispatcher = instance;
+    return 0;
+}
+
+int tp_dispatcher_close(tp_dispatcher_t *dispatcher)
+{
+    uint64_t j;
+    uint32_t i;
+
+    if (NULL == dispatcher)
+    {
+        return 0;
+    }
+
+    atomic_store_explicit(&dispatcher->stop, true, memory_order_release);
+    for (i = 0; i < dispatcher->started; i++)
+    {
+        pthread_join(dispatcher->workers[i].thread, NULL);
+    }
+
+    /* Workers are gone, so finish any completions they left and drop mappings nothing will run. */
+    if (NULL != dispatcher->items)
+    {
+        tp_dispatcher_drain_completed(dispatcher);
+        for (j = 0; j <= dispatcher->item_mask; j++)
+        {
+            tp_consumer_release_mapping(dispatcher->items[j].mapping);
+            dispatcher->items[j].mapping = NULL;
+        }
+    }
+
+    for (i = 0; i < dispatcher->context.worker_count; i++)
+    {
+        tp_steal_queue_close(&dispatcher->workers[i].queue);
+    }
+
+    free(dispatcher->workers);
+    free(dispatcher->items);
+    free(dispatcher);
+    return 0;
+}
+
+static size_t tp_dispatcher_free_space(tp_dispatcher_t *dispatcher)
+{
+    uint64_t completed = atomic_load_explicit(&dispatcher->completed_ticket, memory_order_acquire);
+    uint64_t ring_free = (dispatcher->item_mask + 1) - (dispatcher->next_ticket - completed);
+    uint64_t queue_free = 0;
+    uint32_t i;
+
+    for (i = 0; i < dispatcher->context.worker_count; i++)
+    {
+        tp_steal_queue_t *queue = &dispatcher->workers[i].queue;
+        queue_free += queue->capacity - tp_steal_queue_size(queue);
+    }
+
+    return (size_t)(ring_free < queue_free ? ring_free : queue_free);
+}
+
+static void tp_dispatcher_submit(tp_dispatcher_t *dispatcher, const tp_frame_view_t *view)
+{
+    tp_consumer_t *consumer = dispatcher->consumer;
+    uint64_t ticket = dispatcher->next_ticket;
+    tp_dispatch_item_t *item = &dispatcher->items[ticket & dispatcher->item_mask];
+    uint32_t count = dispatcher->context.worker_count;
+    uint32_t i;
+
+    item->view = *view;
+    item->seq_commit = NULL;
+    item->mapping = tp_consumer_hold_mapping(consumer);
+    if (consumer->shm_mapped && consumer->header_nslots > 0)
+    {
+        item->seq_commit = (const uint64_t *)tp_slot_at(
+            consumer->header_region.addr, (uint32_t)(view->seq & (consumer->header_nslots - 1)));
+    }
+    atomic_store_explicit(&item->state, TP_DISPATCH_ITEM_QUEUED, memory_order_relaxed);
+    dispatcher->next_ticket++;
+
+    /* free_space covered this frame, so one of the queues has room. */
+    for (i = 0; i < count; i++)
+    {
+        uint32_t index = (dispatcher->next_worker + i) % count;
+
+        if (tp_steal_queue_push(&dispatcher->workers[index].queue, ticket))
+        {
+            dispatcher->next_worker = (index + 1) % count;
+            return;
+        }
+    }
+}
+
+int tp_dispatcher_poll(tp_dispatcher_t *dispatcher, size_t max_frames)
+{
+    tp_frame_view_t views[TP_DISPATCHER_POLL_BATCH];
+    size_t limit;
+    int frames;
+    int i;
+
+    if (NULL == dispatcher)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_dispatcher_poll: null input");
+        return -1;
+    }
+
+    limit = tp_dispatcher_free_space(dispatcher);
+    if (limit > max_frames)
+    {
+        limit = max_frames;
+    }
+    if (limit > TP_DISPATCHER_POLL_BATCH)
+    {
+        limit = TP_DISPATCHER_POLL_BATCH;
+    }
+    if (limit == 0)
+    {
+        return 0;
+    }
+
+    if (dispatcher->consumer->context.follow_ring)
+    {
+        frames = tp_consumer_poll_ring(dispatcher->consumer, views, limit);
+    }
+    else
+    {
+        frames = tp_consumer_poll_frames(dispatcher->consumer, views, limit);
+    }
+    if (frames < 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < frames; i++)
+    {
+        tp_dispatcher_submit(dispatcher, &views[i]);
+    }
+
+    return frames;
+}
+
+int tp_dispatcher_get_counts(
+    const tp_dispatcher_t *dispatcher,
+    uint64_t *processed,
+    uint64_t *stolen,
+    uint64_t *torn)
+{
+    tp_dispatcher_t *mutable_dispatcher = (tp_dispatcher_t *)dispatcher;
+
+    if (NULL == dispatcher)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_dispatcher_get_counts: null input");
+        return -1;
+    }
+
+    if (NULL != processed)
+    {
+        *processed = atomic_load_explicit(&mutable_dispatcher->processed, memory_order_relaxed);
+    }
+    if (NULL != stolen)
+    {
+        *stolen = atomic_load_explicit(&mutable_dispatcher->stolen, memory_order_relaxed);
+    }
+    if (NULL != torn)
+    {
+        *torn = atomic_load_explicit(&mutable_dispatcher->torn, memory_order_relaxed);
+    }
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sched.h>
 #include <stdatomic.h>
 
 #include "tensor_pool/tp_clock.h"
@@ -34,8 +35,11 @@
 #include "wire/tensor_pool/regionType.h"
 
 #include "tp_aeron_wrap.h"
+#include "tp_copy_pool.h"
 
 enum { TP_PRODUCER_DEFAULT_FRAGMENT_LIMIT = 10 };
+enum { TP_DESCRIPTOR_IMAGE_BYTES = 64 };
+enum { TP_PRODUCER_REORDER_WINDOW_DEFAULT = 64 };
 
 typedef struct tp_tracelink_entry_stct
 {
@@ -47,6 +51,7 @@ tp_tracelink_entry_t;
 static int tp_producer_poll_dispatch(void *clientd, int fragment_limit);
 
 static tp_payload_pool_t *tp_find_pool_for_length(tp_producer_t *producer, size_t length);
+static void tp_producer_reorder_reset(tp_producer_t *producer, uint64_t next_seq);
 
 static tp_payload_pool_t *tp_find_pool(tp_producer_t *producer, uint16_t pool_id)
 {
@@ -359,45 +364,35 @@ static void tp_producer_fill_driver_request(tp_producer_t *producer, tp_driver_a
     }
 }
 
-int tp_producer_publish_descriptor_to(
+static size_t tp_producer_encode_descriptor(
     tp_producer_t *producer,
-    tp_publication_t *publication,
+    uint8_t *buffer,
+    size_t capacity,
     uint64_t seq,
     uint64_t timestamp_ns,
     uint32_t meta_version,
     uint64_t trace_id)
 {
-    uint8_t buffer[256];
     struct tensor_pool_messageHeader msg_header;
     struct tensor_pool_frameDescriptor descriptor;
     const size_t header_len = tensor_pool_messageHeader_encoded_length();
     const size_t body_len = tensor_pool_frameDescriptor_sbe_block_length();
-    int64_t result;
     uint64_t encoded_timestamp =
         (timestamp_ns == TP_NULL_U64) ? tensor_pool_frameDescriptor_timestampNs_null_value() : timestamp_ns;
     uint32_t encoded_meta_version =
         (meta_version == TP_NULL_U32) ? tensor_pool_frameDescriptor_metaVersion_null_value() : meta_version;
-    tp_log_t *log = NULL;
 
-    if (NULL == producer || NULL == publication)
+    if (capacity < header_len + body_len)
     {
-        TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_descriptor_to: publication unavailable");
-        return -1;
-    }
-
-    if (producer->client)
-    {
-        log = &producer->client->context->log;
+        return 0;
     }
 
-    memset(buffer, 0, header_len + tensor_pool_tensorHeader_sbe_block_length());
-
     tensor_pool_messageHeader_wrap(
         &msg_header,
         (char *)buffer,
         0,
         tensor_pool_messageHeader_sbe_schema_version(),
-        sizeof(buffer));
+        capacity);
     tensor_pool_messageHeader_set_blockLength(&msg_header, (uint16_t)body_len);
     tensor_pool_messageHeader_set_templateId(&msg_header, tensor_pool_frameDescriptor_sbe_template_id());
     tensor_pool_messageHeader_set_schemaId(&msg_header, tensor_pool_frameDescriptor_sbe_schema_id());
@@ -407,7 +402,7 @@ int tp_producer_publish_descriptor_to(
         &descriptor,
         (char *)buffer,
         header_len,
-        sizeof(buffer));
+        capacity);
 
     tensor_pool_frameDescriptor_set_streamId(&descriptor, producer->stream_id);
     tensor_pool_frameDescriptor_set_epoch(&descriptor, producer->epoch);
@@ -416,10 +411,10 @@ int tp_producer_publish_descriptor_to(
     tensor_pool_frameDescriptor_set_metaVersion(&descriptor, encoded_meta_version);
     tensor_pool_frameDescriptor_set_traceId(&descriptor, trace_id);
 
-    if (log)
+    if (producer->client)
     {
         tp_log_emit(
-            log,
+            &producer->client->context->log,
             TP_LOG_TRACE,
             "descriptor publish stream=%u epoch=%" PRIu64 " seq=%" PRIu64 " ts=%" PRIu64 " meta=%u trace=%" PRIu64,
             producer->stream_id,
@@ -430,13 +425,22 @@ int tp_producer_publish_descriptor_to(
             trace_id);
     }
 
-    result = aeron_publication_offer(
-        tp_publication_handle(publication),
-        buffer,
-        header_len + body_len,
-        NULL,
-        NULL);
+    return header_len + body_len;
+}
+
+/*
+ * Claims space in the publication term buffer and copies the pre-encoded descriptor in place,
+ * so a fan-out encodes once and avoids the intermediate copy made by aeron_publication_offer.
+ */
+static int tp_producer_offer_descriptor_image(
+    tp_publication_t *publication,
+    const uint8_t *image,
+    size_t length)
+{
+    aeron_buffer_claim_t claim;
+    int64_t result;
 
+    result = aeron_publication_try_claim(tp_publication_handle(publication), length, &claim);
     if (result < 0)
     {
         if (result != AERON_PUBLICATION_ERROR)
@@ -467,9 +471,44 @@ int tp_producer_publish_descriptor_to(
         return (int)result;
     }
 
+    memcpy(claim.data, image, length);
+    if (aeron_buffer_claim_commit(&claim) < 0)
+    {
+        TP_SET_ERR(EAGAIN, "%s", "tp_producer_publish_descriptor_to: claim commit failed");
+        return -1;
+    }
+
     return 0;
 }
 
+int tp_producer_publish_descriptor_to(
+    tp_producer_t *producer,
+    tp_publication_t *publication,
+    uint64_t seq,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id)
+{
+    uint8_t image[TP_DESCRIPTOR_IMAGE_BYTES];
+    size_t length;
+
+    if (NULL == producer || NULL == publication)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_descriptor_to: publication unavailable");
+        return -1;
+    }
+
+    length = tp_producer_encode_descriptor(
+        producer, image, sizeof(image), seq, timestamp_ns, meta_version, trace_id);
+    if (length == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_descriptor_to: descriptor encode failed");
+        return -1;
+    }
+
+    return tp_producer_offer_descriptor_image(publication, image, length);
+}
+
 static int tp_producer_publish_descriptor(
     tp_producer_t *producer,
     uint64_t seq,
@@ -477,40 +516,43 @@ static int tp_producer_publish_descriptor(
     uint32_t meta_version,
     uint64_t trace_id)
 {
+    uint8_t image[TP_DESCRIPTOR_IMAGE_BYTES];
+    size_t length;
     int result = 0;
     int published = 0;
     int published_ok = 0;
     uint64_t now_ns = (uint64_t)tp_clock_now_ns();
 
+    length = tp_producer_encode_descriptor(
+        producer, image, sizeof(image), seq, timestamp_ns, meta_version, trace_id);
+    if (length == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_descriptor: descriptor encode failed");
+        return -1;
+    }
+
     if (producer->consumer_manager)
     {
         tp_consumer_registry_t *registry = &producer->consumer_manager->registry;
         size_t i;
-        for (i = 0; i < registry->capacity; i++)
+        for (i = 0; i < registry->active_count; i++)
         {
-            tp_consumer_entry_t *entry = &registry->entries[i];
-            if (!entry->in_use || NULL == entry->descriptor_publication)
+            tp_consumer_hot_t *hot = &registry->active[i];
+            if (NULL == hot->descriptor_publication)
             {
                 continue;
             }
-            if (entry->mode == TP_MODE_RATE_LIMITED && entry->max_rate_hz > 0)
+            if (hot->descriptor_interval_ns > 0)
             {
-                uint64_t interval_ns = 1000000000ULL / entry->max_rate_hz;
-                if (interval_ns > 0 && entry->last_descriptor_ns != 0 &&
-                    now_ns - entry->last_descriptor_ns < interval_ns)
+                if (hot->last_descriptor_ns != 0 &&
+                    now_ns - hot->last_descriptor_ns < hot->descriptor_interval_ns)
                 {
                     continue;
                 }
-                entry->last_descriptor_ns = now_ns;
+                hot->last_descriptor_ns = now_ns;
             }
             {
-                int offer_result = tp_producer_publish_descriptor_to(
-                    producer,
-                    entry->descriptor_publication,
-                    seq,
-                    timestamp_ns,
-                    meta_version,
-                    trace_id);
+                int offer_result = tp_producer_offer_descriptor_image(hot->descriptor_publication, image, length);
                 if (offer_result == AERON_PUBLICATION_NOT_CONNECTED &&
                     producer->context.drop_unconnected_descriptors)
                 {
@@ -532,13 +574,7 @@ static int tp_producer_publish_descriptor(
 
     if (producer->descriptor_publication)
     {
-        int offer_result = tp_producer_publish_descriptor_to(
-            producer,
-            producer->descriptor_publication,
-            seq,
-            timestamp_ns,
-            meta_version,
-            trace_id);
+        int offer_result = tp_producer_offer_descriptor_image(producer->descriptor_publication, image, length);
         if (offer_result == AERON_PUBLICATION_NOT_CONNECTED &&
             producer->context.drop_unconnected_descriptors)
         {
@@ -710,7 +746,8 @@ static void tp_producer_unmap_regions(tp_producer_t *producer)
     producer->header_nslots = 0;
     producer->epoch = 0;
     producer->layout_version = 0;
-    producer->next_seq = 0;
+    atomic_store_explicit(&producer->next_seq, 0, memory_order_relaxed);
+    tp_producer_reorder_reset(producer, 0);
 }
 
 static uint64_t tp_producer_next_backoff_ns(uint32_t failures)
@@ -770,6 +807,69 @@ void tp_producer_context_set_payload_flush(
     ctx->payload_flush_clientd = clientd;
 }
 
+void tp_producer_context_set_payload_copy_engine(
+    tp_producer_context_t *ctx,
+    tp_copy_engine_t engine,
+    size_t threshold_bytes)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->payload_copy_engine = engine;
+    ctx->payload_copy_threshold = threshold_bytes;
+}
+
+void tp_producer_context_set_payload_copy_threads(
+    tp_producer_context_t *ctx,
+    uint32_t helper_threads,
+    size_t threshold_bytes,
+    size_t stripe_bytes)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->payload_copy_threads = helper_threads;
+    ctx->payload_copy_parallel_threshold = threshold_bytes;
+    ctx->payload_copy_stripe_bytes = stripe_bytes;
+}
+
+void tp_producer_context_set_concurrent_claims(tp_producer_context_t *ctx, bool enabled, uint32_t reorder_window)
+{
+    if (NULL == ctx)
+    {
+        return;
+    }
+
+    ctx->concurrent_claims = enabled;
+    ctx->reorder_window = reorder_window;
+}
+
+static void tp_producer_copy_payload(tp_producer_t *producer, void *dst, const void *src, size_t length)
+{
+    if (dst == src || length == 0)
+    {
+        return;
+    }
+
+    if (NULL != producer->copy_pool && length >= producer->context.payload_copy_parallel_threshold)
+    {
+        tp_copy_pool_copy(producer->copy_pool, dst, src, length);
+        return;
+    }
+
+    if (NULL != producer->payload_copy && length >= producer->context.payload_copy_threshold)
+    {
+        producer->payload_copy(dst, src, length);
+        return;
+    }
+
+    memcpy(dst, src, length);
+}
+
 void tp_producer_set_trace_id_generator(tp_producer_t *producer, tp_trace_id_generator_t *generator)
 {
     if (NULL == producer)
@@ -1027,6 +1127,53 @@ int tp_producer_init(tp_producer_t **producer, tp_client_t *client, const tp_pro
     memset(instance, 0, sizeof(*instance));
     instance->client = client;
     instance->context = *context;
+    if (instance->context.payload_copy_engine != TP_COPY_ENGINE_MEMCPY)
+    {
+        if (instance->context.payload_copy_threshold == 0)
+        {
+            instance->context.payload_copy_threshold = TP_COPY_NT_THRESHOLD_DEFAULT;
+        }
+        instance->payload_copy = tp_copy_engine_fn(instance->context.payload_copy_engine);
+    }
+
+    if (instance->context.payload_copy_threads > 0)
+    {
+        if (instance->context.payload_copy_parallel_threshold == 0)
+        {
+            instance->context.payload_copy_parallel_threshold = TP_COPY_PARALLEL_THRESHOLD_DEFAULT;
+        }
+        if (tp_copy_pool_init(
+            &instance->copy_pool,
+            instance->context.payload_copy_threads,
+            instance->context.payload_copy_stripe_bytes,
+            NULL != instance->payload_copy ? instance->payload_copy : tp_copy_engine_fn(TP_COPY_ENGINE_MEMCPY)) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    if (instance->context.concurrent_claims)
+    {
+        uint64_t window = 1;
+        uint32_t requested = instance->context.reorder_window == 0
+            ? TP_PRODUCER_REORDER_WINDOW_DEFAULT
+            : instance->context.reorder_window;
+
+        while (window < requested)
+        {
+            window <<= 1;
+        }
+
+        if (aeron_alloc((void **)&instance->reorder_entries, window * sizeof(tp_producer_reorder_entry_t)) < 0)
+        {
+            TP_SET_ERR(ENOMEM, "%s", "tp_producer_init: reorder window allocation failed");
+            goto cleanup;
+        }
+        instance->reorder_mask = window - 1;
+        tp_producer_reorder_reset(instance, 0);
+        atomic_init(&instance->reorder_draining, false);
+    }
+
     instance->tracelink_validator = tp_producer_default_tracelink_validator;
     instance->tracelink_validator_clientd = instance;
 
@@ -1555,34 +1702,281 @@ static int tp_prepare_tensor_header(tp_producer_t *producer, const tp_tensor_hea
     return 0;
 }
 
-int tp_producer_publish_frame(
+static bool tp_tensor_header_shape_equal(const tp_tensor_header_t *a, const tp_tensor_header_t *b)
+{
+    size_t i;
+
+    if (a->dtype != b->dtype ||
+        a->major_order != b->major_order ||
+        a->ndims != b->ndims ||
+        a->progress_unit != b->progress_unit ||
+        a->progress_stride_bytes != b->progress_stride_bytes ||
+        a->ndims > TP_MAX_DIMS)
+    {
+        return false;
+    }
+
+    for (i = 0; i < a->ndims; i++)
+    {
+        if (a->dims[i] != b->dims[i] || a->strides[i] != b->strides[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int tp_producer_encode_tensor_image(
+    tp_producer_t *producer,
+    const tp_tensor_header_t *tensor,
+    uint8_t *image,
+    size_t image_len,
+    uint32_t *out_len)
+{
+    tp_tensor_header_t prepared_tensor;
+    uint32_t header_len;
+    uint32_t header_len_le;
+
+    if (tp_prepare_tensor_header(producer, tensor, &prepared_tensor) < 0)
+    {
+        return -1;
+    }
+
+    header_len = (uint32_t)(tensor_pool_messageHeader_encoded_length() + tensor_pool_tensorHeader_sbe_block_length());
+    if (tp_encode_tensor_header(image + sizeof(header_len_le), image_len - sizeof(header_len_le), &prepared_tensor) < 0)
+    {
+        return -1;
+    }
+
+    header_len_le = SBE_LITTLE_ENDIAN_ENCODE_32(header_len);
+    memcpy(image, &header_len_le, sizeof(header_len_le));
+    *out_len = (uint32_t)sizeof(header_len_le) + header_len;
+    return 0;
+}
+
+/*
+ * Returns the length-prefixed TensorHeader image for the tensor, re-validating and re-encoding
+ * only when the shape differs from the previous frame. Concurrent-claim producers encode into
+ * the caller's scratch buffer instead, since the cache is not shared between threads.
+ */
+static const uint8_t *tp_producer_tensor_header_image(
+    tp_producer_t *producer,
+    const tp_tensor_header_t *tensor,
+    uint8_t *scratch,
+    uint32_t *out_len)
+{
+    if (NULL != producer->reorder_entries)
+    {
+        return tp_producer_encode_tensor_image(producer, tensor, scratch, TP_TENSOR_HEADER_IMAGE_BYTES, out_len) < 0
+            ? NULL
+            : scratch;
+    }
+
+    if (producer->has_cached_tensor && tp_tensor_header_shape_equal(tensor, &producer->cached_tensor))
+    {
+        *out_len = producer->cached_tensor_image_len;
+        return producer->cached_tensor_image;
+    }
+
+    producer->has_cached_tensor = false;
+    if (tp_producer_encode_tensor_image(
+        producer,
+        tensor,
+        producer->cached_tensor_image,
+        sizeof(producer->cached_tensor_image),
+        &producer->cached_tensor_image_len) < 0)
+    {
+        return NULL;
+    }
+
+    memcpy(&producer->cached_tensor, tensor, sizeof(producer->cached_tensor));
+    producer->has_cached_tensor = true;
+
+    *out_len = producer->cached_tensor_image_len;
+    return producer->cached_tensor_image;
+}
+
+static void tp_producer_reorder_reset(tp_producer_t *producer, uint64_t next_seq)
+{
+    uint64_t i;
+
+    if (NULL == producer->reorder_entries)
+    {
+        return;
+    }
+
+    for (i = 0; i <= producer->reorder_mask; i++)
+    {
+        atomic_store_explicit(&producer->reorder_entries[i].state, UINT64_MAX, memory_order_relaxed);
+    }
+    atomic_store_explicit(&producer->reorder_next_seq, next_seq, memory_order_release);
+}
+
+static bool tp_producer_reorder_ready(tp_producer_t *producer)
+{
+    uint64_t next = atomic_load_explicit(&producer->reorder_next_seq, memory_order_acquire);
+    uint64_t state = atomic_load_explicit(
+        &producer->reorder_entries[next & producer->reorder_mask].state,
+        memory_order_acquire);
+
+    return state != UINT64_MAX && (state >> 1) == next;
+}
+
+static void tp_producer_reorder_lock(tp_producer_t *producer)
+{
+    while (atomic_exchange_explicit(&producer->reorder_draining, true, memory_order_acquire))
+    {
+        sched_yield();
+    }
+}
+
+/*
+ * Publishes descriptors for every consecutive completed seq at the head of the window. Only
+ * one thread drains at a time; a thread that loses the race leaves its entry to the current
+ * drainer, which re-checks the head after releasing so no completion is stranded. The seq_cst
+ * fences here and in tp_producer_reorder_complete order each side's store before its load, so
+ * either the completer wins the flag or the drainer sees the completed entry.
+ */
+static int tp_producer_reorder_drain(tp_producer_t *producer)
+{
+    int result = 0;
+
+    for (;;)
+    {
+        if (atomic_exchange_explicit(&producer->reorder_draining, true, memory_order_acquire))
+        {
+            return result;
+        }
+
+        while (tp_producer_reorder_ready(producer))
+        {
+            uint64_t next = atomic_load_explicit(&producer->reorder_next_seq, memory_order_relaxed);
+            tp_producer_reorder_entry_t *entry = &producer->reorder_entries[next & producer->reorder_mask];
+            uint64_t state = atomic_load_explicit(&entry->state, memory_order_acquire);
+
+            if ((state & 1u) == 0)
+            {
+                uint64_t descriptor_timestamp_ns = TP_NULL_U64;
+                if (producer->context.publish_descriptor_timestamp)
+                {
+                    descriptor_timestamp_ns = (uint64_t)tp_clock_now_ns();
+                }
+                if (tp_producer_publish_descriptor(
+                    producer, next, descriptor_timestamp_ns, entry->meta_version, entry->trace_id) < 0)
+                {
+                    result = -1;
+                }
+            }
+            atomic_store_explicit(&producer->reorder_next_seq, next + 1, memory_order_release);
+        }
+
+        atomic_store_explicit(&producer->reorder_draining, false, memory_order_release);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!tp_producer_reorder_ready(producer))
+        {
+            return result;
+        }
+    }
+}
+
+static int tp_producer_reorder_complete(
+    tp_producer_t *producer,
+    uint64_t seq,
+    uint32_t meta_version,
+    uint64_t trace_id,
+    bool aborted)
+{
+    tp_producer_reorder_entry_t *entry = &producer->reorder_entries[seq & producer->reorder_mask];
+
+    entry->meta_version = meta_version;
+    entry->trace_id = trace_id;
+    atomic_store_explicit(&entry->state, (seq << 1) | (aborted ? 1u : 0u), memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    return tp_producer_reorder_drain(producer);
+}
+
+static int tp_producer_acquire_seq(tp_producer_t *producer, uint64_t *out_seq)
+{
+    uint64_t limit;
+    uint64_t seq;
+
+    if (NULL == producer->reorder_entries)
+    {
+        *out_seq = atomic_fetch_add_explicit(&producer->next_seq, 1, memory_order_relaxed);
+        return 0;
+    }
+
+    limit = producer->reorder_mask + 1;
+    if (producer->header_nslots < limit)
+    {
+        limit = producer->header_nslots;
+    }
+
+    seq = atomic_load_explicit(&producer->next_seq, memory_order_relaxed);
+    do
+    {
+        if (seq - atomic_load_explicit(&producer->reorder_next_seq, memory_order_acquire) >= limit)
+        {
+            return TP_BACK_PRESSURED;
+        }
+    }
+    while (!atomic_compare_exchange_weak_explicit(
+        &producer->next_seq, &seq, seq + 1, memory_order_acq_rel, memory_order_relaxed));
+
+    *out_seq = seq;
+    return 0;
+}
+
+static int tp_producer_write_frame(
     tp_producer_t *producer,
     uint64_t seq,
     const tp_tensor_header_t *tensor,
-    const void *payload,
+    const tp_iovec_t *iov,
+    size_t iovcnt,
     uint32_t payload_len,
     uint16_t pool_id,
     uint64_t timestamp_ns,
-    uint32_t meta_version,
-    uint64_t trace_id)
+    uint32_t meta_version)
 {
     tp_payload_pool_t *pool;
     uint8_t *slot;
     uint8_t *payload_dst;
     struct tensor_pool_slotHeader slot_header;
-    uint8_t header_bytes[TP_HEADER_SLOT_BYTES];
+    uint8_t header_scratch[TP_TENSOR_HEADER_IMAGE_BYTES];
+    const uint8_t *header_image;
+    uint32_t header_image_len = 0;
     uint32_t header_index;
     uint64_t in_progress;
     uint64_t committed;
     uint64_t slot_timestamp_ns;
-    tp_tensor_header_t prepared_tensor;
+    size_t offset = 0;
+    size_t i;
 
-    if (NULL == producer || NULL == tensor || (NULL == payload && payload_len > 0))
+    if (NULL == tensor || (NULL == iov && iovcnt > 0))
     {
         TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_frame: null input");
         return -1;
     }
 
+    for (i = 0; i < iovcnt; i++)
+    {
+        if (NULL == iov[i].base && iov[i].length > 0)
+        {
+            TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_frame: null input");
+            return -1;
+        }
+        offset += iov[i].length;
+    }
+
+    if (offset != payload_len)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_frame: segment lengths do not match payload length");
+        return -1;
+    }
+    offset = 0;
+
     if (producer->header_nslots == 0 || producer->pool_count == 0 || NULL == producer->header_region.addr)
     {
         TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_frame: producer not attached");
@@ -1604,7 +1998,8 @@ int tp_producer_publish_frame(
         return -1;
     }
 
-    if (tp_prepare_tensor_header(producer, tensor, &prepared_tensor) < 0)
+    header_image = tp_producer_tensor_header_image(producer, tensor, header_scratch, &header_image_len);
+    if (NULL == header_image)
     {
         return -1;
     }
@@ -1624,9 +2019,10 @@ int tp_producer_publish_frame(
     }
 
     tp_atomic_store_u64((uint64_t *)slot, in_progress);
-    if (payload_len > 0)
+    for (i = 0; i < iovcnt; i++)
     {
-        memcpy(payload_dst, payload, payload_len);
+        tp_producer_copy_payload(producer, payload_dst + offset, iov[i].base, iov[i].length);
+        offset += iov[i].length;
     }
 
     tensor_pool_slotHeader_wrap_for_encode(
@@ -1642,19 +2038,7 @@ int tp_producer_publish_frame(
     tensor_pool_slotHeader_set_timestampNs(&slot_header, slot_timestamp_ns);
     tensor_pool_slotHeader_set_metaVersion(&slot_header, meta_version);
     tp_zero_slot_padding(slot);
-
-    if (tp_encode_tensor_header(header_bytes, sizeof(header_bytes), &prepared_tensor) < 0)
-    {
-        return -1;
-    }
-
-    {
-        uint32_t header_len = (uint32_t)(tensor_pool_messageHeader_encoded_length() + tensor_pool_tensorHeader_sbe_block_length());
-        uint32_t header_len_le = SBE_LITTLE_ENDIAN_ENCODE_32(header_len);
-        uint8_t *header_dst = slot + tensor_pool_slotHeader_sbe_block_length();
-        memcpy(header_dst, &header_len_le, sizeof(header_len_le));
-        memcpy(header_dst + sizeof(header_len_le), header_bytes, header_len);
-    }
+    memcpy(slot + tensor_pool_slotHeader_sbe_block_length(), header_image, header_image_len);
 
     if (producer->context.payload_flush && payload_len > 0)
     {
@@ -1666,6 +2050,36 @@ int tp_producer_publish_frame(
 
     atomic_thread_fence(memory_order_release);
     tp_atomic_store_u64((uint64_t *)slot, committed);
+    return 0;
+}
+
+static int tp_producer_publish_framev(
+    tp_producer_t *producer,
+    uint64_t seq,
+    const tp_tensor_header_t *tensor,
+    const tp_iovec_t *iov,
+    size_t iovcnt,
+    uint32_t payload_len,
+    uint16_t pool_id,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id)
+{
+    int result;
+
+    result = tp_producer_write_frame(
+        producer, seq, tensor, iov, iovcnt, payload_len, pool_id, timestamp_ns, meta_version);
+
+    if (NULL != producer->reorder_entries)
+    {
+        int drain_result = tp_producer_reorder_complete(producer, seq, meta_version, trace_id, result < 0);
+        return result < 0 ? -1 : drain_result;
+    }
+
+    if (result < 0)
+    {
+        return -1;
+    }
 
     {
         uint64_t descriptor_timestamp_ns = TP_NULL_U64;
@@ -1677,6 +2091,41 @@ int tp_producer_publish_frame(
     }
 }
 
+int tp_producer_publish_frame(
+    tp_producer_t *producer,
+    uint64_t seq,
+    const tp_tensor_header_t *tensor,
+    const void *payload,
+    uint32_t payload_len,
+    uint16_t pool_id,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id)
+{
+    tp_iovec_t iov;
+
+    if (NULL == producer)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_publish_frame: null input");
+        return -1;
+    }
+
+    iov.base = payload;
+    iov.length = payload_len;
+
+    return tp_producer_publish_framev(
+        producer,
+        seq,
+        tensor,
+        &iov,
+        payload_len > 0 ? 1 : 0,
+        payload_len,
+        pool_id,
+        timestamp_ns,
+        meta_version,
+        trace_id);
+}
+
 int tp_producer_publish_progress_to(
     tp_producer_t *producer,
     tp_publication_t *publication,
@@ -1742,16 +2191,16 @@ int tp_producer_publish_progress(
     {
         tp_consumer_registry_t *registry = &producer->consumer_manager->registry;
         size_t i;
-        for (i = 0; i < registry->capacity; i++)
+        for (i = 0; i < registry->active_count; i++)
         {
-            tp_consumer_entry_t *entry = &registry->entries[i];
-            if (!entry->in_use || NULL == entry->control_publication)
+            tp_consumer_hot_t *hot = &registry->active[i];
+            if (NULL == hot->control_publication)
             {
                 continue;
             }
             if (tp_producer_publish_progress_to(
                 producer,
-                entry->control_publication,
+                hot->control_publication,
                 seq,
                 payload_bytes_filled,
                 state) < 0)
@@ -1785,7 +2234,13 @@ int tp_producer_publish_progress(
     return result;
 }
 
-int64_t tp_producer_offer_frame(tp_producer_t *producer, const tp_frame_t *frame, tp_frame_metadata_t *meta)
+static int64_t tp_producer_offer_iov(
+    tp_producer_t *producer,
+    const tp_frame_t *frame,
+    const tp_iovec_t *iov,
+    size_t iovcnt,
+    uint32_t payload_len,
+    tp_frame_metadata_t *meta)
 {
     uint64_t seq;
     uint64_t timestamp_ns = TP_NULL_U64;
@@ -1794,12 +2249,6 @@ int64_t tp_producer_offer_frame(tp_producer_t *producer, const tp_frame_t *frame
     tp_payload_pool_t *pool;
     int result;
 
-    if (NULL == producer || NULL == frame || NULL == frame->tensor)
-    {
-        TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_frame: null input");
-        return -1;
-    }
-
     if (producer->header_nslots == 0 || producer->pool_count == 0 || NULL == producer->header_region.addr)
     {
         TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_frame: producer not attached");
@@ -1817,21 +2266,26 @@ int64_t tp_producer_offer_frame(tp_producer_t *producer, const tp_frame_t *frame
         return -1;
     }
 
-    pool = tp_find_pool_for_length(producer, frame->payload_len);
+    pool = tp_find_pool_for_length(producer, payload_len);
     if (NULL == pool)
     {
         TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_frame: no pool for payload length");
         return -1;
     }
 
-    seq = producer->next_seq++;
+    result = tp_producer_acquire_seq(producer, &seq);
+    if (result < 0)
+    {
+        return result;
+    }
 
-    result = tp_producer_publish_frame(
+    result = tp_producer_publish_framev(
         producer,
         seq,
         frame->tensor,
-        frame->payload,
-        frame->payload_len,
+        iov,
+        iovcnt,
+        payload_len,
         pool->pool_id,
         timestamp_ns,
         meta_version,
@@ -1844,6 +2298,57 @@ int64_t tp_producer_offer_frame(tp_producer_t *producer, const tp_frame_t *frame
     return (int64_t)seq;
 }
 
+int64_t tp_producer_offer_frame(tp_producer_t *producer, const tp_frame_t *frame, tp_frame_metadata_t *meta)
+{
+    tp_iovec_t iov;
+
+    if (NULL == producer || NULL == frame || NULL == frame->tensor ||
+        (NULL == frame->payload && frame->payload_len > 0))
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_frame: null input");
+        return -1;
+    }
+
+    iov.base = frame->payload;
+    iov.length = frame->payload_len;
+
+    return tp_producer_offer_iov(producer, frame, &iov, frame->payload_len > 0 ? 1 : 0, frame->payload_len, meta);
+}
+
+int64_t tp_producer_offer_framev(
+    tp_producer_t *producer,
+    const tp_frame_t *frame,
+    const tp_iovec_t *iov,
+    size_t iovcnt,
+    tp_frame_metadata_t *meta)
+{
+    uint64_t payload_len = 0;
+    size_t i;
+
+    if (NULL == producer || NULL == frame || NULL == frame->tensor || (NULL == iov && iovcnt > 0))
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_framev: null input");
+        return -1;
+    }
+
+    for (i = 0; i < iovcnt; i++)
+    {
+        if (NULL == iov[i].base && iov[i].length > 0)
+        {
+            TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_framev: null segment");
+            return -1;
+        }
+        payload_len += iov[i].length;
+        if (payload_len > UINT32_MAX)
+        {
+            TP_SET_ERR(EINVAL, "%s", "tp_producer_offer_framev: payload too large");
+            return -1;
+        }
+    }
+
+    return tp_producer_offer_iov(producer, frame, iov, iovcnt, (uint32_t)payload_len, meta);
+}
+
 static tp_payload_pool_t *tp_find_pool_for_length(tp_producer_t *producer, size_t length)
 {
     size_t i;
@@ -1890,7 +2395,10 @@ int64_t tp_producer_try_claim(tp_producer_t *producer, size_t length, tp_buffer_
         return -1;
     }
 
-    seq = producer->next_seq++;
+    if (tp_producer_acquire_seq(producer, &seq) < 0)
+    {
+        return TP_BACK_PRESSURED;
+    }
     header_index = (uint32_t)(seq & (producer->header_nslots - 1));
     slot = tp_slot_at(producer->header_region.addr, header_index);
 
@@ -1927,6 +2435,11 @@ int tp_producer_commit_claim(tp_producer_t *producer, tp_buffer_claim_t *claim,
 
     if (tp_producer_resolve_trace_id(producer, claim->trace_id, &trace_id) < 0)
     {
+        /* Release the seq so later commits still drain; the caller must not abort after this. */
+        if (NULL != producer->reorder_entries)
+        {
+            tp_producer_reorder_complete(producer, claim->seq, TP_NULL_U32, 0, true);
+        }
         return -1;
     }
     claim->trace_id = trace_id;
@@ -1951,6 +2464,11 @@ int tp_producer_abort_claim(tp_producer_t *producer, tp_buffer_claim_t *claim)
         return -1;
     }
 
+    if (NULL != producer->reorder_entries)
+    {
+        return tp_producer_reorder_complete(producer, claim->seq, TP_NULL_U32, 0, true);
+    }
+
     return 0;
 }
 
@@ -1970,7 +2488,10 @@ int64_t tp_producer_queue_claim(tp_producer_t *producer, tp_buffer_claim_t *clai
         return TP_ADMIN_ACTION;
     }
 
-    seq = producer->next_seq++;
+    if (tp_producer_acquire_seq(producer, &seq) < 0)
+    {
+        return TP_BACK_PRESSURED;
+    }
     claim->seq = seq;
     claim->trace_id = 0;
     slot = tp_slot_at(producer->header_region.addr, claim->header_index);
@@ -2026,7 +2547,34 @@ int tp_producer_enable_consumer_manager(tp_producer_t *producer, size_t capacity
     return 0;
 }
 
+static int tp_producer_poll_control_locked(tp_producer_t *producer, int fragment_limit, bool drive_client);
+
+/*
+ * With concurrent claims the control path can remap regions and mutate the consumer registry,
+ * so it holds the reorder drain flag to keep descriptor fan-out from running alongside it.
+ */
 static int tp_producer_poll_control_internal(tp_producer_t *producer, int fragment_limit, bool drive_client)
+{
+    int result;
+
+    if (NULL == producer || NULL == producer->reorder_entries)
+    {
+        return tp_producer_poll_control_locked(producer, fragment_limit, drive_client);
+    }
+
+    tp_producer_reorder_lock(producer);
+    result = tp_producer_poll_control_locked(producer, fragment_limit, drive_client);
+    atomic_store_explicit(&producer->reorder_draining, false, memory_order_release);
+
+    if (tp_producer_reorder_drain(producer) < 0)
+    {
+        return -1;
+    }
+
+    return result;
+}
+
+static int tp_producer_poll_control_locked(tp_producer_t *producer, int fragment_limit, bool drive_client)
 {
     uint64_t now_ns;
     uint64_t stale_ns = 5ULL * 1000 * 1000 * 1000ULL;
@@ -2082,7 +2630,12 @@ static int tp_producer_poll_control_internal(tp_producer_t *producer, int fragme
         if (producer->qos_publication &&
             (producer->last_qos_ns == 0 || now_ns - producer->last_qos_ns >= period))
         {
-            tp_qos_publish_producer(producer, producer->next_seq, TP_NULL_U32);
+            tp_qos_publish_producer(
+                producer,
+                NULL != producer->reorder_entries
+                    ? atomic_load_explicit(&producer->reorder_next_seq, memory_order_acquire)
+                    : atomic_load_explicit(&producer->next_seq, memory_order_relaxed),
+                TP_NULL_U32);
             producer->last_qos_ns = now_ns;
         }
 
@@ -2281,7 +2834,6 @@ tp_publication_t *tp_producer_metadata_publication(tp_producer_t *producer)
 
 int tp_producer_has_consumers(tp_producer_t *producer, bool *out)
 {
-    size_t i;
     tp_consumer_registry_t *registry = NULL;
 
     if (NULL == producer || NULL == out)
@@ -2297,16 +2849,7 @@ int tp_producer_has_consumers(tp_producer_t *producer, bool *out)
     }
 
     registry = &producer->consumer_manager->registry;
-    for (i = 0; i < registry->capacity; i++)
-    {
-        if (registry->entries[i].in_use)
-        {
-            *out = true;
-            return 0;
-        }
-    }
-
-    *out = false;
+    *out = registry->active_count > 0;
     return 0;
 }
 
@@ -2332,6 +2875,12 @@ int tp_producer_close(tp_producer_t *producer)
 
     tp_fragment_assembler_close(&producer->control_assembler);
 
+    tp_copy_pool_close(producer->copy_pool);
+    producer->copy_pool = NULL;
+
+    aeron_free(producer->reorder_entries);
+    producer->reorder_entries = NULL;
+
     if (producer->qos_poller)
     {
         tp_fragment_assembler_close(&producer->qos_poller->assembler);
@@ -2394,3 +2943,28 @@ int tp_producer_close(tp_producer_t *producer)
     aeron_free(producer);
     return 0;
 }
+
+#if defined(TP_ENABLE_FUZZ) || defined(TP_TESTING)
+int tp_producer_encode_tensor_header_for_test(uint8_t *buffer, size_t buffer_len, const tp_tensor_header_t *tensor)
+{
+    return tp_encode_tensor_header(buffer, buffer_len, tensor);
+}
+
+int tp_producer_prepare_tensor_header_for_test(
+    tp_producer_t *producer,
+    const tp_tensor_header_t *tensor,
+    tp_tensor_header_t *out)
+{
+    return tp_prepare_tensor_header(producer, tensor, out);
+}
+
+void tp_producer_zero_slot_padding_for_test(uint8_t *slot)
+{
+    tp_zero_slot_padding(slot);
+}
+
+tp_payload_pool_t *tp_producer_find_pool_for_length_for_test(tp_producer_t *producer, size_t length)
+{
+    return tp_find_pool_for_length(producer, length);
+}
+#endif
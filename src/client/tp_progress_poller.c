@@ -416,9 +416,7 @@ int tp_progress_poll(tp_progress_poller_t *poller, int fragment_limit)
         fragment_limit);
 }
 
-#if defined(TP_ENABLE_FUZZ) || defined(TP_TESTING)
 void tp_progress_poller_handle_fragment(tp_progress_poller_t *poller, const uint8_t *buffer, size_t length)
 {
     tp_progress_poller_handler(poller, buffer, length, NULL);
 }
-#endif
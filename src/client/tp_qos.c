@@ -10,6 +10,7 @@
 #include "wire/tensor_pool/messageHeader.h"
 #include "wire/tensor_pool/mode.h"
 #include "wire/tensor_pool/qosConsumer.h"
+#include "wire/tensor_pool/qosConsumerLatency.h"
 #include "wire/tensor_pool/qosProducer.h"
 
 int tp_qos_publish_producer(tp_producer_t *producer, uint64_t current_seq, uint32_t watermark)
@@ -114,6 +115,72 @@ int tp_qos_publish_consumer(
     return 0;
 }
 
+int tp_qos_publish_consumer_latency(tp_consumer_t *consumer, uint32_t consumer_id)
+{
+    uint8_t buffer[160];
+    struct tensor_pool_messageHeader msg_header;
+    struct tensor_pool_qosConsumerLatency qos;
+    tp_latency_summary_t arrival;
+    tp_latency_summary_t read;
+    const size_t header_len = tensor_pool_messageHeader_encoded_length();
+    const size_t body_len = tensor_pool_qosConsumerLatency_sbe_block_length();
+    int64_t result;
+
+    if (NULL == consumer || NULL == consumer->qos_publication)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_qos_publish_consumer_latency: qos publication unavailable");
+        return -1;
+    }
+
+    if (NULL == consumer->arrival_latency || NULL == consumer->read_latency)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_qos_publish_consumer_latency: latency tracking disabled");
+        return -1;
+    }
+
+    tp_latency_histogram_summarize(consumer->arrival_latency, &arrival);
+    tp_latency_histogram_summarize(consumer->read_latency, &read);
+
+    tensor_pool_messageHeader_wrap(
+        &msg_header,
+        (char *)buffer,
+        0,
+        tensor_pool_messageHeader_sbe_schema_version(),
+        sizeof(buffer));
+    tensor_pool_messageHeader_set_blockLength(&msg_header, (uint16_t)body_len);
+    tensor_pool_messageHeader_set_templateId(&msg_header, tensor_pool_qosConsumerLatency_sbe_template_id());
+    tensor_pool_messageHeader_set_schemaId(&msg_header, tensor_pool_qosConsumerLatency_sbe_schema_id());
+    tensor_pool_messageHeader_set_version(&msg_header, tensor_pool_qosConsumerLatency_sbe_schema_version());
+
+    tensor_pool_qosConsumerLatency_wrap_for_encode(&qos, (char *)buffer, header_len, sizeof(buffer));
+    tensor_pool_qosConsumerLatency_set_streamId(&qos, consumer->stream_id);
+    tensor_pool_qosConsumerLatency_set_consumerId(&qos, consumer_id);
+    tensor_pool_qosConsumerLatency_set_epoch(&qos, consumer->epoch);
+    tensor_pool_qosConsumerLatency_set_arrivalCount(&qos, arrival.count);
+    tensor_pool_qosConsumerLatency_set_arrivalP50Ns(&qos, arrival.p50_ns);
+    tensor_pool_qosConsumerLatency_set_arrivalP90Ns(&qos, arrival.p90_ns);
+    tensor_pool_qosConsumerLatency_set_arrivalP99Ns(&qos, arrival.p99_ns);
+    tensor_pool_qosConsumerLatency_set_arrivalMaxNs(&qos, arrival.max_ns);
+    tensor_pool_qosConsumerLatency_set_readCount(&qos, read.count);
+    tensor_pool_qosConsumerLatency_set_readP50Ns(&qos, read.p50_ns);
+    tensor_pool_qosConsumerLatency_set_readP90Ns(&qos, read.p90_ns);
+    tensor_pool_qosConsumerLatency_set_readP99Ns(&qos, read.p99_ns);
+    tensor_pool_qosConsumerLatency_set_readMaxNs(&qos, read.max_ns);
+
+    result = aeron_publication_offer(
+        tp_publication_handle(consumer->qos_publication),
+        buffer,
+        header_len + body_len,
+        NULL,
+        NULL);
+    if (result < 0)
+    {
+        return (int)result;
+    }
+
+    return 0;
+}
+
 static void tp_qos_poller_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
 {
     tp_qos_poller_t *poller = (tp_qos_poller_t *)clientd;
@@ -189,6 +256,35 @@ static void tp_qos_poller_handler(void *clientd, const uint8_t *buffer, size_t l
             event.mode = TP_MODE_NULL;
         }
     }
+    else if (template_id == tensor_pool_qosConsumerLatency_sbe_template_id())
+    {
+        struct tensor_pool_qosConsumerLatency qos;
+        if (length < tensor_pool_messageHeader_encoded_length() + tensor_pool_qosConsumerLatency_sbe_block_length())
+        {
+            return;
+        }
+        tensor_pool_qosConsumerLatency_wrap_for_decode(
+            &qos,
+            (char *)buffer,
+            tensor_pool_messageHeader_encoded_length(),
+            tensor_pool_qosConsumerLatency_sbe_block_length(),
+            tensor_pool_qosConsumerLatency_sbe_schema_version(),
+            length);
+        event.type = TP_QOS_EVENT_CONSUMER_LATENCY;
+        event.stream_id = tensor_pool_qosConsumerLatency_streamId(&qos);
+        event.consumer_id = tensor_pool_qosConsumerLatency_consumerId(&qos);
+        event.epoch = tensor_pool_qosConsumerLatency_epoch(&qos);
+        event.arrival_latency.count = tensor_pool_qosConsumerLatency_arrivalCount(&qos);
+        event.arrival_latency.p50_ns = tensor_pool_qosConsumerLatency_arrivalP50Ns(&qos);
+        event.arrival_latency.p90_ns = tensor_pool_qosConsumerLatency_arrivalP90Ns(&qos);
+        event.arrival_latency.p99_ns = tensor_pool_qosConsumerLatency_arrivalP99Ns(&qos);
+        event.arrival_latency.max_ns = tensor_pool_qosConsumerLatency_arrivalMaxNs(&qos);
+        event.read_latency.count = tensor_pool_qosConsumerLatency_readCount(&qos);
+        event.read_latency.p50_ns = tensor_pool_qosConsumerLatency_readP50Ns(&qos);
+        event.read_latency.p90_ns = tensor_pool_qosConsumerLatency_readP90Ns(&qos);
+        event.read_latency.p99_ns = tensor_pool_qosConsumerLatency_readP99Ns(&qos);
+        event.read_latency.max_ns = tensor_pool_qosConsumerLatency_readMaxNs(&qos);
+    }
     else
     {
         return;
@@ -0,0 +1,219 @@
+#include "tensor_pool/tp_copy.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TP_COPY_X86 1
+#include <immintrin.h>
+#endif
+
+static void tp_copy_plain(void *dst, const void *src, size_t length)
+{
+    memcpy(dst, src, length);
+}
+
+#ifdef TP_COPY_X86
+/*
+ * Each engine copies an unaligned head with memcpy so the streaming stores hit aligned
+ * destinations, streams whole blocks, then copies the tail. Short copies go straight to memcpy.
+ */
+__attribute__((target("sse2")))
+static void tp_copy_nt_sse2(void *dst, const void *src, size_t length)
+{
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    size_t head = (16u - ((uintptr_t)d & 15u)) & 15u;
+
+    if (length < head + 64u)
+    {
+        memcpy(dst, src, length);
+        return;
+    }
+
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    length -= head;
+
+    while (length >= 64u)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + 0));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(s + 32));
+        __m128i e = _mm_loadu_si128((const __m128i *)(s + 48));
+        _mm_stream_si128((__m128i *)(d + 0), a);
+        _mm_stream_si128((__m128i *)(d + 16), b);
+        _mm_stream_si128((__m128i *)(d + 32), c);
+        _mm_stream_si128((__m128i *)(d + 48), e);
+        d += 64u;
+        s += 64u;
+        length -= 64u;
+    }
+
+    memcpy(d, s, length);
+    _mm_sfence();
+}
+
+__attribute__((target("avx2")))
+static void tp_copy_nt_avx2(void *dst, const void *src, size_t length)
+{
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    size_t head = (32u - ((uintptr_t)d & 31u)) & 31u;
+
+    if (length < head + 128u)
+    {
+        memcpy(dst, src, length);
+        return;
+    }
+
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    length -= head;
+
+    while (length >= 128u)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(s + 0));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(s + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(s + 64));
+        __m256i e = _mm256_loadu_si256((const __m256i *)(s + 96));
+        _mm256_stream_si256((__m256i *)(d + 0), a);
+        _mm256_stream_si256((__m256i *)(d + 32), b);
+        _mm256_stream_si256((__m256i *)(d + 64), c);
+        _mm256_stream_si256((__m256i *)(d + 96), e);
+        d += 128u;
+        s += 128u;
+        length -= 128u;
+    }
+
+    memcpy(d, s, length);
+    _mm_sfence();
+}
+
+__attribute__((target("avx512f")))
+static void tp_copy_nt_avx512(void *dst, const void *src, size_t length)
+{
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    size_t head = (64u - ((uintptr_t)d & 63u)) & 63u;
+
+    if (length < head + 256u)
+    {
+        memcpy(dst, src, length);
+        return;
+    }
+
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    length -= head;
+
+    while (length >= 256u)
+    {
+        __m512i a = _mm512_loadu_si512((const void *)(s + 0));
+        __m512i b = _mm512_loadu_si512((const void *)(s + 64));
+        __m512i c = _mm512_loadu_si512((const void *)(s + 128));
+        __m512i e = _mm512_loadu_si512((const void *)(s + 192));
+        _mm512_stream_si512((void *)(d + 0), a);
+        _mm512_stream_si512((void *)(d + 64), b);
+        _mm512_stream_si512((void *)(d + 128), c);
+        _mm512_stream_si512((void *)(d + 192), e);
+        d += 256u;
+        s += 256u;
+        length -= 256u;
+    }
+
+    memcpy(d, s, length);
+    _mm_sfence();
+}
+
+static bool tp_copy_engine_supported(tp_copy_engine_t engine)
+{
+    __builtin_cpu_init();
+
+    switch (engine)
+    {
+        case TP_COPY_ENGINE_SSE2:
+            return __builtin_cpu_supports("sse2") ? true : false;
+        case TP_COPY_ENGINE_AVX2:
+            return __builtin_cpu_supports("avx2") ? true : false;
+        case TP_COPY_ENGINE_AVX512:
+            return __builtin_cpu_supports("avx512f") ? true : false;
+        default:
+            return false;
+    }
+}
+#else
+static bool tp_copy_engine_supported(tp_copy_engine_t engine)
+{
+    (void)engine;
+    return false;
+}
+#endif
+
+tp_copy_engine_t tp_copy_engine_resolve(tp_copy_engine_t engine)
+{
+    int candidate;
+
+    if (engine == TP_COPY_ENGINE_MEMCPY)
+    {
+        return TP_COPY_ENGINE_MEMCPY;
+    }
+
+    candidate = (engine == TP_COPY_ENGINE_AUTO || engine > TP_COPY_ENGINE_AVX512)
+        ? (int)TP_COPY_ENGINE_AVX512
+        : (int)engine;
+
+    for (; candidate >= (int)TP_COPY_ENGINE_SSE2; candidate--)
+    {
+        if (tp_copy_engine_supported((tp_copy_engine_t)candidate))
+        {
+            return (tp_copy_engine_t)candidate;
+        }
+    }
+
+    return TP_COPY_ENGINE_MEMCPY;
+}
+
+tp_copy_fn_t tp_copy_engine_fn(tp_copy_engine_t engine)
+{
+#ifdef TP_COPY_X86
+    switch (tp_copy_engine_resolve(engine))
+    {
+        case TP_COPY_ENGINE_SSE2:
+            return tp_copy_nt_sse2;
+        case TP_COPY_ENGINE_AVX2:
+            return tp_copy_nt_avx2;
+        case TP_COPY_ENGINE_AVX512:
+            return tp_copy_nt_avx512;
+        default:
+            break;
+    }
+#else
+    (void)engine;
+#endif
+
+    return tp_copy_plain;
+}
+
+const char *tp_copy_engine_name(tp_copy_engine_t engine)
+{
+    switch (engine)
+    {
+        case TP_COPY_ENGINE_MEMCPY:
+            return "memcpy";
+        case TP_COPY_ENGINE_AUTO:
+            return "auto";
+        case TP_COPY_ENGINE_SSE2:
+            return "sse2-nt";
+        case TP_COPY_ENGINE_AVX2:
+            return "avx2-nt";
+        case TP_COPY_ENGINE_AVX512:
+            return "avx512-nt";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,242 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tp_copy_pool.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tensor_pool/tp_error.h"
+
+/*
+ * The stripe cursor packs the job generation into the upper 32 bits so a helper that wakes
+ * late for an already finished job can never claim a stripe of the next one.
+ */
+typedef struct tp_copy_pool_job_stct
+{
+    uint8_t *dst;
+    const uint8_t *src;
+    size_t length;
+    uint32_t stripe_count;
+    uint32_t generation;
+}
+tp_copy_pool_job_t;
+
+struct tp_copy_pool_stct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t *threads;
+    uint32_t helper_count;
+    uint32_t started;
+    size_t stripe_bytes;
+    tp_copy_fn_t copy;
+    tp_copy_pool_job_t job;
+    bool stop;
+    _Atomic bool busy;
+    _Alignas(64) _Atomic uint64_t cursor;
+    _Alignas(64) _Atomic uint32_t done;
+};
+
+static void tp_copy_pool_run_stripes(tp_copy_pool_t *pool, const tp_copy_pool_job_t *job)
+{
+    uint64_t expected = atomic_load_explicit(&pool->cursor, memory_order_relaxed);
+    uint32_t copied = 0;
+
+    for (;;)
+    {
+        uint32_t index;
+        size_t offset;
+        size_t length;
+
+        if ((uint32_t)(expected >> 32) != job->generation)
+        {
+            break;
+        }
+
+        index = (uint32_t)expected;
+        if (index >= job->stripe_count)
+        {
+            break;
+        }
+
+        if (!atomic_compare_exchange_weak_explicit(
+            &pool->cursor, &expected, expected + 1, memory_order_acq_rel, memory_order_relaxed))
+        {
+            continue;
+        }
+
+        offset = (size_t)index * pool->stripe_bytes;
+        length = job->length - offset < pool->stripe_bytes ? job->length - offset : pool->stripe_bytes;
+        pool->copy(job->dst + offset, job->src + offset, length);
+        copied++;
+        expected = atomic_load_explicit(&pool->cursor, memory_order_relaxed);
+    }
+
+    if (copied > 0)
+    {
+        atomic_fetch_add_explicit(&pool->done, copied, memory_order_release);
+    }
+}
+
+static void *tp_copy_pool_helper(void *arg)
+{
+    tp_copy_pool_t *pool = (tp_copy_pool_t *)arg;
+    uint32_t seen = 0;
+
+    for (;;)
+    {
+        tp_copy_pool_job_t job;
+
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->job.generation == seen)
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        job = pool->job;
+        seen = job.generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        tp_copy_pool_run_stripes(pool, &job);
+    }
+
+    return NULL;
+}
+
+int tp_copy_pool_init(tp_copy_pool_t **pool, uint32_t helper_threads, size_t stripe_bytes, tp_copy_fn_t copy)
+{
+    tp_copy_pool_t *instance;
+    uint32_t i;
+
+    if (NULL == pool || helper_threads == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_copy_pool_init: invalid input");
+        return -1;
+    }
+
+    *pool = NULL;
+    instance = (tp_copy_pool_t *)calloc(1, sizeof(*instance));
+    if (NULL == instance)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_copy_pool_init: allocation failed");
+        return -1;
+    }
+
+    instance->threads = (pthread_t *)calloc(helper_threads, sizeof(pthread_t));
+    if (NULL == instance->threads)
+    {
+        free(instance);
+        TP_SET_ERR(ENOMEM, "%s", "tp_copy_pool_init: allocation failed");
+        return -1;
+    }
+
+    stripe_bytes = stripe_bytes == 0 ? TP_COPY_POOL_STRIPE_BYTES_DEFAULT : stripe_bytes;
+    instance->stripe_bytes = (stripe_bytes + 63u) & ~(size_t)63u;
+    instance->copy = NULL != copy ? copy : tp_copy_engine_fn(TP_COPY_ENGINE_MEMCPY);
+    instance->helper_count = helper_threads;
+    atomic_init(&instance->cursor, 0);
+    atomic_init(&instance->done, 0);
+    atomic_init(&instance->busy, false);
+    pthread_mutex_init(&instance->lock, NULL);
+    pthread_cond_init(&instance->wake, NULL);
+
+    for (i = 0; i < helper_threads; i++)
+    {
+        int err = pthread_create(&instance->threads[i], NULL, tp_copy_pool_helper, instance);
+        if (err != 0)
+        {
+            tp_copy_pool_close(instance);
+            TP_SET_ERR(err, "%s", "tp_copy_pool_init: pthread_create failed");
+            return -1;
+        }
+        instance->started++;
+    }
+
+    *pool = instance;
+    return 0;
+}
+
+void tp_copy_pool_close(tp_copy_pool_t *pool)
+{
+    uint32_t i;
+
+    if (NULL == pool)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->started; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+void tp_copy_pool_copy(tp_copy_pool_t *pool, void *dst, const void *src, size_t length)
+{
+    tp_copy_pool_job_t job;
+    uint64_t stripes;
+
+    if (NULL == pool || length == 0)
+    {
+        return;
+    }
+
+    stripes = (length + pool->stripe_bytes - 1) / pool->stripe_bytes;
+    if (stripes < 2 || stripes > UINT32_MAX ||
+        atomic_exchange_explicit(&pool->busy, true, memory_order_acquire))
+    {
+        pool->copy(dst, src, length);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->job.dst = (uint8_t *)dst;
+    pool->job.src = (const uint8_t *)src;
+    pool->job.length = length;
+    pool->job.stripe_count = (uint32_t)stripes;
+    pool->job.generation++;
+    if (pool->job.generation == 0)
+    {
+        pool->job.generation = 1;
+    }
+    atomic_store_explicit(&pool->done, 0, memory_order_relaxed);
+    atomic_store_explicit(&pool->cursor, (uint64_t)pool->job.generation << 32, memory_order_release);
+    job = pool->job;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    tp_copy_pool_run_stripes(pool, &job);
+
+    while (atomic_load_explicit(&pool->done, memory_order_acquire) < job.stripe_count)
+    {
+        sched_yield();
+    }
+
+    atomic_store_explicit(&pool->busy, false, memory_order_release);
+}
+
+uint32_t tp_copy_pool_helper_count(const tp_copy_pool_t *pool)
+{
+    return NULL == pool ? 0 : pool->helper_count;
+}
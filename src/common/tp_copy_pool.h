@@ -0,0 +1,24 @@
+#ifndef TENSOR_POOL_TP_COPY_POOL_H
+#define TENSOR_POOL_TP_COPY_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensor_pool/tp_copy.h"
+
+#define TP_COPY_POOL_STRIPE_BYTES_DEFAULT (1024u * 1024u)
+
+typedef struct tp_copy_pool_stct tp_copy_pool_t;
+
+/*
+ * Helper threads that split one large copy into fixed-size stripes. The calling thread takes
+ * stripes as well, and tp_copy_pool_copy returns only after every stripe has been written,
+ * so callers can publish the destination straight after it returns. A caller that finds the
+ * pool already running another copy does its copy alone rather than waiting.
+ */
+int tp_copy_pool_init(tp_copy_pool_t **pool, uint32_t helper_threads, size_t stripe_bytes, tp_copy_fn_t copy);
+void tp_copy_pool_close(tp_copy_pool_t *pool);
+void tp_copy_pool_copy(tp_copy_pool_t *pool, void *dst, const void *src, size_t length);
+uint32_t tp_copy_pool_helper_count(const tp_copy_pool_t *pool);
+
+#endif
@@ -0,0 +1,138 @@
+#include "tensor_pool/tp_latency.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "tensor_pool/tp_error.h"
+
+static uint32_t tp_latency_msb(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (uint32_t)__builtin_clzll(value);
+#else
+    uint32_t msb = 0;
+
+    while (value >>= 1u)
+    {
+        msb++;
+    }
+    return msb;
+#endif
+}
+
+static uint32_t tp_latency_bucket_index(uint64_t value_ns)
+{
+    uint32_t msb;
+
+    if (value_ns < TP_LATENCY_SUB_BUCKETS)
+    {
+        return (uint32_t)value_ns;
+    }
+    if (value_ns >= (UINT64_C(1) << TP_LATENCY_MAX_BITS))
+    {
+        return TP_LATENCY_BUCKETS - 1;
+    }
+
+    msb = tp_latency_msb(value_ns);
+    return ((msb - TP_LATENCY_SUB_BUCKET_BITS + 1u) << TP_LATENCY_SUB_BUCKET_BITS) +
+        (uint32_t)((value_ns >> (msb - TP_LATENCY_SUB_BUCKET_BITS)) - TP_LATENCY_SUB_BUCKETS);
+}
+
+static uint64_t tp_latency_bucket_upper(uint32_t index)
+{
+    uint32_t shift;
+    uint64_t sub;
+
+    if (index < TP_LATENCY_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    shift = (index >> TP_LATENCY_SUB_BUCKET_BITS) - 1u;
+    sub = TP_LATENCY_SUB_BUCKETS + (index & (TP_LATENCY_SUB_BUCKETS - 1u));
+    return ((sub + 1u) << shift) - 1u;
+}
+
+void tp_latency_histogram_reset(tp_latency_histogram_t *histogram)
+{
+    if (NULL == histogram)
+    {
+        return;
+    }
+
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+void tp_latency_histogram_record(tp_latency_histogram_t *histogram, uint64_t value_ns)
+{
+    if (NULL == histogram)
+    {
+        return;
+    }
+
+    histogram->counts[tp_latency_bucket_index(value_ns)]++;
+    if (histogram->count == 0 || value_ns < histogram->min_ns)
+    {
+        histogram->min_ns = value_ns;
+    }
+    if (value_ns > histogram->max_ns)
+    {
+        histogram->max_ns = value_ns;
+    }
+    histogram->count++;
+}
+
+uint64_t tp_latency_histogram_percentile(const tp_latency_histogram_t *histogram, double percentile)
+{
+    uint64_t rank;
+    uint64_t seen = 0;
+    uint32_t i;
+
+    if (NULL == histogram || histogram->count == 0)
+    {
+        return 0;
+    }
+
+    if (percentile <= 0.0)
+    {
+        return histogram->min_ns;
+    }
+    if (percentile >= 100.0)
+    {
+        return histogram->max_ns;
+    }
+
+    rank = (uint64_t)((percentile / 100.0) * (double)histogram->count + 0.5);
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    for (i = 0; i < TP_LATENCY_BUCKETS; i++)
+    {
+        seen += histogram->counts[i];
+        if (seen >= rank)
+        {
+            uint64_t upper = tp_latency_bucket_upper(i);
+            return upper < histogram->max_ns ? upper : histogram->max_ns;
+        }
+    }
+
+    return histogram->max_ns;
+}
+
+int tp_latency_histogram_summarize(const tp_latency_histogram_t *histogram, tp_latency_summary_t *summary)
+{
+    if (NULL == histogram || NULL == summary)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_latency_histogram_summarize: null input");
+        return -1;
+    }
+
+    summary->count = histogram->count;
+    summary->p50_ns = tp_latency_histogram_percentile(histogram, 50.0);
+    summary->p90_ns = tp_latency_histogram_percentile(histogram, 90.0);
+    summary->p99_ns = tp_latency_histogram_percentile(histogram, 99.0);
+    summary->max_ns = histogram->max_ns;
+    return 0;
+}
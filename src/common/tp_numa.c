@@ -0,0 +1,212 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "tensor_pool/tp_numa.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#include "tensor_pool/tp_error.h"
+
+/* Kernel ABI values from linux/mempolicy.h, which libc does not install. */
+#define TP_MPOL_DEFAULT 0
+#define TP_MPOL_PREFERRED 1
+#define TP_MPOL_BIND 2
+#define TP_MPOL_INTERLEAVE 3
+#define TP_MPOL_F_NODE (1 << 0)
+#define TP_MPOL_F_ADDR (1 << 1)
+#define TP_MPOL_F_MEMS_ALLOWED (1 << 2)
+
+int tp_numa_parse_mode(const char *name, tp_numa_mode_t *out)
+{
+    if (NULL == name || NULL == out)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_numa_parse_mode: null input");
+        return -1;
+    }
+
+    if (0 == strcmp(name, "default"))
+    {
+        *out = TP_NUMA_DEFAULT;
+    }
+    else if (0 == strcmp(name, "preferred"))
+    {
+        *out = TP_NUMA_PREFERRED;
+    }
+    else if (0 == strcmp(name, "bind"))
+    {
+        *out = TP_NUMA_BIND;
+    }
+    else if (0 == strcmp(name, "interleave"))
+    {
+        *out = TP_NUMA_INTERLEAVE;
+    }
+    else
+    {
+        TP_SET_ERR(EINVAL, "tp_numa_parse_mode: unknown mode %s", name);
+        return -1;
+    }
+
+    return 0;
+}
+
+const char *tp_numa_mode_name(tp_numa_mode_t mode)
+{
+    switch (mode)
+    {
+        case TP_NUMA_PREFERRED:
+            return "preferred";
+        case TP_NUMA_BIND:
+            return "bind";
+        case TP_NUMA_INTERLEAVE:
+            return "interleave";
+        case TP_NUMA_DEFAULT:
+        default:
+            return "default";
+    }
+}
+
+int tp_numa_node_count(void)
+{
+    int count = 0;
+#if defined(__linux__)
+    DIR *dir = opendir("/sys/devices/system/node");
+    struct dirent *entry;
+
+    if (NULL == dir)
+    {
+        return 1;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (0 == strncmp(entry->d_name, "node", 4) && isdigit((unsigned char)entry->d_name[4]))
+        {
+            count++;
+        }
+    }
+    closedir(dir);
+#endif
+
+    return count > 0 ? count : 1;
+}
+
+int tp_numa_apply(void *addr, size_t length, const tp_numa_policy_t *policy)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long mask = 0;
+    unsigned long maxnode = 0;
+    int mode;
+    int i;
+
+    if (NULL == addr || NULL == policy)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_numa_apply: null input");
+        return -1;
+    }
+
+    switch (policy->mode)
+    {
+        case TP_NUMA_DEFAULT:
+            return 0;
+        case TP_NUMA_PREFERRED:
+            mode = TP_MPOL_PREFERRED;
+            for (i = 0; i < TP_NUMA_MAX_NODES; i++)
+            {
+                if (policy->nodes & (1ULL << i))
+                {
+                    mask = 1UL << i;
+                    break;
+                }
+            }
+            break;
+        case TP_NUMA_BIND:
+            mode = TP_MPOL_BIND;
+            mask = (unsigned long)policy->nodes;
+            break;
+        case TP_NUMA_INTERLEAVE:
+            mode = TP_MPOL_INTERLEAVE;
+            mask = (unsigned long)policy->nodes;
+            if (mask == 0 && syscall(SYS_get_mempolicy, NULL, &mask, (unsigned long)TP_NUMA_MAX_NODES + 1,
+                NULL, TP_MPOL_F_MEMS_ALLOWED) != 0)
+            {
+                TP_SET_ERR(errno, "%s", "tp_numa_apply: get_mempolicy failed");
+                return -1;
+            }
+            break;
+        default:
+            TP_SET_ERR(EINVAL, "%s", "tp_numa_apply: unknown mode");
+            return -1;
+    }
+
+    if (mask == 0)
+    {
+        TP_SET_ERR(EINVAL, "tp_numa_apply: %s needs at least one node", tp_numa_mode_name(policy->mode));
+        return -1;
+    }
+    maxnode = (unsigned long)TP_NUMA_MAX_NODES + 1;
+
+    if (syscall(SYS_mbind, addr, (unsigned long)length, mode, &mask, maxnode, 0) != 0)
+    {
+        TP_SET_ERR(errno, "tp_numa_apply: mbind %s failed", tp_numa_mode_name(policy->mode));
+        return -1;
+    }
+
+    return 0;
+#else
+    (void)length;
+    if (NULL == addr || NULL == policy)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_numa_apply: null input");
+        return -1;
+    }
+    if (policy->mode == TP_NUMA_DEFAULT)
+    {
+        return 0;
+    }
+    TP_SET_ERR(ENOSYS, "%s", "tp_numa_apply: NUMA policy not supported on this platform");
+    return -1;
+#endif
+}
+
+int tp_numa_node_of(const void *addr, int *node)
+{
+    if (NULL == addr || NULL == node)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_numa_node_of: null input");
+        return -1;
+    }
+
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    {
+        int value = 0;
+
+        if (syscall(SYS_get_mempolicy, &value, NULL, 0UL, addr, TP_MPOL_F_NODE | TP_MPOL_F_ADDR) != 0)
+        {
+            if (errno == ENOSYS)
+            {
+                *node = 0;
+                return 0;
+            }
+            TP_SET_ERR(errno, "%s", "tp_numa_node_of: get_mempolicy failed");
+            return -1;
+        }
+        *node = value;
+    }
+#else
+    *node = 0;
+#endif
+
+    return 0;
+}
@@ -1,12 +1,16 @@
 #ifndef _POSIX_C_SOURCE
 #define _POSIX_C_SOURCE 200809L
 #endif
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
 
 #include "tensor_pool/tp_shm.h"
 
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -15,6 +19,8 @@ extern char *realpath(const char *path, char *resolved_path);
 #endif
 #include <sys/mman.h>
 #include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -340,32 +346,18 @@ static int tp_shm_validate_permissions(const struct stat *st, const tp_allowed_p
     return 0;
 }
 
-int tp_shm_map(tp_shm_region_t *region, const char *uri, int writable, const tp_allowed_paths_t *allowed, tp_log_t *log)
+/* Opens, checks and maps region->uri.path; region->uri must already be parsed. */
+static int tp_shm_map_path(
+    tp_shm_region_t *region,
+    int writable,
+    const tp_allowed_paths_t *allowed,
+    tp_log_t *log,
+    struct stat *out_st)
 {
     struct stat st;
     int flags = writable ? O_RDWR : O_RDONLY;
     int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
 
-    if (NULL == region)
-    {
-        TP_SET_ERR(EINVAL, "%s", "tp_shm_map: region is null");
-        return -1;
-    }
-
-    if (NULL == allowed || allowed->canonical_length == 0)
-    {
-        TP_SET_ERR(EINVAL, "%s", "tp_shm_map: allowed paths not configured");
-        return -1;
-    }
-
-    memset(region, 0, sizeof(*region));
-    region->fd = -1;
-
-    if (tp_shm_uri_parse(&region->uri, uri, log) < 0)
-    {
-        return -1;
-    }
-
     if (tp_shm_open_canonical(region->uri.path, allowed, flags, &region->fd) < 0)
     {
         return -1;
@@ -428,11 +420,300 @@ int tp_shm_map(tp_shm_region_t *region, const char *uri, int writable, const tp_
         return -1;
     }
 
+    /* Advisory: the pages stay usable when the kernel cannot back them with hugepages. */
+    if (region->uri.transparent_hugepages)
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (madvise(region->addr, region->length, MADV_HUGEPAGE) < 0)
+        {
+            tp_log_emit(log, TP_LOG_WARN, "tp_shm_map: madvise hugepage failed for %s: %s",
+                region->uri.path, strerror(errno));
+        }
+#else
+        tp_log_emit(log, TP_LOG_WARN, "tp_shm_map: transparent hugepages unsupported for %s", region->uri.path);
+#endif
+    }
+
     if (NULL != log)
     {
         tp_log_emit(log, TP_LOG_DEBUG, "Mapped SHM %s length=%zu", region->uri.path, region->length);
     }
 
+    if (NULL != out_st)
+    {
+        *out_st = st;
+    }
+
+    return 0;
+}
+
+int tp_shm_map(tp_shm_region_t *region, const char *uri, int writable, const tp_allowed_paths_t *allowed, tp_log_t *log)
+{
+    if (NULL == region)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_map: region is null");
+        return -1;
+    }
+
+    if (NULL == allowed || allowed->canonical_length == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_map: allowed paths not configured");
+        return -1;
+    }
+
+    memset(region, 0, sizeof(*region));
+    region->fd = -1;
+
+    if (tp_shm_uri_parse(&region->uri, uri, log) < 0)
+    {
+        return -1;
+    }
+
+    return tp_shm_map_path(region, writable, allowed, log, NULL);
+}
+
+/*
+ * Process-wide cache of read-only mappings, keyed by canonical path and epoch. Entries are
+ * unmapped when the last region sharing them is unmapped; mapping a newer epoch of the same
+ * path, or finding the file replaced underneath, takes the old entry out of the lookup list so
+ * later maps get a fresh mapping while current holders keep theirs.
+ */
+struct tp_shm_shared_stct
+{
+    char path[4096];
+    uint64_t epoch;
+    int fd;
+    void *addr;
+    size_t length;
+    dev_t dev;
+    ino_t ino;
+    struct stat st;
+    uint32_t refs;
+    bool listed;
+    bool hugepages_checked;
+    struct tp_shm_shared_stct *next;
+};
+
+static pthread_mutex_t tp_shm_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static tp_shm_shared_t *tp_shm_cache_head = NULL;
+static size_t tp_shm_cache_entries = 0;
+static uint64_t tp_shm_cache_hits = 0;
+static uint64_t tp_shm_cache_misses = 0;
+
+static void tp_shm_cache_delist(tp_shm_shared_t *entry)
+{
+    tp_shm_shared_t **link = &tp_shm_cache_head;
+
+    while (NULL != *link)
+    {
+        if (*link == entry)
+        {
+            *link = entry->next;
+            entry->next = NULL;
+            entry->listed = false;
+            tp_shm_cache_entries--;
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+static void tp_shm_cache_destroy(tp_shm_shared_t *entry, tp_log_t *log)
+{
+    if (NULL != entry->addr && 0 != entry->length)
+    {
+        munmap(entry->addr, entry->length);
+    }
+    if (entry->fd >= 0)
+    {
+        close(entry->fd);
+    }
+    if (NULL != log)
+    {
+        tp_log_emit(log, TP_LOG_DEBUG, "Unmapped shared SHM %s epoch=%" PRIu64, entry->path, entry->epoch);
+    }
+    free(entry);
+}
+
+/* Looks up path at epoch, dropping entries for older epochs or a replaced file. */
+static tp_shm_shared_t *tp_shm_cache_find(const char *path, uint64_t epoch, const struct stat *st_path)
+{
+    tp_shm_shared_t *entry = tp_shm_cache_head;
+    tp_shm_shared_t *found = NULL;
+
+    while (NULL != entry)
+    {
+        tp_shm_shared_t *next = entry->next;
+
+        if (strcmp(entry->path, path) == 0)
+        {
+            if (entry->epoch == epoch &&
+                entry->dev == st_path->st_dev &&
+                entry->ino == st_path->st_ino &&
+                entry->length == (size_t)st_path->st_size)
+            {
+                found = entry;
+            }
+            else if (entry->epoch <= epoch)
+            {
+                /* Listed entries always have holders; the last release destroys it. */
+                tp_shm_cache_delist(entry);
+            }
+        }
+        entry = next;
+    }
+
+    return found;
+}
+
+int tp_shm_map_shared(
+    tp_shm_region_t *region,
+    const char *uri,
+    uint64_t epoch,
+    const tp_allowed_paths_t *allowed,
+    tp_log_t *log)
+{
+    char resolved_path[4096];
+    struct stat st_path;
+    tp_shm_shared_t *entry;
+    int result = -1;
+
+    if (NULL == region)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_map_shared: region is null");
+        return -1;
+    }
+
+    if (NULL == allowed || allowed->canonical_length == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_map_shared: allowed paths not configured");
+        return -1;
+    }
+
+    memset(region, 0, sizeof(*region));
+    region->fd = -1;
+
+    if (tp_shm_uri_parse(&region->uri, uri, log) < 0)
+    {
+        return -1;
+    }
+
+    if (NULL == realpath(region->uri.path, resolved_path))
+    {
+        TP_SET_ERR(errno, "tp_shm_map: realpath failed for %s", region->uri.path);
+        return -1;
+    }
+
+    /* Every caller is checked against its own allowlist, even when the mapping is shared. */
+    if (tp_shm_validate_path(resolved_path, allowed) < 0)
+    {
+        return -1;
+    }
+
+    if (stat(resolved_path, &st_path) < 0)
+    {
+        TP_SET_ERR(errno, "tp_shm_map: stat failed for %s", resolved_path);
+        return -1;
+    }
+
+    pthread_mutex_lock(&tp_shm_cache_lock);
+
+    entry = tp_shm_cache_find(resolved_path, epoch, &st_path);
+    if (NULL != entry)
+    {
+        if (tp_shm_validate_permissions(&entry->st, allowed, region->uri.path) < 0)
+        {
+            goto unlock;
+        }
+        if (region->uri.require_hugepages && !entry->hugepages_checked)
+        {
+            if (tp_shm_check_hugepages(entry->fd, region->uri.path) < 0)
+            {
+                goto unlock;
+            }
+            entry->hugepages_checked = true;
+        }
+        tp_shm_cache_hits++;
+    }
+    else
+    {
+        struct stat st;
+
+        entry = (tp_shm_shared_t *)calloc(1, sizeof(*entry));
+        if (NULL == entry)
+        {
+            TP_SET_ERR(ENOMEM, "%s", "tp_shm_map_shared: allocation failed");
+            goto unlock;
+        }
+
+        if (tp_shm_map_path(region, 0, allowed, log, &st) < 0)
+        {
+            free(entry);
+            goto unlock;
+        }
+
+        strncpy(entry->path, resolved_path, sizeof(entry->path) - 1);
+        entry->epoch = epoch;
+        entry->fd = region->fd;
+        entry->addr = region->addr;
+        entry->length = region->length;
+        entry->dev = st.st_dev;
+        entry->ino = st.st_ino;
+        entry->st = st;
+        entry->hugepages_checked = region->uri.require_hugepages != 0;
+        entry->listed = true;
+        entry->next = tp_shm_cache_head;
+        tp_shm_cache_head = entry;
+        tp_shm_cache_entries++;
+        tp_shm_cache_misses++;
+    }
+
+    entry->refs++;
+    region->fd = entry->fd;
+    region->addr = entry->addr;
+    region->length = entry->length;
+    region->shared = entry;
+    result = 0;
+
+unlock:
+    pthread_mutex_unlock(&tp_shm_cache_lock);
+    return result;
+}
+
+static void tp_shm_cache_release(tp_shm_shared_t *entry, tp_log_t *log)
+{
+    pthread_mutex_lock(&tp_shm_cache_lock);
+    if (entry->refs > 0)
+    {
+        entry->refs--;
+    }
+    if (entry->refs == 0)
+    {
+        if (entry->listed)
+        {
+            tp_shm_cache_delist(entry);
+        }
+        tp_shm_cache_destroy(entry, log);
+    }
+    pthread_mutex_unlock(&tp_shm_cache_lock);
+}
+
+int tp_shm_cache_get_stats(size_t *entries, uint64_t *hits, uint64_t *misses)
+{
+    pthread_mutex_lock(&tp_shm_cache_lock);
+    if (entries)
+    {
+        *entries = tp_shm_cache_entries;
+    }
+    if (hits)
+    {
+        *hits = tp_shm_cache_hits;
+    }
+    if (misses)
+    {
+        *misses = tp_shm_cache_misses;
+    }
+    pthread_mutex_unlock(&tp_shm_cache_lock);
     return 0;
 }
 
@@ -444,6 +725,14 @@ int tp_shm_unmap(tp_shm_region_t *region, tp_log_t *log)
         return -1;
     }
 
+    if (NULL != region->shared)
+    {
+        tp_shm_cache_release(region->shared, log);
+        memset(region, 0, sizeof(*region));
+        region->fd = -1;
+        return 0;
+    }
+
     if (NULL != region->addr && 0 != region->length)
     {
         if (munmap(region->addr, region->length) < 0)
@@ -743,6 +1032,14 @@ int tp_shm_validate_stride_alignment(const char *uri, uint32_t stride_bytes, tp_
                 return -1;
             }
         }
+        if (parsed.transparent_hugepages)
+        {
+            if ((uint64_t)st.f_type != (uint64_t)TMPFS_MAGIC)
+            {
+                TP_SET_ERR(EINVAL, "tp_shm_validate_stride_alignment: not tmpfs: %s", parsed.path);
+                return -1;
+            }
+        }
     }
 #else
     if (parsed.require_hugepages)
@@ -754,3 +1051,217 @@ int tp_shm_validate_stride_alignment(const char *uri, uint32_t stride_bytes, tp_
 
     return 0;
 }
+
+#if defined(__linux__)
+/* Returns the bracketed choice of a sysfs THP knob, e.g. "advise" from "always [advise] never". */
+static int tp_shm_read_thp_setting(const char *path, char *out, size_t out_len)
+{
+    char line[256];
+    FILE *file = fopen(path, "r");
+    char *start;
+    char *end;
+
+    if (NULL == file)
+    {
+        return -1;
+    }
+
+    if (NULL == fgets(line, sizeof(line), file))
+    {
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    start = strchr(line, '[');
+    end = (NULL == start) ? NULL : strchr(start, ']');
+    if (NULL == end || (size_t)(end - start - 1) >= out_len)
+    {
+        return -1;
+    }
+
+    memcpy(out, start + 1, (size_t)(end - start - 1));
+    out[end - start - 1] = '\0';
+    return 0;
+}
+
+/* Finds the huge= option of the tmpfs mount holding resolved_path, if it has one. */
+static int tp_shm_read_tmpfs_huge_option(const char *resolved_path, char *out, size_t out_len)
+{
+    char line[8192];
+    size_t best_len = 0;
+    int found = -1;
+    FILE *file = fopen("/proc/self/mounts", "r");
+
+    if (NULL == file)
+    {
+        return -1;
+    }
+
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        char mount_point[4096];
+        char fs_type[64];
+        char options[2048];
+        size_t mount_len;
+        const char *huge;
+
+        if (sscanf(line, "%*s %4095s %63s %2047s", mount_point, fs_type, options) != 3 ||
+            strcmp(fs_type, "tmpfs") != 0)
+        {
+            continue;
+        }
+
+        mount_len = strlen(mount_point);
+        if (1 == mount_len)
+        {
+            mount_len = 0;
+        }
+        if (strncmp(resolved_path, mount_point, mount_len) != 0 ||
+            (resolved_path[mount_len] != '/' && resolved_path[mount_len] != '\0') ||
+            (found == 0 && mount_len < best_len))
+        {
+            continue;
+        }
+
+        best_len = mount_len;
+        found = 0;
+        out[0] = '\0';
+        huge = strstr(options, "huge=");
+        if (NULL != huge)
+        {
+            size_t value_len = strcspn(huge + 5, ",");
+            if (value_len < out_len)
+            {
+                memcpy(out, huge + 5, value_len);
+                out[value_len] = '\0';
+            }
+        }
+    }
+
+    fclose(file);
+    return found;
+}
+#endif
+
+int tp_shm_transparent_hugepages_supported(const char *path)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    char resolved_path[4096];
+    char setting[32];
+    char huge[32];
+    struct statfs st;
+
+    if (NULL == path)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_transparent_hugepages_supported: null path");
+        return -1;
+    }
+
+    if (statfs(path, &st) < 0)
+    {
+        TP_SET_ERR(errno, "tp_shm_transparent_hugepages_supported: statfs failed for %s", path);
+        return -1;
+    }
+
+    if ((uint64_t)st.f_type != (uint64_t)TMPFS_MAGIC)
+    {
+        return 0;
+    }
+
+    /* shmem_enabled governs the internal shm mount; only deny and force reach tmpfs mounts. */
+    if (tp_shm_read_thp_setting("/sys/kernel/mm/transparent_hugepage/shmem_enabled", setting, sizeof(setting)) < 0 ||
+        0 == strcmp(setting, "deny"))
+    {
+        return 0;
+    }
+    if (0 == strcmp(setting, "force"))
+    {
+        return 1;
+    }
+
+    if (NULL == realpath(path, resolved_path))
+    {
+        TP_SET_ERR(errno, "tp_shm_transparent_hugepages_supported: realpath failed for %s", path);
+        return -1;
+    }
+
+    if (tp_shm_read_tmpfs_huge_option(resolved_path, huge, sizeof(huge)) < 0)
+    {
+        return 0;
+    }
+
+    return (0 == strcmp(huge, "advise") || 0 == strcmp(huge, "always") || 0 == strcmp(huge, "within_size")) ? 1 : 0;
+#else
+    (void)path;
+    return 0;
+#endif
+}
+
+int tp_shm_hugepage_coverage(const void *addr, size_t length, size_t *huge_bytes, size_t *resident_bytes)
+{
+#if defined(__linux__)
+    char line[512];
+    uintptr_t begin = (uintptr_t)addr;
+    uintptr_t end = begin + length;
+    bool in_range = false;
+    size_t huge_kb = 0;
+    size_t rss_kb = 0;
+    FILE *file;
+
+    if (NULL == addr || 0 == length || NULL == huge_bytes || NULL == resident_bytes)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_hugepage_coverage: invalid input");
+        return -1;
+    }
+
+    file = fopen("/proc/self/smaps", "r");
+    if (NULL == file)
+    {
+        TP_SET_ERR(errno, "%s", "tp_shm_hugepage_coverage: cannot open /proc/self/smaps");
+        return -1;
+    }
+
+    /* Sums every mapping overlapping the range; a madvise or mbind may have split it. */
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        unsigned long vma_start;
+        unsigned long vma_end;
+        size_t value;
+
+        if (sscanf(line, "%lx-%lx ", &vma_start, &vma_end) == 2)
+        {
+            in_range = vma_start < end && vma_end > begin;
+            continue;
+        }
+
+        if (!in_range)
+        {
+            continue;
+        }
+
+        if (sscanf(line, "Rss: %zu kB", &value) == 1)
+        {
+            rss_kb += value;
+        }
+        else if (sscanf(line, "ShmemPmdMapped: %zu kB", &value) == 1 ||
+            sscanf(line, "FilePmdMapped: %zu kB", &value) == 1 ||
+            sscanf(line, "AnonHugePages: %zu kB", &value) == 1)
+        {
+            huge_kb += value;
+        }
+    }
+
+    fclose(file);
+    *huge_bytes = huge_kb * 1024u;
+    *resident_bytes = rss_kb * 1024u;
+    return 0;
+#else
+    (void)addr;
+    (void)length;
+    (void)huge_bytes;
+    (void)resident_bytes;
+    TP_SET_ERR(ENOSYS, "%s", "tp_shm_hugepage_coverage: unsupported on this platform");
+    return -1;
+#endif
+}
@@ -0,0 +1,102 @@
+#include "tp_steal_queue.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tensor_pool/tp_error.h"
+
+static int tp_is_power_of_two(size_t value)
+{
+    return value != 0 && ((value & (value - 1)) == 0);
+}
+
+int tp_steal_queue_init(tp_steal_queue_t *queue, size_t capacity)
+{
+    size_t i;
+
+    if (NULL == queue || !tp_is_power_of_two(capacity))
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_steal_queue_init: invalid input");
+        return -1;
+    }
+
+    memset(queue, 0, sizeof(*queue));
+    queue->slots = (_Atomic uint64_t *)calloc(capacity, sizeof(*queue->slots));
+    if (NULL == queue->slots)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_steal_queue_init: allocation failed");
+        return -1;
+    }
+
+    for (i = 0; i < capacity; i++)
+    {
+        atomic_init(&queue->slots[i], 0);
+    }
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    atomic_init(&queue->top, 0);
+    atomic_init(&queue->bottom, 0);
+    return 0;
+}
+
+void tp_steal_queue_close(tp_steal_queue_t *queue)
+{
+    if (NULL == queue)
+    {
+        return;
+    }
+
+    free((void *)queue->slots);
+    queue->slots = NULL;
+    queue->capacity = 0;
+    queue->mask = 0;
+}
+
+bool tp_steal_queue_push(tp_steal_queue_t *queue, uint64_t value)
+{
+    uint64_t bottom = atomic_load_explicit(&queue->bottom, memory_order_relaxed);
+    uint64_t top = atomic_load_explicit(&queue->top, memory_order_acquire);
+
+    if (bottom - top >= queue->capacity)
+    {
+        return false;
+    }
+
+    atomic_store_explicit(&queue->slots[bottom & queue->mask], value, memory_order_relaxed);
+    atomic_store_explicit(&queue->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+bool tp_steal_queue_take(tp_steal_queue_t *queue, uint64_t *value)
+{
+    uint64_t top = atomic_load_explicit(&queue->top, memory_order_acquire);
+
+    for (;;)
+    {
+        uint64_t bottom = atomic_load_explicit(&queue->bottom, memory_order_acquire);
+        uint64_t candidate;
+
+        if (top >= bottom)
+        {
+            return false;
+        }
+
+        /* The slot cannot be reused until top moves past it, so a stale read only loses the CAS. */
+        candidate = atomic_load_explicit(&queue->slots[top & queue->mask], memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(
+            &queue->top, &top, top + 1, memory_order_acq_rel, memory_order_acquire))
+        {
+            *value = candidate;
+            return true;
+        }
+    }
+}
+
+size_t tp_steal_queue_size(tp_steal_queue_t *queue)
+{
+    uint64_t top = atomic_load_explicit(&queue->top, memory_order_acquire);
+    uint64_t bottom = atomic_load_explicit(&queue->bottom, memory_order_acquire);
+
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
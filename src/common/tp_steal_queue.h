@@ -0,0 +1,30 @@
+#ifndef TENSOR_POOL_TP_STEAL_QUEUE_H
+#define TENSOR_POOL_TP_STEAL_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Bounded single-producer ring of u64 values that any number of threads may take from.
+ * The owning worker and thieves both take from the top with a CAS, so a worker can steal
+ * from a sibling's queue with the same call it uses on its own.
+ */
+typedef struct tp_steal_queue_stct
+{
+    _Atomic uint64_t *slots;
+    uint64_t capacity;
+    uint64_t mask;
+    _Alignas(64) _Atomic uint64_t top;
+    _Alignas(64) _Atomic uint64_t bottom;
+}
+tp_steal_queue_t;
+
+int tp_steal_queue_init(tp_steal_queue_t *queue, size_t capacity);
+void tp_steal_queue_close(tp_steal_queue_t *queue);
+bool tp_steal_queue_push(tp_steal_queue_t *queue, uint64_t value);
+bool tp_steal_queue_take(tp_steal_queue_t *queue, uint64_t *value);
+size_t tp_steal_queue_size(tp_steal_queue_t *queue);
+
+#endif
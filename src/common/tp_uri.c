@@ -42,6 +42,7 @@ int tp_shm_uri_parse(tp_shm_uri_t *out, const char *uri, tp_log_t *log)
 
     memset(out, 0, sizeof(*out));
     out->require_hugepages = false;
+    out->transparent_hugepages = false;
 
     cursor = uri + strlen(prefix);
     while (*cursor != '\0')
@@ -104,6 +105,25 @@ int tp_shm_uri_parse(tp_shm_uri_t *out, const char *uri, tp_log_t *log)
                 return -1;
             }
         }
+        else if (0 == strncmp(cursor, "transparent_hugepages", key_len))
+        {
+            char value[16];
+
+            if (value_len >= sizeof(value))
+            {
+                TP_SET_ERR(EINVAL, "%s", "tp_shm_uri_parse: transparent_hugepages too long");
+                return -1;
+            }
+
+            memcpy(value, eq + 1, value_len);
+            value[value_len] = '\0';
+
+            if (tp_uri_parse_bool(value, &out->transparent_hugepages) < 0)
+            {
+                TP_SET_ERR(EINVAL, "tp_shm_uri_parse: invalid transparent_hugepages: %s", value);
+                return -1;
+            }
+        }
         else
         {
             TP_SET_ERR(EINVAL, "tp_shm_uri_parse: unknown parameter: %.*s", (int)key_len, cursor);
@@ -130,10 +150,18 @@ int tp_shm_uri_parse(tp_shm_uri_t *out, const char *uri, tp_log_t *log)
         return -1;
     }
 
+    if (out->require_hugepages && out->transparent_hugepages)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_shm_uri_parse: require_hugepages and transparent_hugepages are exclusive");
+        return -1;
+    }
+
     if (NULL != log)
     {
-        tp_log_emit(log, TP_LOG_DEBUG, "Parsed shm uri path=%s require_hugepages=%s", out->path,
-            out->require_hugepages ? "true" : "false");
+        tp_log_emit(log, TP_LOG_DEBUG, "Parsed shm uri path=%s require_hugepages=%s transparent_hugepages=%s",
+            out->path,
+            out->require_hugepages ? "true" : "false",
+            out->transparent_hugepages ? "true" : "false");
     }
 
     return 0;
@@ -28,9 +28,11 @@
 
 #include "tensor_pool/tp_clock.h"
 #include "tensor_pool/tp_error.h"
+#include "tensor_pool/tp_shm.h"
 #include "tensor_pool/tp_types.h"
 #include "tensor_pool/internal/tp_context.h"
 #include "tp_aeron_wrap.h"
+#include "tp_driver_provision.h"
 
 #include "driver/tensor_pool/messageHeader.h"
 #include "driver/tensor_pool/shmAttachRequest.h"
@@ -85,9 +87,23 @@ typedef struct tp_driver_stream_state_stct
     uint64_t producer_lease_id;
     uint32_t producer_client_id;
     bool require_hugepages;
+    bool transparent_hugepages;
+    bool provisioning;
+    uint64_t spare_epoch;
+    bool spare_ready;
+    tp_numa_policy_t numa;
 }
 tp_driver_stream_state_t;
 
+typedef struct tp_driver_pending_attach_stct
+{
+    int64_t correlation_id;
+    uint64_t lease_id;
+    uint32_t stream_id;
+    bool require_hugepages;
+}
+tp_driver_pending_attach_t;
+
 static uint64_t tp_driver_seed_u64(void);
 static bool tp_driver_node_id_in_use(tp_driver_t *driver, uint32_t node_id);
 static int tp_driver_gc_stream(tp_driver_t *driver, tp_driver_stream_state_t *stream);
@@ -228,6 +244,11 @@ static tp_driver_lease_t *tp_driver_leases(tp_driver_t *driver)
     return (tp_driver_lease_t *)driver->leases;
 }
 
+static tp_driver_pending_attach_t *tp_driver_pending_attaches(tp_driver_t *driver)
+{
+    return (tp_driver_pending_attach_t *)driver->pending_attaches;
+}
+
 static tp_driver_node_id_cooldown_t *tp_driver_node_id_cooldowns(tp_driver_t *driver)
 {
     return (tp_driver_node_id_cooldown_t *)driver->node_id_cooldowns;
@@ -486,6 +507,8 @@ static int tp_driver_add_stream(tp_driver_t *driver, uint32_t stream_id, tp_driv
     streams[new_count - 1].stream_id = stream_id;
     streams[new_count - 1].profile = profile;
     streams[new_count - 1].require_hugepages = driver->config.require_hugepages;
+    streams[new_count - 1].transparent_hugepages = driver->config.transparent_hugepages;
+    streams[new_count - 1].numa = profile->numa;
     driver->streams = streams;
     driver->stream_count = new_count;
     return 0;
@@ -713,6 +736,7 @@ static int tp_driver_build_region_uri(
     uint16_t pool_id,
     int16_t region_type,
     bool require_hugepages,
+    bool transparent_hugepages,
     char *uri,
     size_t uri_len)
 {
@@ -723,9 +747,10 @@ static int tp_driver_build_region_uri(
         return -1;
     }
 
-    if (snprintf(uri, uri_len, "shm:file?path=%s|require_hugepages=%s",
+    if (snprintf(uri, uri_len, "shm:file?path=%s|require_hugepages=%s%s",
             path,
-            require_hugepages ? "true" : "false") >= (int)uri_len)
+            require_hugepages ? "true" : "false",
+            transparent_hugepages ? "|transparent_hugepages=true" : "") >= (int)uri_len)
     {
         TP_SET_ERR(EINVAL, "%s", "tp_driver_build_region_uri: uri too long");
         return -1;
@@ -734,120 +759,59 @@ static int tp_driver_build_region_uri(
     return 0;
 }
 
-static int tp_driver_prefault_file(int fd, size_t size, bool mlock_enabled)
-{
-#if defined(__linux__)
-    void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    if (addr == MAP_FAILED)
-    {
-        return -1;
-    }
-
-    memset(addr, 0, size);
-
-    if (mlock_enabled)
-    {
-        if (mlock(addr, size) != 0)
-        {
-            munmap(addr, size);
-            return -1;
-        }
-    }
-
-    munmap(addr, size);
-    return 0;
-#else
-    (void)fd;
-    (void)size;
-    (void)mlock_enabled;
-    return 0;
-#endif
-}
-
-static int tp_driver_create_region_file(
+static int tp_driver_prepare_region(
     tp_driver_t *driver,
     uint32_t stream_id,
     uint64_t epoch,
     uint16_t pool_id,
     int16_t region_type,
     uint32_t nslots,
-    uint32_t stride_bytes)
+    uint32_t stride_bytes,
+    tp_driver_region_spec_t *spec)
 {
-    char path[4096];
     char dir_path[4096];
     char *slash;
-    uint8_t buffer[TP_SUPERBLOCK_SIZE_BYTES];
     struct tensor_pool_shmRegionSuperblock superblock;
     uint32_t slot_bytes;
-    size_t file_size;
-    int fd;
     mode_t file_mode = (mode_t)driver->config.permissions_mode;
     mode_t dir_mode = file_mode | 0110;
     uint64_t now_ns;
 
-    if (tp_driver_build_region_path(driver, stream_id, epoch, pool_id, region_type, path, sizeof(path)) < 0)
+    memset(spec, 0, sizeof(*spec));
+    if (tp_driver_build_region_path(driver, stream_id, epoch, pool_id, region_type, spec->path, sizeof(spec->path)) < 0)
     {
         return -1;
     }
 
-    strncpy(dir_path, path, sizeof(dir_path) - 1);
+    strncpy(dir_path, spec->path, sizeof(dir_path) - 1);
     dir_path[sizeof(dir_path) - 1] = '\0';
     slash = strrchr(dir_path, '/');
     if (NULL == slash)
     {
-        TP_SET_ERR(EINVAL, "%s", "tp_driver_create_region_file: invalid path");
+        TP_SET_ERR(EINVAL, "%s", "tp_driver_prepare_region: invalid path");
         return -1;
     }
     *slash = '\0';
     if (tp_driver_mkdir_p(dir_path, dir_mode) < 0)
     {
-        TP_SET_ERR(errno, "tp_driver_create_region_file: mkdir failed for %s", dir_path);
+        TP_SET_ERR(errno, "tp_driver_prepare_region: mkdir failed for %s", dir_path);
         return -1;
     }
 
     if (region_type == tensor_pool_regionType_HEADER_RING)
     {
         slot_bytes = TP_HEADER_SLOT_BYTES;
-        file_size = TP_SUPERBLOCK_SIZE_BYTES + ((size_t)nslots * TP_HEADER_SLOT_BYTES);
+        spec->file_size = TP_SUPERBLOCK_SIZE_BYTES + ((size_t)nslots * TP_HEADER_SLOT_BYTES);
     }
     else
     {
         slot_bytes = TP_NULL_U32;
-        file_size = TP_SUPERBLOCK_SIZE_BYTES + ((size_t)nslots * stride_bytes);
-    }
-
-    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, file_mode);
-    if (fd < 0)
-    {
-        TP_SET_ERR(errno, "tp_driver_create_region_file: open failed for %s", path);
-        return -1;
-    }
-
-    if (ftruncate(fd, (off_t)file_size) != 0)
-    {
-        TP_SET_ERR(errno, "tp_driver_create_region_file: ftruncate failed for %s", path);
-        close(fd);
-        return -1;
-    }
-
-    if (driver->config.prefault_shm)
-    {
-        if (tp_driver_prefault_file(fd, file_size, driver->config.mlock_shm) < 0)
-        {
-            if (driver->config.mlock_shm)
-            {
-                TP_SET_ERR(errno, "tp_driver_create_region_file: mlock failed for %s", path);
-                close(fd);
-                return -1;
-            }
-            tp_log_emit(&driver->config.base->log, TP_LOG_WARN,
-                "tp_driver_create_region_file: prefault failed for %s", path);
-        }
+        spec->file_size = TP_SUPERBLOCK_SIZE_BYTES + ((size_t)nslots * stride_bytes);
     }
+    spec->file_mode = (uint32_t)file_mode;
 
     now_ns = tp_clock_now_ns();
-    memset(buffer, 0, sizeof(buffer));
-    tensor_pool_shmRegionSuperblock_wrap_for_encode(&superblock, (char *)buffer, 0, sizeof(buffer));
+    tensor_pool_shmRegionSuperblock_wrap_for_encode(&superblock, (char *)spec->superblock, 0, sizeof(spec->superblock));
     tensor_pool_shmRegionSuperblock_set_magic(&superblock, TP_MAGIC_U64);
     tensor_pool_shmRegionSuperblock_set_layoutVersion(&superblock, TP_LAYOUT_VERSION);
     tensor_pool_shmRegionSuperblock_set_epoch(&superblock, epoch);
@@ -861,66 +825,6 @@ static int tp_driver_create_region_file(
     tensor_pool_shmRegionSuperblock_set_startTimestampNs(&superblock, now_ns);
     tensor_pool_shmRegionSuperblock_set_activityTimestampNs(&superblock, now_ns);
 
-    if (pwrite(fd, buffer, sizeof(buffer), 0) != (ssize_t)sizeof(buffer))
-    {
-        TP_SET_ERR(errno, "tp_driver_create_region_file: superblock write failed for %s", path);
-        close(fd);
-        return -1;
-    }
-
-    if (fsync(fd) != 0)
-    {
-        TP_SET_ERR(errno, "tp_driver_create_region_file: fsync failed for %s", path);
-        close(fd);
-        return -1;
-    }
-
-    close(fd);
-    return 0;
-}
-
-static int tp_driver_create_shm_epoch(tp_driver_t *driver, tp_driver_stream_state_t *stream)
-{
-    size_t i;
-
-    if (NULL == driver || NULL == stream || NULL == stream->profile)
-    {
-        return -1;
-    }
-
-    if (tp_driver_create_region_file(
-        driver,
-        stream->stream_id,
-        stream->epoch,
-        0,
-        tensor_pool_regionType_HEADER_RING,
-        stream->profile->header_nslots,
-        0) < 0)
-    {
-        return -1;
-    }
-
-    for (i = 0; i < stream->profile->pool_count; i++)
-    {
-        const tp_driver_pool_def_t *pool = &stream->profile->pools[i];
-        if (tp_driver_create_region_file(
-            driver,
-            stream->stream_id,
-            stream->epoch,
-            pool->pool_id,
-            tensor_pool_regionType_PAYLOAD_POOL,
-            stream->profile->header_nslots,
-            pool->stride_bytes) < 0)
-        {
-            return -1;
-        }
-    }
-
-    stream->epoch_created_ns = tp_clock_now_ns();
-    if (driver->config.epoch_gc_enabled)
-    {
-        tp_driver_gc_stream(driver, stream);
-    }
     return 0;
 }
 
@@ -1026,7 +930,7 @@ static int tp_driver_gc_stream(tp_driver_t *driver, tp_driver_stream_state_t *st
             continue;
         }
 
-        if (epoch == stream->epoch)
+        if (epoch == stream->epoch || (stream->spare_epoch != 0 && epoch == stream->spare_epoch))
         {
             continue;
         }
@@ -1046,6 +950,13 @@ static int tp_driver_gc_stream(tp_driver_t *driver, tp_driver_stream_state_t *st
             continue;
         }
 
+        /* Epochs ahead of the current one are spares that were never promoted. */
+        if (stream->epoch != 0 && epoch > stream->epoch)
+        {
+            tp_driver_remove_epoch_dir(driver, stream, epoch);
+            continue;
+        }
+
         if (epoch_count == epoch_cap)
         {
             size_t new_cap = epoch_cap == 0 ? 8 : epoch_cap * 2;
@@ -1204,7 +1115,8 @@ static int tp_driver_send_attach_response(
             tensor_pool_shmAttachResponse_payloadPools_set_strideBytes(&pools, pool->stride_bytes);
 
             if (tp_driver_build_region_uri(driver, stream->stream_id, stream->epoch, pool->pool_id,
-                    tensor_pool_regionType_PAYLOAD_POOL, require_hugepages, pool_uri, sizeof(pool_uri)) < 0)
+                    tensor_pool_regionType_PAYLOAD_POOL, require_hugepages, stream->transparent_hugepages,
+                    pool_uri, sizeof(pool_uri)) < 0)
             {
                 return -1;
             }
@@ -1220,7 +1132,8 @@ static int tp_driver_send_attach_response(
         }
 
         if (tp_driver_build_region_uri(driver, stream->stream_id, stream->epoch, 0,
-                tensor_pool_regionType_HEADER_RING, require_hugepages, header_uri, sizeof(header_uri)) < 0)
+                tensor_pool_regionType_HEADER_RING, require_hugepages, stream->transparent_hugepages,
+                header_uri, sizeof(header_uri)) < 0)
         {
             return -1;
         }
@@ -1466,7 +1379,8 @@ static int tp_driver_send_announce(tp_driver_t *driver, tp_driver_stream_state_t
         tensor_pool_shmPoolAnnounce_payloadPools_set_strideBytes(&pools, pool->stride_bytes);
 
         if (tp_driver_build_region_uri(driver, stream->stream_id, stream->epoch, pool->pool_id,
-                tensor_pool_regionType_PAYLOAD_POOL, require_hugepages, pool_uri, sizeof(pool_uri)) < 0)
+                tensor_pool_regionType_PAYLOAD_POOL, require_hugepages, stream->transparent_hugepages,
+                pool_uri, sizeof(pool_uri)) < 0)
         {
             return -1;
         }
@@ -1479,7 +1393,8 @@ static int tp_driver_send_announce(tp_driver_t *driver, tp_driver_stream_state_t
     }
 
     if (tp_driver_build_region_uri(driver, stream->stream_id, stream->epoch, 0,
-            tensor_pool_regionType_HEADER_RING, require_hugepages, header_uri, sizeof(header_uri)) < 0)
+            tensor_pool_regionType_HEADER_RING, require_hugepages, stream->transparent_hugepages,
+            header_uri, sizeof(header_uri)) < 0)
     {
         return -1;
     }
@@ -1495,19 +1410,16 @@ static int tp_driver_send_announce(tp_driver_t *driver, tp_driver_stream_state_t
         buffer, tensor_pool_shmPoolAnnounce_sbe_position(&announce));
 }
 
-static int tp_driver_bump_epoch(tp_driver_stream_state_t *stream)
+static uint64_t tp_driver_next_epoch(uint64_t epoch)
 {
     uint64_t now = tp_clock_now_ns();
 
-    if (now <= stream->epoch)
-    {
-        stream->epoch++;
-    }
-    else
-    {
-        stream->epoch = now;
-    }
+    return now <= epoch ? epoch + 1 : now;
+}
 
+static int tp_driver_bump_epoch(tp_driver_stream_state_t *stream)
+{
+    stream->epoch = tp_driver_next_epoch(stream->epoch);
     return 0;
 }
 
@@ -1527,10 +1439,386 @@ static int tp_driver_release_producer(tp_driver_stream_state_t *stream, const tp
     return 0;
 }
 
+static int tp_driver_add_pending_attach(tp_driver_t *driver, const tp_driver_pending_attach_t *pending)
+{
+    tp_driver_pending_attach_t *entries;
+
+    if (driver->pending_attach_count + 1 > driver->pending_attach_capacity)
+    {
+        size_t new_capacity = driver->pending_attach_capacity == 0 ? 8 : driver->pending_attach_capacity * 2;
+        entries = (tp_driver_pending_attach_t *)realloc(driver->pending_attaches, new_capacity * sizeof(*entries));
+        if (NULL == entries)
+        {
+            TP_SET_ERR(ENOMEM, "%s", "tp_driver_add_pending_attach: allocation failed");
+            return -1;
+        }
+        driver->pending_attaches = entries;
+        driver->pending_attach_capacity = new_capacity;
+    }
+
+    tp_driver_pending_attaches(driver)[driver->pending_attach_count++] = *pending;
+    return 0;
+}
+
+static void tp_driver_drop_lease(tp_driver_t *driver, uint64_t lease_id)
+{
+    size_t i;
+
+    for (i = 0; i < driver->lease_count; i++)
+    {
+        if (tp_driver_leases(driver)[i].lease_id == lease_id)
+        {
+            tp_driver_remove_lease(driver, i);
+            return;
+        }
+    }
+}
+
+/*
+ * Answers every attach that was waiting on the stream's epoch. Their leases were issued
+ * without an expiry so they could not lapse while the epoch was building; the keepalive
+ * clock starts now, when the client first learns the lease id.
+ */
+static void tp_driver_finish_pending_attaches(tp_driver_t *driver, tp_driver_stream_state_t *stream, bool ready)
+{
+    uint64_t now = tp_clock_now_ns();
+    uint64_t interval_ns = (uint64_t)driver->config.lease_keepalive_interval_ms * 1000000ULL;
+    size_t i = 0;
+
+    while (i < driver->pending_attach_count)
+    {
+        tp_driver_pending_attach_t pending = tp_driver_pending_attaches(driver)[i];
+        tp_driver_lease_t *lease;
+
+        if (pending.stream_id != stream->stream_id)
+        {
+            i++;
+            continue;
+        }
+
+        if (i + 1 < driver->pending_attach_count)
+        {
+            memmove(&tp_driver_pending_attaches(driver)[i],
+                &tp_driver_pending_attaches(driver)[i + 1],
+                (driver->pending_attach_count - i - 1) * sizeof(tp_driver_pending_attach_t));
+        }
+        driver->pending_attach_count--;
+
+        lease = tp_driver_find_lease(driver, pending.lease_id);
+        if (NULL == lease)
+        {
+            continue;
+        }
+
+        if (ready)
+        {
+            lease->issued_ns = now;
+            lease->expiry_ns = now + interval_ns * driver->config.lease_expiry_grace_intervals;
+            tp_driver_send_attach_response(driver, pending.correlation_id,
+                tensor_pool_responseCode_OK, stream, lease, pending.require_hugepages, NULL);
+        }
+        else
+        {
+            tp_driver_release_producer(stream, lease);
+            tp_driver_drop_lease(driver, pending.lease_id);
+            tp_driver_send_attach_response(driver, pending.correlation_id,
+                tensor_pool_responseCode_INTERNAL_ERROR, NULL, NULL,
+                pending.require_hugepages, "shm creation failed");
+        }
+    }
+}
+
+static int tp_driver_submit_epoch(tp_driver_t *driver, tp_driver_stream_state_t *stream, uint64_t epoch)
+{
+    tp_driver_region_spec_t *specs;
+    size_t count;
+    size_t i;
+    int result = -1;
+
+    if (NULL == driver || NULL == stream || NULL == stream->profile || NULL == driver->provisioner)
+    {
+        return -1;
+    }
+
+    count = stream->profile->pool_count + 1;
+    specs = (tp_driver_region_spec_t *)calloc(count, sizeof(*specs));
+    if (NULL == specs)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_driver_submit_epoch: allocation failed");
+        return -1;
+    }
+
+    if (tp_driver_prepare_region(
+        driver,
+        stream->stream_id,
+        epoch,
+        0,
+        tensor_pool_regionType_HEADER_RING,
+        stream->profile->header_nslots,
+        0,
+        &specs[0]) < 0)
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < stream->profile->pool_count; i++)
+    {
+        const tp_driver_pool_def_t *pool = &stream->profile->pools[i];
+        if (tp_driver_prepare_region(
+            driver,
+            stream->stream_id,
+            epoch,
+            pool->pool_id,
+            tensor_pool_regionType_PAYLOAD_POOL,
+            stream->profile->header_nslots,
+            pool->stride_bytes,
+            &specs[i + 1]) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        specs[i].transparent_hugepages = stream->transparent_hugepages;
+    }
+
+    result = tp_driver_provision_submit(
+        (tp_driver_provision_t *)driver->provisioner, stream->stream_id, epoch, specs, count, &stream->numa);
+
+cleanup:
+    free(specs);
+    return result;
+}
+
+/*
+ * Hands the epoch's region files to the provisioning workers. The stream stays provisioning,
+ * and is neither announced nor handed to attaching clients, until tp_driver_poll_provisioning
+ * sees the epoch finish.
+ */
+static int tp_driver_begin_shm_epoch(tp_driver_t *driver, tp_driver_stream_state_t *stream)
+{
+    if (tp_driver_submit_epoch(driver, stream, stream->epoch) < 0)
+    {
+        if (stream->provisioning)
+        {
+            /* The epoch being built was just superseded, so nothing will answer its waiters. */
+            stream->provisioning = false;
+            tp_driver_finish_pending_attaches(driver, stream, false);
+        }
+        return -1;
+    }
+
+    stream->provisioning = true;
+    return 0;
+}
+
+/*
+ * Starts building the stream's next epoch ahead of need, so a producer reattach or epoch bump
+ * can promote it without waiting on region creation or prefault.
+ */
+static void tp_driver_begin_spare_epoch(tp_driver_t *driver, tp_driver_stream_state_t *stream)
+{
+    uint64_t epoch;
+
+    if (!driver->config.spare_epochs || stream->epoch == 0 || stream->spare_epoch != 0)
+    {
+        return;
+    }
+
+    epoch = tp_driver_next_epoch(stream->epoch);
+    if (tp_driver_submit_epoch(driver, stream, epoch) < 0)
+    {
+        tp_log_emit(&driver->config.base->log, TP_LOG_WARN,
+            "tp_driver_begin_spare_epoch: spare for stream %" PRIu32 " failed: %s",
+            stream->stream_id, tp_errmsg());
+        return;
+    }
+
+    stream->spare_epoch = epoch;
+    stream->spare_ready = false;
+}
+
+/* A spare's superblocks carry its build time; restamp them so they read as freshly created. */
+static int tp_driver_restamp_epoch(tp_driver_t *driver, tp_driver_stream_state_t *stream)
+{
+    tp_driver_region_spec_t spec;
+    size_t i;
+
+    for (i = 0; i <= stream->profile->pool_count; i++)
+    {
+        const tp_driver_pool_def_t *pool = i == 0 ? NULL : &stream->profile->pools[i - 1];
+        int fd;
+        ssize_t written;
+
+        if (tp_driver_prepare_region(
+            driver,
+            stream->stream_id,
+            stream->epoch,
+            NULL == pool ? 0 : pool->pool_id,
+            NULL == pool ? tensor_pool_regionType_HEADER_RING : tensor_pool_regionType_PAYLOAD_POOL,
+            stream->profile->header_nslots,
+            NULL == pool ? 0 : pool->stride_bytes,
+            &spec) < 0)
+        {
+            return -1;
+        }
+
+        fd = open(spec.path, O_RDWR);
+        if (fd < 0)
+        {
+            TP_SET_ERR(errno, "tp_driver_restamp_epoch: open failed for %s", spec.path);
+            return -1;
+        }
+
+        written = pwrite(fd, spec.superblock, sizeof(spec.superblock), 0);
+        if (written != (ssize_t)sizeof(spec.superblock))
+        {
+            TP_SET_ERR(errno, "tp_driver_restamp_epoch: superblock write failed for %s", spec.path);
+            close(fd);
+            return -1;
+        }
+
+        /* Flush like a freshly provisioned region before the epoch is announced. */
+        if (fsync(fd) != 0)
+        {
+            TP_SET_ERR(errno, "tp_driver_restamp_epoch: fsync failed for %s", spec.path);
+            close(fd);
+            return -1;
+        }
+        close(fd);
+    }
+
+    return 0;
+}
+
+static void tp_driver_epoch_ready(tp_driver_t *driver, tp_driver_stream_state_t *stream)
+{
+    stream->provisioning = false;
+    stream->epoch_created_ns = tp_clock_now_ns();
+    if (driver->config.epoch_gc_enabled)
+    {
+        tp_driver_gc_stream(driver, stream);
+    }
+
+    tp_driver_send_announce(driver, stream, stream->require_hugepages);
+    tp_driver_finish_pending_attaches(driver, stream, true);
+    tp_driver_begin_spare_epoch(driver, stream);
+}
+
+/*
+ * Moves the stream to a new epoch. A ready spare is promoted on the spot, a spare still
+ * building becomes the epoch being provisioned, and otherwise a fresh epoch is built.
+ */
+static int tp_driver_advance_epoch(tp_driver_t *driver, tp_driver_stream_state_t *stream)
+{
+    if (stream->spare_epoch != 0 && stream->spare_epoch > stream->epoch)
+    {
+        bool ready = stream->spare_ready;
+
+        stream->epoch = stream->spare_epoch;
+        stream->spare_epoch = 0;
+        stream->spare_ready = false;
+
+        if (!ready)
+        {
+            stream->provisioning = true;
+            return 0;
+        }
+
+        if (tp_driver_restamp_epoch(driver, stream) == 0)
+        {
+            tp_driver_epoch_ready(driver, stream);
+            return 0;
+        }
+
+        tp_log_emit(&driver->config.base->log, TP_LOG_WARN,
+            "tp_driver_advance_epoch: spare for stream %" PRIu32 " unusable: %s",
+            stream->stream_id, tp_errmsg());
+    }
+
+    tp_driver_bump_epoch(stream);
+    return tp_driver_begin_shm_epoch(driver, stream);
+}
+
+static int tp_driver_poll_provisioning(tp_driver_t *driver)
+{
+    tp_driver_provision_result_t result;
+    int work = 0;
+
+    if (NULL == driver->provisioner)
+    {
+        return 0;
+    }
+
+    while (tp_driver_provision_poll((tp_driver_provision_t *)driver->provisioner, &result) > 0)
+    {
+        tp_driver_stream_state_t *stream = tp_driver_find_stream(driver, result.stream_id);
+
+        work++;
+        if (NULL == stream)
+        {
+            continue;
+        }
+
+        if (stream->spare_epoch != 0 && stream->spare_epoch == result.epoch)
+        {
+            if (result.error != 0)
+            {
+                tp_log_emit(&driver->config.base->log, TP_LOG_WARN, "%s", result.message);
+                stream->spare_epoch = 0;
+                continue;
+            }
+            stream->spare_ready = true;
+            continue;
+        }
+
+        if (!stream->provisioning || stream->epoch != result.epoch)
+        {
+            continue;
+        }
+
+        if (result.error != 0)
+        {
+            stream->provisioning = false;
+            tp_log_emit(&driver->config.base->log, TP_LOG_WARN, "%s", result.message);
+            tp_driver_finish_pending_attaches(driver, stream, false);
+            continue;
+        }
+
+        if (result.numa_failed)
+        {
+            tp_log_emit(&driver->config.base->log, TP_LOG_WARN,
+                "tp_driver_poll_provisioning: numa %s policy not applied for stream %" PRIu32 " epoch %" PRIu64,
+                tp_numa_mode_name(stream->numa.mode), stream->stream_id, stream->epoch);
+        }
+
+        if (result.hugepage_bytes < result.hugepage_target_bytes)
+        {
+            tp_log_emit(&driver->config.base->log, TP_LOG_WARN,
+                "tp_driver_poll_provisioning: transparent hugepages back %" PRIu64 " of %" PRIu64
+                " bytes for stream %" PRIu32 " epoch %" PRIu64,
+                result.hugepage_bytes, result.hugepage_target_bytes, stream->stream_id, stream->epoch);
+        }
+
+        if (result.prefault_failed)
+        {
+            tp_log_emit(&driver->config.base->log, TP_LOG_WARN,
+                "tp_driver_poll_provisioning: prefault failed for stream %" PRIu32 " epoch %" PRIu64,
+                stream->stream_id, stream->epoch);
+        }
+
+        tp_driver_epoch_ready(driver, stream);
+    }
+
+    return work;
+}
+
 static void tp_driver_handle_expired_leases(tp_driver_t *driver)
 {
     size_t i = 0;
     uint64_t now = tp_clock_now_ns();
+    bool advanced = false;
 
     while (i < driver->lease_count)
     {
@@ -1553,10 +1841,9 @@ static void tp_driver_handle_expired_leases(tp_driver_t *driver)
 
             if (bump_epoch && NULL != stream)
             {
-                tp_driver_bump_epoch(stream);
-                if (tp_driver_create_shm_epoch(driver, stream) == 0)
+                if (tp_driver_advance_epoch(driver, stream) == 0)
                 {
-                    tp_driver_send_announce(driver, stream, stream->require_hugepages);
+                    advanced = true;
                 }
             }
             continue;
@@ -1564,6 +1851,12 @@ static void tp_driver_handle_expired_leases(tp_driver_t *driver)
 
         i++;
     }
+
+    /* Provisioning can attach or remove leases; only poll once the scan is done. */
+    if (advanced)
+    {
+        tp_driver_poll_provisioning(driver);
+    }
 }
 
 static int tp_driver_handle_detach(
@@ -1624,10 +1917,9 @@ static int tp_driver_handle_detach(
 
     if (bump_epoch && NULL != stream)
     {
-        tp_driver_bump_epoch(stream);
-        if (tp_driver_create_shm_epoch(driver, stream) == 0)
+        if (tp_driver_advance_epoch(driver, stream) == 0)
         {
-            tp_driver_send_announce(driver, stream, stream->require_hugepages);
+            tp_driver_poll_provisioning(driver);
         }
     }
 
@@ -1682,7 +1974,7 @@ static int tp_driver_should_require_hugepages(const tp_driver_config_t *config,
     {
         return 1;
     }
-    if (policy == tensor_pool_hugepagesPolicy_STANDARD)
+    if (policy == tensor_pool_hugepagesPolicy_STANDARD || policy == tensor_pool_hugepagesPolicy_TRANSPARENT)
     {
         return 0;
     }
@@ -1690,6 +1982,20 @@ static int tp_driver_should_require_hugepages(const tp_driver_config_t *config,
     return config->require_hugepages ? 1 : 0;
 }
 
+static int tp_driver_should_use_transparent_hugepages(const tp_driver_config_t *config, uint8_t policy)
+{
+    if (policy == tensor_pool_hugepagesPolicy_TRANSPARENT)
+    {
+        return 1;
+    }
+    if (policy != tensor_pool_hugepagesPolicy_UNSPECIFIED)
+    {
+        return 0;
+    }
+
+    return config->transparent_hugepages ? 1 : 0;
+}
+
 static int tp_driver_handle_attach(
     tp_driver_t *driver,
     const struct tensor_pool_shmAttachRequest *request,
@@ -1712,7 +2018,9 @@ static int tp_driver_handle_attach(
     uint64_t now;
     uint64_t interval_ns;
     bool create_allowed;
+    bool create_epoch;
     bool require_hugepages;
+    bool transparent_hugepages;
 
     (void)length;
 
@@ -1835,7 +2143,8 @@ static int tp_driver_handle_attach(
 
     if (hugepages_policy != tensor_pool_hugepagesPolicy_UNSPECIFIED &&
         hugepages_policy != tensor_pool_hugepagesPolicy_STANDARD &&
-        hugepages_policy != tensor_pool_hugepagesPolicy_HUGEPAGES)
+        hugepages_policy != tensor_pool_hugepagesPolicy_HUGEPAGES &&
+        hugepages_policy != tensor_pool_hugepagesPolicy_TRANSPARENT)
     {
         return tp_driver_send_attach_response(driver, correlation_id,
             tensor_pool_responseCode_INVALID_PARAMS, NULL, NULL,
@@ -1843,6 +2152,7 @@ static int tp_driver_handle_attach(
     }
 
     require_hugepages = tp_driver_should_require_hugepages(&driver->config, hugepages_policy);
+    transparent_hugepages = tp_driver_should_use_transparent_hugepages(&driver->config, hugepages_policy);
     if (require_hugepages)
     {
         int huge_ok = tp_driver_is_hugepages_dir(driver->config.shm_base_dir);
@@ -1853,6 +2163,16 @@ static int tp_driver_handle_attach(
                 require_hugepages, "hugepages not available");
         }
     }
+    else if (transparent_hugepages)
+    {
+        int thp_ok = tp_shm_transparent_hugepages_supported(driver->config.shm_base_dir);
+        if (thp_ok != 1)
+        {
+            return tp_driver_send_attach_response(driver, correlation_id,
+                tensor_pool_responseCode_REJECTED, NULL, NULL,
+                require_hugepages, "transparent hugepages not available");
+        }
+    }
     else if (hugepages_policy == tensor_pool_hugepagesPolicy_STANDARD)
     {
         int huge_ok = tp_driver_is_hugepages_dir(driver->config.shm_base_dir);
@@ -1882,30 +2202,10 @@ static int tp_driver_handle_attach(
     if (stream->epoch != 0)
     {
         require_hugepages = stream->require_hugepages;
+        transparent_hugepages = stream->transparent_hugepages;
     }
 
-    if (role == tensor_pool_role_PRODUCER)
-    {
-        tp_driver_bump_epoch(stream);
-        stream->require_hugepages = require_hugepages;
-        if (tp_driver_create_shm_epoch(driver, stream) < 0)
-        {
-            return tp_driver_send_attach_response(driver, correlation_id,
-                tensor_pool_responseCode_INTERNAL_ERROR, NULL, NULL,
-                require_hugepages, "shm creation failed");
-        }
-    }
-    else if (stream->epoch == 0)
-    {
-        tp_driver_bump_epoch(stream);
-        stream->require_hugepages = require_hugepages;
-        if (tp_driver_create_shm_epoch(driver, stream) < 0)
-        {
-            return tp_driver_send_attach_response(driver, correlation_id,
-                tensor_pool_responseCode_INTERNAL_ERROR, NULL, NULL,
-                require_hugepages, "shm creation failed");
-        }
-    }
+    create_epoch = (role == tensor_pool_role_PRODUCER || stream->epoch == 0);
 
     memset(&lease, 0, sizeof(lease));
     lease.lease_id = tp_driver_next_lease_id(driver);
@@ -1942,7 +2242,48 @@ static int tp_driver_handle_attach(
         stream->producer_client_id = client_id;
     }
 
-    tp_driver_send_announce(driver, stream, require_hugepages);
+    if (create_epoch)
+    {
+        stream->require_hugepages = require_hugepages;
+        stream->transparent_hugepages = transparent_hugepages;
+        if (tp_driver_advance_epoch(driver, stream) < 0)
+        {
+            tp_driver_release_producer(stream, &lease);
+            tp_driver_drop_lease(driver, lease.lease_id);
+            return tp_driver_send_attach_response(driver, correlation_id,
+                tensor_pool_responseCode_INTERNAL_ERROR, NULL, NULL,
+                require_hugepages, "shm creation failed");
+        }
+    }
+
+    if (stream->provisioning)
+    {
+        tp_driver_pending_attach_t pending;
+
+        /* The lease cannot lapse before the client has been told about it. */
+        tp_driver_find_lease(driver, lease.lease_id)->expiry_ns = 0;
+        pending.correlation_id = correlation_id;
+        pending.lease_id = lease.lease_id;
+        pending.stream_id = stream->stream_id;
+        pending.require_hugepages = require_hugepages;
+        if (tp_driver_add_pending_attach(driver, &pending) < 0)
+        {
+            tp_driver_release_producer(stream, &lease);
+            tp_driver_drop_lease(driver, lease.lease_id);
+            return tp_driver_send_attach_response(driver, correlation_id,
+                tensor_pool_responseCode_INTERNAL_ERROR, NULL, NULL,
+                require_hugepages, "attach queue allocation failed");
+        }
+
+        /* Without provisioning workers the epoch is already built and answers here. */
+        tp_driver_poll_provisioning(driver);
+        return 0;
+    }
+
+    if (!create_epoch)
+    {
+        tp_driver_send_announce(driver, stream, require_hugepages);
+    }
     return tp_driver_send_attach_response(driver, correlation_id,
         tensor_pool_responseCode_OK, stream, &lease, require_hugepages, NULL);
 }
@@ -2056,6 +2397,8 @@ static void tp_driver_on_control_fragment(
 
 int tp_driver_init(tp_driver_t *driver, tp_driver_config_t *config)
 {
+    tp_driver_provision_t *provisioner = NULL;
+    size_t chunk_bytes = TP_DRIVER_PROVISION_CHUNK_BYTES_DEFAULT;
     size_t i;
 
     if (NULL == driver || NULL == config)
@@ -2088,13 +2431,41 @@ int tp_driver_init(tp_driver_t *driver, tp_driver_config_t *config)
             tp_driver_streams(driver)[i].stream_id = driver->config.streams[i].stream_id;
             tp_driver_streams(driver)[i].profile = driver->config.streams[i].profile;
             tp_driver_streams(driver)[i].require_hugepages = driver->config.require_hugepages;
+            if (driver->config.streams[i].numa_configured)
+            {
+                tp_driver_streams(driver)[i].numa = driver->config.streams[i].numa;
+            }
+            else if (NULL != driver->config.streams[i].profile)
+            {
+                tp_driver_streams(driver)[i].numa = driver->config.streams[i].profile->numa;
+            }
         }
     }
 
+    /* Prefault chunks must start on a backing page boundary for hugetlbfs mappings. */
+    if (driver->config.page_size_bytes > 0)
+    {
+        chunk_bytes = ((chunk_bytes + driver->config.page_size_bytes - 1) / driver->config.page_size_bytes) *
+            driver->config.page_size_bytes;
+    }
+
+    if (tp_driver_provision_init(&provisioner, driver->config.provision_workers, chunk_bytes,
+        driver->config.prefault_shm, driver->config.mlock_shm) < 0)
+    {
+        free(driver->streams);
+        driver->streams = NULL;
+        driver->stream_count = 0;
+        tp_driver_config_close(&driver->config);
+        return -1;
+    }
+    driver->provisioner = provisioner;
+
     if (driver->config.supervisor_enabled)
     {
         if (tp_supervisor_init(&driver->supervisor, &driver->config.supervisor_config) < 0)
         {
+            tp_driver_provision_close(provisioner);
+            driver->provisioner = NULL;
             free(driver->streams);
             driver->streams = NULL;
             driver->stream_count = 0;
@@ -2197,6 +2568,7 @@ int tp_driver_do_work(tp_driver_t *driver)
         fragments += work;
     }
 
+    fragments += tp_driver_poll_provisioning(driver);
     tp_driver_handle_expired_leases(driver);
 
     now = tp_clock_now_ns();
@@ -2206,7 +2578,7 @@ int tp_driver_do_work(tp_driver_t *driver)
         for (i = 0; i < driver->stream_count; i++)
         {
             tp_driver_stream_state_t *stream = &tp_driver_streams(driver)[i];
-            if (stream->epoch != 0)
+            if (stream->epoch != 0 && !stream->provisioning)
             {
                 tp_driver_send_announce(driver, stream, stream->require_hugepages);
             }
@@ -2226,6 +2598,9 @@ int tp_driver_close(tp_driver_t *driver)
 
     tp_driver_send_driver_shutdown(driver, tensor_pool_shutdownReason_NORMAL, NULL);
 
+    tp_driver_provision_close((tp_driver_provision_t *)driver->provisioner);
+    driver->provisioner = NULL;
+
     tp_fragment_assembler_close(&driver->control_assembler);
     tp_subscription_close(&driver->control_subscription);
     tp_publication_close(&driver->control_publication);
@@ -2252,6 +2627,11 @@ int tp_driver_close(tp_driver_t *driver)
     driver->node_id_cooldown_count = 0;
     driver->node_id_cooldown_capacity = 0;
 
+    free(driver->pending_attaches);
+    driver->pending_attaches = NULL;
+    driver->pending_attach_count = 0;
+    driver->pending_attach_capacity = 0;
+
     tp_driver_config_close(&driver->config);
     memset(driver, 0, sizeof(*driver));
     return 0;
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "tensor_pool/tp_error.h"
+#include "tensor_pool/tp_numa.h"
 #include "tensor_pool/tp_types.h"
 #include "tensor_pool/internal/tp_context.h"
 
@@ -632,6 +633,66 @@ static int tp_driver_load_allowed_base_dirs(tp_driver_config_t *config, toml_dat
     return 0;
 }
 
+static int tp_driver_load_numa(toml_datum_t table, const char *scope, tp_numa_policy_t *out, bool *configured)
+{
+    toml_datum_t mode_value = toml_get(table, "numa_policy");
+    toml_datum_t nodes_value = toml_get(table, "numa_nodes");
+    char mode_name[32] = {0};
+    tp_numa_policy_t policy;
+    int32_t i;
+
+    if (mode_value.type == TOML_UNKNOWN && nodes_value.type == TOML_UNKNOWN)
+    {
+        return 0;
+    }
+
+    memset(&policy, 0, sizeof(policy));
+    if (tp_driver_copy_string(mode_name, sizeof(mode_name), mode_value, "numa_policy", true) < 0)
+    {
+        return -1;
+    }
+    if (tp_numa_parse_mode(mode_name, &policy.mode) < 0)
+    {
+        return -1;
+    }
+
+    if (nodes_value.type != TOML_UNKNOWN)
+    {
+        if (nodes_value.type != TOML_ARRAY)
+        {
+            TP_SET_ERR(EINVAL, "tp_driver_config_load: %s.numa_nodes must be array", scope);
+            return -1;
+        }
+
+        for (i = 0; i < nodes_value.u.arr.size; i++)
+        {
+            toml_datum_t elem = nodes_value.u.arr.elem[i];
+
+            if (elem.type != TOML_INT64 || elem.u.int64 < 0 || elem.u.int64 >= TP_NUMA_MAX_NODES)
+            {
+                TP_SET_ERR(EINVAL, "tp_driver_config_load: %s.numa_nodes entries must be 0..%d",
+                    scope, TP_NUMA_MAX_NODES - 1);
+                return -1;
+            }
+            policy.nodes |= 1ULL << elem.u.int64;
+        }
+    }
+
+    if ((policy.mode == TP_NUMA_PREFERRED || policy.mode == TP_NUMA_BIND) && policy.nodes == 0)
+    {
+        TP_SET_ERR(EINVAL, "tp_driver_config_load: %s.numa_policy %s needs numa_nodes",
+            scope, tp_numa_mode_name(policy.mode));
+        return -1;
+    }
+
+    *out = policy;
+    if (NULL != configured)
+    {
+        *configured = true;
+    }
+    return 0;
+}
+
 static int tp_driver_load_profiles(tp_driver_config_t *config, toml_datum_t profiles)
 {
     int32_t i;
@@ -689,6 +750,11 @@ static int tp_driver_load_profiles(tp_driver_config_t *config, toml_datum_t prof
             return -1;
         }
 
+        if (tp_driver_load_numa(profile, "profiles.<name>", &dest->numa, NULL) < 0)
+        {
+            return -1;
+        }
+
         pools = toml_get(profile, "payload_pools");
         if (pools.type != TOML_ARRAY || pools.u.arr.size <= 0)
         {
@@ -838,6 +904,11 @@ static int tp_driver_load_streams(tp_driver_config_t *config, toml_datum_t strea
             }
         }
 
+        if (tp_driver_load_numa(stream, "streams.<name>", &dest->numa, &dest->numa_configured) < 0)
+        {
+            return -1;
+        }
+
         dest->stream_id = stream_id;
         count++;
     }
@@ -864,6 +935,7 @@ int tp_driver_config_init(tp_driver_config_t *config)
     strncpy(config->shm_base_dir, "/dev/shm", sizeof(config->shm_base_dir) - 1);
     strncpy(config->shm_namespace, "default", sizeof(config->shm_namespace) - 1);
     config->require_hugepages = false;
+    config->transparent_hugepages = false;
     config->page_size_bytes = 4096;
     config->permissions_mode = 0660;
     config->allow_dynamic_streams = false;
@@ -872,6 +944,8 @@ int tp_driver_config_init(tp_driver_config_t *config)
     config->lease_expiry_grace_intervals = 3;
     config->prefault_shm = true;
     config->mlock_shm = false;
+    config->provision_workers = 2;
+    config->spare_epochs = false;
     config->epoch_gc_enabled = true;
     config->epoch_gc_keep = 2;
     config->epoch_gc_on_startup = false;
@@ -1107,6 +1181,21 @@ int tp_driver_config_load(tp_driver_config_t *config, const char *path)
         return -1;
     }
 
+    if (tp_driver_copy_bool(&config->transparent_hugepages, toml_get(shm, "transparent_hugepages"),
+            "shm.transparent_hugepages", false) < 0)
+    {
+        toml_free(parsed);
+        return -1;
+    }
+
+    if (config->require_hugepages && config->transparent_hugepages)
+    {
+        TP_SET_ERR(EINVAL, "%s",
+            "tp_driver_config_load: shm.require_hugepages and shm.transparent_hugepages are exclusive");
+        toml_free(parsed);
+        return -1;
+    }
+
     if (tp_driver_copy_uint32(&config->page_size_bytes, toml_get(shm, "page_size_bytes"),
             "shm.page_size_bytes", false) < 0)
     {
@@ -1193,6 +1282,20 @@ int tp_driver_config_load(tp_driver_config_t *config, const char *path)
         return -1;
     }
 
+    if (tp_driver_copy_uint32(&config->provision_workers, toml_get(policies, "provision_workers"),
+            "policies.provision_workers", false) < 0)
+    {
+        toml_free(parsed);
+        return -1;
+    }
+
+    if (tp_driver_copy_bool(&config->spare_epochs, toml_get(policies, "spare_epochs"),
+            "policies.spare_epochs", false) < 0)
+    {
+        toml_free(parsed);
+        return -1;
+    }
+
     if (tp_driver_copy_bool(&config->epoch_gc_enabled, toml_get(policies, "epoch_gc_enabled"),
             "policies.epoch_gc_enabled", false) < 0)
     {
@@ -0,0 +1,662 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "tp_driver_provision.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "tensor_pool/tp_error.h"
+#include "tensor_pool/tp_numa.h"
+#include "tensor_pool/tp_shm.h"
+
+typedef struct tp_driver_provision_region_stct
+{
+    int fd;
+    size_t file_size;
+    size_t chunk_bytes;
+    bool transparent_hugepages;
+    uint32_t chunk_count;
+    _Atomic uint32_t chunks_left;
+    uint8_t superblock[TP_SUPERBLOCK_SIZE_BYTES];
+    char path[4096];
+}
+tp_driver_provision_region_t;
+
+typedef struct tp_driver_provision_batch_stct
+{
+    struct tp_driver_provision_batch_stct *next;
+    tp_driver_provision_region_t *regions;
+    size_t region_count;
+    _Atomic size_t regions_left;
+    tp_numa_policy_t numa;
+    bool complete;
+    tp_driver_provision_result_t result;
+}
+tp_driver_provision_batch_t;
+
+typedef struct tp_driver_provision_task_stct
+{
+    tp_driver_provision_batch_t *batch;
+    uint32_t region_index;
+    uint32_t chunk_index;
+}
+tp_driver_provision_task_t;
+
+/*
+ * Batches stay on one list from submit until poll hands them back, so close can release the
+ * files of epochs that were still building. Tasks are a FIFO ring guarded by the same lock.
+ */
+struct tp_driver_provision_stct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t *threads;
+    uint32_t worker_count;
+    uint32_t started;
+    size_t chunk_bytes;
+    bool prefault;
+    bool mlock_enabled;
+    bool stop;
+    tp_driver_provision_task_t *tasks;
+    size_t task_head;
+    size_t task_count;
+    size_t task_capacity;
+    tp_driver_provision_batch_t *batches;
+};
+
+static void tp_driver_provision_fail(
+    tp_driver_provision_t *pool,
+    tp_driver_provision_batch_t *batch,
+    int error,
+    const char *what,
+    const char *path)
+{
+    pthread_mutex_lock(&pool->lock);
+    if (batch->result.error == 0)
+    {
+        batch->result.error = error != 0 ? error : EIO;
+        snprintf(batch->result.message, sizeof(batch->result.message),
+            "tp_driver_provision: %s failed for %s", what, path);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+#if defined(__linux__)
+/* Records how much of a hugepage-advised chunk the kernel backed with hugepages. */
+static void tp_driver_provision_account_hugepages(
+    tp_driver_provision_t *pool,
+    tp_driver_provision_batch_t *batch,
+    void *addr,
+    size_t length,
+    bool advised)
+{
+    size_t huge_bytes = 0;
+    size_t resident_bytes = 0;
+
+    if (advised && tp_shm_hugepage_coverage(addr, length, &huge_bytes, &resident_bytes) < 0)
+    {
+        huge_bytes = 0;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    batch->result.hugepage_bytes += huge_bytes;
+    batch->result.hugepage_target_bytes +=
+        (length / TP_SHM_TRANSPARENT_HUGEPAGE_BYTES) * TP_SHM_TRANSPARENT_HUGEPAGE_BYTES;
+    pthread_mutex_unlock(&pool->lock);
+}
+#endif
+
+/*
+ * The NUMA policy is set through a mapping before any page is allocated; on tmpfs it sticks
+ * to the file range, so fallocate and later client faults land on the chosen nodes. Hugepage
+ * regions skip fallocate, which only allocates small pages unless the mount forces hugepages,
+ * and fault the chunk through the advised mapping instead.
+ */
+static int tp_driver_provision_touch(
+    tp_driver_provision_t *pool,
+    tp_driver_provision_batch_t *batch,
+    const tp_driver_provision_region_t *region,
+    size_t offset,
+    size_t length)
+{
+#if defined(__linux__)
+    bool allocated = false;
+    bool advised = false;
+    int flags = MAP_SHARED;
+    void *addr = MAP_FAILED;
+
+    if (batch->numa.mode != TP_NUMA_DEFAULT || region->transparent_hugepages)
+    {
+        addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, region->fd, (off_t)offset);
+        if (batch->numa.mode != TP_NUMA_DEFAULT &&
+            (addr == MAP_FAILED || tp_numa_apply(addr, length, &batch->numa) < 0))
+        {
+            pthread_mutex_lock(&pool->lock);
+            batch->result.numa_failed = true;
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+
+    if (region->transparent_hugepages)
+    {
+        if (addr == MAP_FAILED)
+        {
+            return -1;
+        }
+#ifdef MADV_HUGEPAGE
+        advised = madvise(addr, length, MADV_HUGEPAGE) == 0;
+#endif
+    }
+    else
+    {
+        allocated = posix_fallocate(region->fd, (off_t)offset, (off_t)length) == 0;
+        if (allocated && !pool->mlock_enabled)
+        {
+            if (addr != MAP_FAILED)
+            {
+                munmap(addr, length);
+            }
+            return 0;
+        }
+    }
+
+    if (addr == MAP_FAILED)
+    {
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;
+#endif
+        addr = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, region->fd, (off_t)offset);
+        if (addr == MAP_FAILED)
+        {
+            return -1;
+        }
+    }
+
+    if (!allocated)
+    {
+        memset(addr, 0, length);
+    }
+
+    if (region->transparent_hugepages)
+    {
+        tp_driver_provision_account_hugepages(pool, batch, addr, length, advised);
+    }
+
+    if (pool->mlock_enabled && mlock(addr, length) != 0)
+    {
+        int err = errno;
+        munmap(addr, length);
+        errno = err;
+        return -1;
+    }
+
+    munmap(addr, length);
+    return 0;
+#else
+    (void)pool;
+    (void)batch;
+    (void)region;
+    (void)offset;
+    (void)length;
+    return 0;
+#endif
+}
+
+static void tp_driver_provision_finish_region(
+    tp_driver_provision_t *pool,
+    tp_driver_provision_batch_t *batch,
+    tp_driver_provision_region_t *region)
+{
+    bool failed;
+
+    pthread_mutex_lock(&pool->lock);
+    failed = batch->result.error != 0;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (!failed)
+    {
+        if (pwrite(region->fd, region->superblock, sizeof(region->superblock), 0) !=
+            (ssize_t)sizeof(region->superblock))
+        {
+            tp_driver_provision_fail(pool, batch, errno, "superblock write", region->path);
+        }
+        else if (fsync(region->fd) != 0)
+        {
+            tp_driver_provision_fail(pool, batch, errno, "fsync", region->path);
+        }
+    }
+
+    close(region->fd);
+    region->fd = -1;
+}
+
+static void tp_driver_provision_run(tp_driver_provision_t *pool, const tp_driver_provision_task_t *task)
+{
+    tp_driver_provision_batch_t *batch = task->batch;
+    tp_driver_provision_region_t *region = &batch->regions[task->region_index];
+
+    if (region->chunk_count > 0)
+    {
+        size_t offset = (size_t)task->chunk_index * region->chunk_bytes;
+        size_t length = region->file_size - offset;
+
+        if (length > region->chunk_bytes)
+        {
+            length = region->chunk_bytes;
+        }
+
+        if (tp_driver_provision_touch(pool, batch, region, offset, length) < 0)
+        {
+            if (pool->mlock_enabled)
+            {
+                tp_driver_provision_fail(pool, batch, errno, "mlock", region->path);
+            }
+            else
+            {
+                pthread_mutex_lock(&pool->lock);
+                batch->result.prefault_failed = true;
+                pthread_mutex_unlock(&pool->lock);
+            }
+        }
+    }
+
+    if (atomic_fetch_sub_explicit(&region->chunks_left, 1, memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    tp_driver_provision_finish_region(pool, batch, region);
+
+    if (atomic_fetch_sub_explicit(&batch->regions_left, 1, memory_order_acq_rel) == 1)
+    {
+        pthread_mutex_lock(&pool->lock);
+        batch->complete = true;
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void *tp_driver_provision_worker(void *arg)
+{
+    tp_driver_provision_t *pool = (tp_driver_provision_t *)arg;
+
+    for (;;)
+    {
+        tp_driver_provision_task_t task;
+
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->task_count == 0)
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        task = pool->tasks[pool->task_head];
+        pool->task_head = (pool->task_head + 1) % pool->task_capacity;
+        pool->task_count--;
+        pthread_mutex_unlock(&pool->lock);
+
+        tp_driver_provision_run(pool, &task);
+    }
+
+    return NULL;
+}
+
+static int tp_driver_provision_reserve(tp_driver_provision_t *pool, size_t extra)
+{
+    tp_driver_provision_task_t *tasks;
+    size_t capacity;
+    size_t i;
+
+    if (pool->task_count + extra <= pool->task_capacity)
+    {
+        return 0;
+    }
+
+    capacity = pool->task_capacity == 0 ? 64 : pool->task_capacity;
+    while (capacity < pool->task_count + extra)
+    {
+        capacity *= 2;
+    }
+
+    tasks = (tp_driver_provision_task_t *)calloc(capacity, sizeof(*tasks));
+    if (NULL == tasks)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_driver_provision_submit: task allocation failed");
+        return -1;
+    }
+
+    for (i = 0; i < pool->task_count; i++)
+    {
+        tasks[i] = pool->tasks[(pool->task_head + i) % pool->task_capacity];
+    }
+
+    free(pool->tasks);
+    pool->tasks = tasks;
+    pool->task_head = 0;
+    pool->task_capacity = capacity;
+    return 0;
+}
+
+static void tp_driver_provision_free_batch(tp_driver_provision_batch_t *batch)
+{
+    size_t i;
+
+    for (i = 0; i < batch->region_count; i++)
+    {
+        if (batch->regions[i].fd >= 0)
+        {
+            close(batch->regions[i].fd);
+        }
+    }
+
+    free(batch->regions);
+    free(batch);
+}
+
+int tp_driver_provision_init(
+    tp_driver_provision_t **pool,
+    uint32_t worker_threads,
+    size_t chunk_bytes,
+    bool prefault,
+    bool mlock_enabled)
+{
+    tp_driver_provision_t *instance;
+    uint32_t i;
+
+    if (NULL == pool)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_driver_provision_init: null pool");
+        return -1;
+    }
+
+    *pool = NULL;
+    instance = (tp_driver_provision_t *)calloc(1, sizeof(*instance));
+    if (NULL == instance)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_driver_provision_init: allocation failed");
+        return -1;
+    }
+
+    if (worker_threads > 0)
+    {
+        instance->threads = (pthread_t *)calloc(worker_threads, sizeof(pthread_t));
+        if (NULL == instance->threads)
+        {
+            free(instance);
+            TP_SET_ERR(ENOMEM, "%s", "tp_driver_provision_init: allocation failed");
+            return -1;
+        }
+    }
+
+    instance->chunk_bytes = chunk_bytes == 0 ? TP_DRIVER_PROVISION_CHUNK_BYTES_DEFAULT : chunk_bytes;
+    instance->worker_count = worker_threads;
+    instance->prefault = prefault;
+    instance->mlock_enabled = mlock_enabled;
+    pthread_mutex_init(&instance->lock, NULL);
+    pthread_cond_init(&instance->wake, NULL);
+
+    for (i = 0; i < worker_threads; i++)
+    {
+        int err = pthread_create(&instance->threads[i], NULL, tp_driver_provision_worker, instance);
+        if (err != 0)
+        {
+            tp_driver_provision_close(instance);
+            TP_SET_ERR(err, "%s", "tp_driver_provision_init: pthread_create failed");
+            return -1;
+        }
+        instance->started++;
+    }
+
+    *pool = instance;
+    return 0;
+}
+
+void tp_driver_provision_close(tp_driver_provision_t *pool)
+{
+    tp_driver_provision_batch_t *batch;
+    uint32_t i;
+
+    if (NULL == pool)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->started; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    batch = pool->batches;
+    while (NULL != batch)
+    {
+        tp_driver_provision_batch_t *next = batch->next;
+        tp_driver_provision_free_batch(batch);
+        batch = next;
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->tasks);
+    free(pool->threads);
+    free(pool);
+}
+
+int tp_driver_provision_submit(
+    tp_driver_provision_t *pool,
+    uint32_t stream_id,
+    uint64_t epoch,
+    const tp_driver_region_spec_t *regions,
+    size_t region_count,
+    const tp_numa_policy_t *numa)
+{
+    tp_driver_provision_batch_t *batch;
+    tp_driver_provision_batch_t **tail;
+    size_t task_total = 0;
+    size_t i;
+
+    if (NULL == pool || NULL == regions || region_count == 0)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_driver_provision_submit: invalid input");
+        return -1;
+    }
+
+    batch = (tp_driver_provision_batch_t *)calloc(1, sizeof(*batch));
+    if (NULL == batch)
+    {
+        TP_SET_ERR(ENOMEM, "%s", "tp_driver_provision_submit: allocation failed");
+        return -1;
+    }
+
+    batch->regions = (tp_driver_provision_region_t *)calloc(region_count, sizeof(*batch->regions));
+    if (NULL == batch->regions)
+    {
+        free(batch);
+        TP_SET_ERR(ENOMEM, "%s", "tp_driver_provision_submit: allocation failed");
+        return -1;
+    }
+
+    batch->region_count = region_count;
+    batch->result.stream_id = stream_id;
+    batch->result.epoch = epoch;
+    if (NULL != numa)
+    {
+        batch->numa = *numa;
+    }
+    atomic_init(&batch->regions_left, region_count);
+    for (i = 0; i < region_count; i++)
+    {
+        batch->regions[i].fd = -1;
+    }
+
+    for (i = 0; i < region_count; i++)
+    {
+        tp_driver_provision_region_t *region = &batch->regions[i];
+        uint64_t chunks = 0;
+
+        memcpy(region->path, regions[i].path, sizeof(region->path));
+        region->path[sizeof(region->path) - 1] = '\0';
+        memcpy(region->superblock, regions[i].superblock, sizeof(region->superblock));
+        region->file_size = regions[i].file_size;
+        region->transparent_hugepages = regions[i].transparent_hugepages;
+        region->chunk_bytes = pool->chunk_bytes;
+        if (region->transparent_hugepages)
+        {
+            /* Chunks start on hugepage boundaries so each one can be backed by whole hugepages. */
+            region->chunk_bytes = ((pool->chunk_bytes + TP_SHM_TRANSPARENT_HUGEPAGE_BYTES - 1) /
+                TP_SHM_TRANSPARENT_HUGEPAGE_BYTES) * TP_SHM_TRANSPARENT_HUGEPAGE_BYTES;
+        }
+
+        region->fd = open(region->path, O_RDWR | O_CREAT | O_TRUNC, (mode_t)regions[i].file_mode);
+        if (region->fd < 0)
+        {
+            TP_SET_ERR(errno, "tp_driver_provision_submit: open failed for %s", region->path);
+            tp_driver_provision_free_batch(batch);
+            return -1;
+        }
+
+        if (ftruncate(region->fd, (off_t)region->file_size) != 0)
+        {
+            TP_SET_ERR(errno, "tp_driver_provision_submit: ftruncate failed for %s", region->path);
+            tp_driver_provision_free_batch(batch);
+            return -1;
+        }
+
+        if (pool->prefault && region->file_size > 0)
+        {
+            chunks = (region->file_size + region->chunk_bytes - 1) / region->chunk_bytes;
+            if (chunks > UINT32_MAX)
+            {
+                TP_SET_ERR(EINVAL, "tp_driver_provision_submit: region too large for %s", region->path);
+                tp_driver_provision_free_batch(batch);
+                return -1;
+            }
+        }
+
+        region->chunk_count = (uint32_t)chunks;
+        atomic_init(&region->chunks_left, chunks > 0 ? (uint32_t)chunks : 1u);
+        task_total += chunks > 0 ? (size_t)chunks : 1u;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (tp_driver_provision_reserve(pool, task_total) < 0)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        tp_driver_provision_free_batch(batch);
+        return -1;
+    }
+
+    tail = &pool->batches;
+    while (NULL != *tail)
+    {
+        tail = &(*tail)->next;
+    }
+    *tail = batch;
+
+    for (i = 0; i < region_count; i++)
+    {
+        uint32_t count = batch->regions[i].chunk_count > 0 ? batch->regions[i].chunk_count : 1u;
+        uint32_t chunk;
+
+        for (chunk = 0; chunk < count; chunk++)
+        {
+            tp_driver_provision_task_t *task =
+                &pool->tasks[(pool->task_head + pool->task_count) % pool->task_capacity];
+            task->batch = batch;
+            task->region_index = (uint32_t)i;
+            task->chunk_index = chunk;
+            pool->task_count++;
+        }
+    }
+
+    if (pool->worker_count > 0)
+    {
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+        return 0;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    /* Without workers the caller drains the queue itself, which holds only this batch. */
+    for (;;)
+    {
+        tp_driver_provision_task_t task;
+
+        pthread_mutex_lock(&pool->lock);
+        if (pool->task_count == 0)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        task = pool->tasks[pool->task_head];
+        pool->task_head = (pool->task_head + 1) % pool->task_capacity;
+        pool->task_count--;
+        pthread_mutex_unlock(&pool->lock);
+
+        tp_driver_provision_run(pool, &task);
+    }
+
+    return 0;
+}
+
+int tp_driver_provision_poll(tp_driver_provision_t *pool, tp_driver_provision_result_t *result)
+{
+    tp_driver_provision_batch_t **link;
+    tp_driver_provision_batch_t *batch = NULL;
+
+    if (NULL == pool || NULL == result)
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_driver_provision_poll: null input");
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    for (link = &pool->batches; NULL != *link; link = &(*link)->next)
+    {
+        if ((*link)->complete)
+        {
+            batch = *link;
+            *link = batch->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (NULL == batch)
+    {
+        return 0;
+    }
+
+    *result = batch->result;
+    tp_driver_provision_free_batch(batch);
+    return 1;
+}
+
+uint32_t tp_driver_provision_worker_count(const tp_driver_provision_t *pool)
+{
+    return NULL == pool ? 0 : pool->worker_count;
+}
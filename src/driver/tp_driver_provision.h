@@ -0,0 +1,75 @@
+#ifndef TENSOR_POOL_TP_DRIVER_PROVISION_H
+#define TENSOR_POOL_TP_DRIVER_PROVISION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensor_pool/tp_numa.h"
+#include "tensor_pool/tp_types.h"
+
+#define TP_DRIVER_PROVISION_CHUNK_BYTES_DEFAULT (64u * 1024u * 1024u)
+
+typedef struct tp_driver_provision_stct tp_driver_provision_t;
+
+typedef struct tp_driver_region_spec_stct
+{
+    char path[4096];
+    size_t file_size;
+    uint32_t file_mode;
+    bool transparent_hugepages;
+    uint8_t superblock[TP_SUPERBLOCK_SIZE_BYTES];
+}
+tp_driver_region_spec_t;
+
+typedef struct tp_driver_provision_result_stct
+{
+    uint32_t stream_id;
+    uint64_t epoch;
+    int error;
+    bool prefault_failed;
+    bool numa_failed;
+    uint64_t hugepage_bytes;
+    uint64_t hugepage_target_bytes;
+    char message[512];
+}
+tp_driver_provision_result_t;
+
+/*
+ * Worker threads that build the region files of an epoch off the driver loop. Each region is
+ * split into chunk_bytes pieces that the workers prefault in parallel, using posix_fallocate
+ * and falling back to touching the pages through a MAP_POPULATE mapping; the superblock is
+ * written and the file fsynced once its last chunk is done. chunk_bytes must be a multiple of
+ * the backing page size. With no workers, submit builds the epoch before returning.
+ * A NUMA policy given at submit is applied to each chunk before it is prefaulted; when the
+ * host cannot honour it the regions are still built and numa_failed is reported.
+ * Regions marked transparent_hugepages are advised MADV_HUGEPAGE and faulted through that
+ * mapping in hugepage-aligned chunks; hugepage_bytes reports how much of hugepage_target_bytes
+ * the kernel actually backed with hugepages.
+ */
+int tp_driver_provision_init(
+    tp_driver_provision_t **pool,
+    uint32_t worker_threads,
+    size_t chunk_bytes,
+    bool prefault,
+    bool mlock_enabled);
+void tp_driver_provision_close(tp_driver_provision_t *pool);
+
+/*
+ * Creates and sizes every region file, then queues the prefault and superblock work. Failures
+ * to open or size a file are reported here; later failures arrive through poll.
+ */
+int tp_driver_provision_submit(
+    tp_driver_provision_t *pool,
+    uint32_t stream_id,
+    uint64_t epoch,
+    const tp_driver_region_spec_t *regions,
+    size_t region_count,
+    const tp_numa_policy_t *numa);
+
+/* Returns 1 and fills result when an epoch finished building, 0 when none has. */
+int tp_driver_provision_poll(tp_driver_provision_t *pool, tp_driver_provision_result_t *result);
+
+uint32_t tp_driver_provision_worker_count(const tp_driver_provision_t *pool);
+
+#endif
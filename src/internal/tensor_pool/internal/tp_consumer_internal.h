@@ -1,12 +1,50 @@
 #ifndef TENSOR_POOL_TP_CONSUMER_INTERNAL_H
 #define TENSOR_POOL_TP_CONSUMER_INTERNAL_H
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "aeronc.h"
+
 #include "tensor_pool/client/tp_consumer.h"
 #include "tensor_pool/internal/tp_progress_poller.h"
 
+/*
+ * Decoded and validated header for one header-ring slot, valid while the slot still holds
+ * seq_commit. seq_commit is 0 while the entry is empty or being rewritten.
+ */
+typedef struct tp_consumer_header_cache_entry_stct
+{
+    _Atomic uint64_t seq_commit;
+    _Atomic bool filling;
+    tp_tensor_header_t tensor;
+    uint32_t values_len_bytes;
+    uint32_t payload_slot;
+    uint16_t pool_id;
+    uint64_t timestamp_ns;
+    uint32_t meta_version;
+    const uint8_t *payload;
+}
+tp_consumer_header_cache_entry_t;
+
+/*
+ * One epoch's mapped regions. The current mapping's fields live on the consumer; when it is
+ * replaced or unmapped they move here and the regions stay mapped until holds drops to zero.
+ */
+struct tp_consumer_mapping_stct
+{
+    _Atomic uint32_t holds;
+    uint64_t epoch;
+    uint32_t layout_version;
+    uint32_t header_nslots;
+    tp_shm_region_t header_region;
+    tp_consumer_pool_t *pools;
+    size_t pool_count;
+    tp_consumer_header_cache_entry_t *header_cache;
+    struct tp_consumer_mapping_stct *next;
+};
+
 struct tp_consumer_stct
 {
     tp_client_t *client;
@@ -32,7 +70,17 @@ struct tp_consumer_stct
     uint64_t epoch;
     uint32_t layout_version;
     uint32_t header_nslots;
+    tp_consumer_header_cache_entry_t *header_cache;
+    tp_consumer_mapping_t *mapping;
+    tp_consumer_mapping_t *retired_mappings;
+    uint64_t retired_epoch;
+    bool has_retired_epoch;
+    uint64_t remap_started_ns;
+    uint64_t remap_count;
+    uint64_t remap_gap_last_ns;
+    uint64_t remap_gap_max_ns;
     uint64_t next_seq;
+    bool ring_primed;
     tp_driver_client_t *driver;
     tp_driver_attach_info_t driver_attach;
     bool driver_initialized;
@@ -46,7 +94,24 @@ struct tp_consumer_stct
     uint64_t last_seq_seen;
     uint64_t drops_gap;
     uint64_t drops_late;
+    uint64_t drops_conflated;
+    tp_frame_descriptor_t pending_latest;
+    bool has_pending_latest;
+    uint64_t latest_read_seq;
+    bool has_latest_read;
+    uint64_t frames_rate_limited;
+    uint64_t last_rate_gate_ns;
+    bool has_rate_gate;
+    tp_copy_fn_t payload_copy;
+    tp_frame_descriptor_t *batch_descriptors;
+    size_t batch_count;
+    size_t batch_capacity;
     uint64_t last_qos_ns;
+    tp_latency_histogram_t *arrival_latency;
+    tp_latency_histogram_t *read_latency;
+    uint64_t descriptor_rx_ns;
+    uint64_t descriptor_rx_seq;
+    bool has_descriptor_rx;
     uint64_t announce_join_time_ns;
     uint64_t last_announce_rx_ns;
     uint64_t last_announce_timestamp_ns;
@@ -58,4 +123,13 @@ struct tp_consumer_stct
     bool conductor_poll_registered;
 };
 
+/*
+ * Fragment handlers and per-poll housekeeping, shared with tp_consumer_group so a group can
+ * poll one subscription on behalf of many consumers.
+ */
+void tp_consumer_descriptor_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header);
+void tp_consumer_control_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header);
+void tp_consumer_finish_descriptor_poll(tp_consumer_t *consumer);
+void tp_consumer_finish_control_poll(tp_consumer_t *consumer, uint64_t now_ns);
+
 #endif
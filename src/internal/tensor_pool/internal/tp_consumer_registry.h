@@ -7,6 +7,7 @@
 
 #include "tensor_pool/internal/tp_control_adapter.h"
 #include "tensor_pool/tp_handles.h"
+#include "tensor_pool/tp_latency.h"
 #include "tensor_pool/tp_types.h"
 
 #ifdef __cplusplus
@@ -21,30 +22,48 @@ typedef struct tp_progress_policy_stct
 }
 tp_progress_policy_t;
 
+/*
+ * Per-frame fan-out state. Active consumers are packed densely at the front of
+ * registry->active so the descriptor path touches only these few cache lines.
+ */
+typedef struct tp_consumer_hot_stct
+{
+    tp_publication_t *descriptor_publication;
+    tp_publication_t *control_publication;
+    uint64_t last_descriptor_ns;
+    uint64_t descriptor_interval_ns;
+    uint32_t consumer_id;
+    uint32_t max_rate_hz;
+    uint32_t entry_index;
+    uint8_t mode;
+}
+tp_consumer_hot_t;
+
 typedef struct tp_consumer_entry_stct
 {
     bool in_use;
     uint32_t consumer_id;
     uint64_t last_seen_ns;
-    uint8_t mode;
-    uint32_t max_rate_hz;
     uint8_t supports_progress;
     uint32_t progress_interval_us;
     uint32_t progress_bytes_delta;
     uint32_t progress_major_delta_units;
     uint32_t descriptor_stream_id;
-    char descriptor_channel[TP_URI_MAX_LENGTH];
     uint32_t control_stream_id;
+    tp_consumer_hot_t *hot;
+    tp_latency_summary_t arrival_latency;
+    tp_latency_summary_t read_latency;
+    uint64_t last_latency_ns;
+    char descriptor_channel[TP_URI_MAX_LENGTH];
     char control_channel[TP_URI_MAX_LENGTH];
-    uint64_t last_descriptor_ns;
-    tp_publication_t *descriptor_publication;
-    tp_publication_t *control_publication;
 }
 tp_consumer_entry_t;
 
 typedef struct tp_consumer_registry_stct
 {
     tp_consumer_entry_t *entries;
+    tp_consumer_hot_t *active;
+    size_t active_count;
     size_t capacity;
 }
 tp_consumer_registry_t;
@@ -67,6 +86,7 @@ int tp_consumer_registry_update(
     uint64_t now_ns,
     tp_consumer_entry_t **out_entry);
 int tp_consumer_registry_sweep(tp_consumer_registry_t *registry, uint64_t now_ns, uint64_t stale_ns);
+tp_consumer_entry_t *tp_consumer_registry_find(tp_consumer_registry_t *registry, uint32_t consumer_id);
 
 int tp_consumer_registry_aggregate_progress(
     const tp_consumer_registry_t *registry,
@@ -1,6 +1,7 @@
 #ifndef TENSOR_POOL_TP_PRODUCER_INTERNAL_H
 #define TENSOR_POOL_TP_PRODUCER_INTERNAL_H
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -9,6 +10,22 @@
 
 typedef struct tp_consumer_manager_stct tp_consumer_manager_t;
 typedef struct tp_tracelink_entry_stct tp_tracelink_entry_t;
+typedef struct tp_copy_pool_stct tp_copy_pool_t;
+
+/*
+ * Reorder window slot for concurrent claims: state holds (seq << 1) | aborted once the claim
+ * for seq has been committed or aborted, and UINT64_MAX while empty.
+ */
+typedef struct tp_producer_reorder_entry_stct
+{
+    _Atomic uint64_t state;
+    uint32_t meta_version;
+    uint64_t trace_id;
+}
+tp_producer_reorder_entry_t;
+
+/* Length-prefixed encoded TensorHeader as stored in the slot var-data field. */
+enum { TP_TENSOR_HEADER_IMAGE_BYTES = 128 };
 
 struct tp_producer_stct
 {
@@ -31,7 +48,7 @@ struct tp_producer_stct
     uint64_t epoch;
     uint32_t layout_version;
     uint32_t header_nslots;
-    uint64_t next_seq;
+    _Atomic uint64_t next_seq;
     tp_driver_client_t *driver;
     tp_driver_attach_info_t driver_attach;
     bool driver_initialized;
@@ -49,6 +66,16 @@ struct tp_producer_stct
     tp_meta_attribute_owned_t *cached_attrs;
     size_t cached_attr_count;
     bool has_meta;
+    tp_tensor_header_t cached_tensor;
+    uint8_t cached_tensor_image[TP_TENSOR_HEADER_IMAGE_BYTES];
+    uint32_t cached_tensor_image_len;
+    bool has_cached_tensor;
+    tp_copy_fn_t payload_copy;
+    tp_copy_pool_t *copy_pool;
+    tp_producer_reorder_entry_t *reorder_entries;
+    uint64_t reorder_mask;
+    _Atomic uint64_t reorder_next_seq;
+    _Atomic bool reorder_draining;
     tp_trace_id_generator_t *trace_id_generator;
     tp_tracelink_entry_t *tracelink_entries;
     size_t tracelink_entry_count;
@@ -60,4 +87,14 @@ struct tp_producer_stct
     bool conductor_poll_registered;
 };
 
+#if defined(TP_ENABLE_FUZZ) || defined(TP_TESTING)
+int tp_producer_encode_tensor_header_for_test(uint8_t *buffer, size_t buffer_len, const tp_tensor_header_t *tensor);
+int tp_producer_prepare_tensor_header_for_test(
+    tp_producer_t *producer,
+    const tp_tensor_header_t *tensor,
+    tp_tensor_header_t *out);
+void tp_producer_zero_slot_padding_for_test(uint8_t *slot);
+tp_payload_pool_t *tp_producer_find_pool_for_length_for_test(tp_producer_t *producer, size_t length);
+#endif
+
 #endif
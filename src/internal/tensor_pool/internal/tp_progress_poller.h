@@ -62,9 +62,8 @@ void tp_progress_poller_set_validator(
 void tp_progress_poller_set_consumer(tp_progress_poller_t *poller, tp_consumer_t *consumer);
 int tp_progress_poll(tp_progress_poller_t *poller, int fragment_limit);
 
-#if defined(TP_ENABLE_FUZZ) || defined(TP_TESTING)
+/* Feeds one fragment polled elsewhere, e.g. by a consumer group sharing the control stream. */
 void tp_progress_poller_handle_fragment(tp_progress_poller_t *poller, const uint8_t *buffer, size_t length);
-#endif
 
 #ifdef __cplusplus
 }
@@ -20,6 +20,8 @@ int tp_qos_publish_consumer(
     uint64_t drops_gap,
     uint64_t drops_late,
     tp_mode_t mode);
+/* Summarizes the consumer's latency histograms into a QosConsumerLatency message. */
+int tp_qos_publish_consumer_latency(tp_consumer_t *consumer, uint32_t consumer_id);
 
 typedef struct tp_qos_poller_stct
 {
@@ -23,6 +23,7 @@
 #include "wire/tensor_pool/dataSourceMeta.h"
 #include "wire/tensor_pool/messageHeader.h"
 #include "wire/tensor_pool/qosConsumer.h"
+#include "wire/tensor_pool/qosConsumerLatency.h"
 #include "wire/tensor_pool/qosProducer.h"
 #include "wire/tensor_pool/shmPoolAnnounce.h"
 
@@ -276,6 +277,56 @@ static void tp_supervisor_on_control_fragment(void *clientd, const uint8_t *buff
     }
 }
 
+static void tp_supervisor_on_qos_latency(
+    tp_supervisor_t *supervisor,
+    const uint8_t *buffer,
+    size_t length,
+    uint16_t block_length,
+    uint16_t version)
+{
+    struct tensor_pool_qosConsumerLatency qos;
+    tp_consumer_registry_t *registry;
+    tp_consumer_entry_t *entry;
+
+    if (length < tensor_pool_messageHeader_encoded_length() + tensor_pool_qosConsumerLatency_sbe_block_length())
+    {
+        return;
+    }
+
+    tensor_pool_qosConsumerLatency_wrap_for_decode(
+        &qos,
+        (char *)buffer,
+        tensor_pool_messageHeader_encoded_length(),
+        block_length,
+        version,
+        length);
+    supervisor->qos_latency_count++;
+
+    registry = tp_supervisor_registry(supervisor);
+    if (registry == NULL || registry->entries == NULL)
+    {
+        return;
+    }
+
+    entry = tp_consumer_registry_find(registry, tensor_pool_qosConsumerLatency_consumerId(&qos));
+    if (NULL == entry)
+    {
+        return;
+    }
+
+    entry->last_latency_ns = (uint64_t)tp_clock_now_ns();
+    entry->arrival_latency.count = tensor_pool_qosConsumerLatency_arrivalCount(&qos);
+    entry->arrival_latency.p50_ns = tensor_pool_qosConsumerLatency_arrivalP50Ns(&qos);
+    entry->arrival_latency.p90_ns = tensor_pool_qosConsumerLatency_arrivalP90Ns(&qos);
+    entry->arrival_latency.p99_ns = tensor_pool_qosConsumerLatency_arrivalP99Ns(&qos);
+    entry->arrival_latency.max_ns = tensor_pool_qosConsumerLatency_arrivalMaxNs(&qos);
+    entry->read_latency.count = tensor_pool_qosConsumerLatency_readCount(&qos);
+    entry->read_latency.p50_ns = tensor_pool_qosConsumerLatency_readP50Ns(&qos);
+    entry->read_latency.p90_ns = tensor_pool_qosConsumerLatency_readP90Ns(&qos);
+    entry->read_latency.p99_ns = tensor_pool_qosConsumerLatency_readP99Ns(&qos);
+    entry->read_latency.max_ns = tensor_pool_qosConsumerLatency_readMaxNs(&qos);
+}
+
 static void tp_supervisor_on_qos_fragment(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
 {
     tp_supervisor_t *supervisor = (tp_supervisor_t *)clientd;
@@ -288,7 +339,7 @@ static void tp_supervisor_on_qos_fragment(void *clientd, const uint8_t *buffer,
     uint32_t consumer_id;
     uint64_t now_ns;
     tp_consumer_registry_t *registry;
-    size_t i;
+    tp_consumer_entry_t *entry;
 
     (void)header;
 
@@ -315,6 +366,13 @@ static void tp_supervisor_on_qos_fragment(void *clientd, const uint8_t *buffer,
         return;
     }
 
+    if (schema_id == tensor_pool_qosConsumerLatency_sbe_schema_id() &&
+        template_id == tensor_pool_qosConsumerLatency_sbe_template_id())
+    {
+        tp_supervisor_on_qos_latency(supervisor, buffer, length, block_length, version);
+        return;
+    }
+
     if (schema_id != tensor_pool_qosConsumer_sbe_schema_id() ||
         template_id != tensor_pool_qosConsumer_sbe_template_id())
     {
@@ -339,14 +397,10 @@ static void tp_supervisor_on_qos_fragment(void *clientd, const uint8_t *buffer,
         return;
     }
 
-    for (i = 0; i < registry->capacity; i++)
+    entry = tp_consumer_registry_find(registry, consumer_id);
+    if (NULL != entry)
     {
-        tp_consumer_entry_t *entry = &registry->entries[i];
-        if (entry->in_use && entry->consumer_id == consumer_id)
-        {
-            entry->last_seen_ns = now_ns;
-            return;
-        }
+        entry->last_seen_ns = now_ns;
     }
 }
 
@@ -570,7 +624,63 @@ int tp_supervisor_get_stats(const tp_supervisor_t *supervisor, tp_supervisor_sta
     out->config_count = supervisor->config_count;
     out->qos_consumer_count = supervisor->qos_consumer_count;
     out->qos_producer_count = supervisor->qos_producer_count;
+    out->qos_latency_count = supervisor->qos_latency_count;
     out->announce_count = supervisor->announce_count;
     out->metadata_count = supervisor->metadata_count;
     return 0;
 }
+
+int tp_supervisor_rank_consumers_by_latency(
+    tp_supervisor_t *supervisor,
+    tp_supervisor_consumer_latency_t *out,
+    size_t capacity)
+{
+    tp_consumer_registry_t *registry;
+    size_t count = 0;
+    size_t i;
+
+    if (NULL == supervisor || (NULL == out && capacity > 0))
+    {
+        TP_SET_ERR(EINVAL, "%s", "tp_supervisor_rank_consumers_by_latency: null input");
+        return -1;
+    }
+
+    registry = tp_supervisor_registry(supervisor);
+    if (NULL == registry || NULL == registry->entries || capacity == 0)
+    {
+        return 0;
+    }
+
+    /* Insertion into a bounded, sorted output keeps the worst capacity consumers. */
+    for (i = 0; i < registry->capacity; i++)
+    {
+        const tp_consumer_entry_t *entry = &registry->entries[i];
+        size_t pos;
+
+        if (!entry->in_use || entry->last_latency_ns == 0)
+        {
+            continue;
+        }
+
+        pos = count;
+        while (pos > 0 && out[pos - 1].read.p99_ns < entry->read_latency.p99_ns)
+        {
+            pos--;
+        }
+        if (pos >= capacity)
+        {
+            continue;
+        }
+        if (count < capacity)
+        {
+            count++;
+        }
+        memmove(&out[pos + 1], &out[pos], (count - 1 - pos) * sizeof(*out));
+        out[pos].consumer_id = entry->consumer_id;
+        out[pos].last_report_ns = entry->last_latency_ns;
+        out[pos].arrival = entry->arrival_latency;
+        out[pos].read = entry->read_latency;
+    }
+
+    return (int)count;
+}
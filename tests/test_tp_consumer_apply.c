@@ -1,12 +1,67 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "tensor_pool/internal/tp_client_internal.h"
 #include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/internal/tp_producer_internal.h"
+#include "tensor_pool/tp_clock.h"
 #include "tensor_pool/tp_context.h"
 #include "tensor_pool/internal/tp_control_adapter.h"
 
+#include "aeron_alloc.h"
+#include "wire/tensor_pool/regionType.h"
+#include "wire/tensor_pool/shmRegionSuperblock.h"
+
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 int tp_consumer_apply_announce_for_test(tp_consumer_t *consumer, const tp_shm_pool_announce_view_t *announce);
+int tp_producer_publish_frame(
+    tp_producer_t *producer,
+    uint64_t seq,
+    const tp_tensor_header_t *tensor,
+    const void *payload,
+    uint32_t payload_len,
+    uint16_t pool_id,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id);
+
+static void tp_test_write_superblock(
+    int fd,
+    uint32_t stream_id,
+    uint64_t epoch,
+    int16_t region_type,
+    uint16_t pool_id,
+    uint32_t nslots,
+    uint32_t slot_bytes,
+    uint32_t stride_bytes)
+{
+    uint8_t buffer[TP_SUPERBLOCK_SIZE_BYTES];
+    struct tensor_pool_shmRegionSuperblock block;
+
+    memset(buffer, 0, sizeof(buffer));
+
+    tensor_pool_shmRegionSuperblock_wrap_for_encode(&block, (char *)buffer, 0, sizeof(buffer));
+    tensor_pool_shmRegionSuperblock_set_magic(&block, TP_MAGIC_U64);
+    tensor_pool_shmRegionSuperblock_set_layoutVersion(&block, 1);
+    tensor_pool_shmRegionSuperblock_set_epoch(&block, epoch);
+    tensor_pool_shmRegionSuperblock_set_streamId(&block, stream_id);
+    tensor_pool_shmRegionSuperblock_set_regionType(&block, region_type);
+    tensor_pool_shmRegionSuperblock_set_poolId(&block, pool_id);
+    tensor_pool_shmRegionSuperblock_set_nslots(&block, nslots);
+    tensor_pool_shmRegionSuperblock_set_slotBytes(&block, slot_bytes);
+    tensor_pool_shmRegionSuperblock_set_strideBytes(&block, stride_bytes);
+    tensor_pool_shmRegionSuperblock_set_pid(&block, (uint64_t)getpid());
+    tensor_pool_shmRegionSuperblock_set_startTimestampNs(&block, 1);
+    tensor_pool_shmRegionSuperblock_set_activityTimestampNs(&block, (uint64_t)tp_clock_now_ns());
+
+    assert(pwrite(fd, buffer, sizeof(buffer), 0) == (ssize_t)sizeof(buffer));
+}
 
 void tp_test_consumer_fallback_invalid_announce(void)
 {
@@ -119,3 +174,239 @@ void tp_test_consumer_fallback_layout_version(void)
 cleanup:
     assert(result == 0);
 }
+
+typedef struct tp_test_remap_epoch_stct
+{
+    char header_path[64];
+    char pool_path[64];
+    char header_uri[128];
+    char pool_uri[128];
+    tp_shm_pool_desc_t pool;
+    tp_shm_pool_announce_view_t announce;
+}
+tp_test_remap_epoch_t;
+
+static int tp_test_remap_epoch_create(tp_test_remap_epoch_t *epoch_files, uint32_t stream_id, uint64_t epoch)
+{
+    int header_fd;
+    int pool_fd;
+    int result = -1;
+
+    memset(epoch_files, 0, sizeof(*epoch_files));
+    strncpy(epoch_files->header_path, "/tmp/tp_seamless_remap_headerXXXXXX", sizeof(epoch_files->header_path) - 1);
+    strncpy(epoch_files->pool_path, "/tmp/tp_seamless_remap_poolXXXXXX", sizeof(epoch_files->pool_path) - 1);
+
+    header_fd = mkstemp(epoch_files->header_path);
+    pool_fd = mkstemp(epoch_files->pool_path);
+    if (header_fd < 0 || pool_fd < 0)
+    {
+        goto cleanup;
+    }
+
+    if (ftruncate(header_fd, TP_SUPERBLOCK_SIZE_BYTES + TP_HEADER_SLOT_BYTES * 4) != 0 ||
+        ftruncate(pool_fd, TP_SUPERBLOCK_SIZE_BYTES + 64 * 4) != 0)
+    {
+        goto cleanup;
+    }
+
+    tp_test_write_superblock(header_fd, stream_id, epoch, tensor_pool_regionType_HEADER_RING, 0, 4, TP_HEADER_SLOT_BYTES, 0);
+    tp_test_write_superblock(pool_fd, stream_id, epoch, tensor_pool_regionType_PAYLOAD_POOL, 1, 4, TP_NULL_U32, 64);
+
+    snprintf(epoch_files->header_uri, sizeof(epoch_files->header_uri), "shm:file?path=%s", epoch_files->header_path);
+    snprintf(epoch_files->pool_uri, sizeof(epoch_files->pool_uri), "shm:file?path=%s", epoch_files->pool_path);
+
+    epoch_files->pool.pool_id = 1;
+    epoch_files->pool.nslots = 4;
+    epoch_files->pool.stride_bytes = 64;
+    epoch_files->pool.region_uri.data = epoch_files->pool_uri;
+    epoch_files->pool.region_uri.length = (uint32_t)strlen(epoch_files->pool_uri);
+
+    epoch_files->announce.stream_id = stream_id;
+    epoch_files->announce.epoch = epoch;
+    epoch_files->announce.layout_version = TP_LAYOUT_VERSION;
+    epoch_files->announce.header_nslots = 4;
+    epoch_files->announce.header_slot_bytes = TP_HEADER_SLOT_BYTES;
+    epoch_files->announce.header_region_uri.data = epoch_files->header_uri;
+    epoch_files->announce.header_region_uri.length = (uint32_t)strlen(epoch_files->header_uri);
+    epoch_files->announce.pool_count = 1;
+    epoch_files->announce.pools = &epoch_files->pool;
+    result = 0;
+
+cleanup:
+    if (header_fd >= 0)
+    {
+        close(header_fd);
+    }
+    if (pool_fd >= 0)
+    {
+        close(pool_fd);
+    }
+    return result;
+}
+
+static void tp_test_remap_epoch_remove(tp_test_remap_epoch_t *epoch_files)
+{
+    if (epoch_files->header_path[0] != '\0')
+    {
+        unlink(epoch_files->header_path);
+    }
+    if (epoch_files->pool_path[0] != '\0')
+    {
+        unlink(epoch_files->pool_path);
+    }
+}
+
+void tp_test_consumer_seamless_remap(void)
+{
+    static const char *allowed_paths[] = { "/tmp" };
+    tp_client_t client;
+    tp_consumer_t *consumer = NULL;
+    tp_producer_t producer;
+    tp_payload_pool_t producer_pool;
+    tp_tensor_header_t header;
+    tp_test_remap_epoch_t epoch1;
+    tp_test_remap_epoch_t epoch2;
+    tp_shm_pool_announce_view_t missing;
+    tp_consumer_mapping_t *held = NULL;
+    tp_frame_view_t view;
+    const volatile uint8_t *old_header = NULL;
+    uint8_t payload[8];
+    uint64_t remap_count = 0;
+    uint64_t last_gap_ns = 0;
+    uint64_t drops_late = 0;
+    int result = -1;
+
+    memset(&client, 0, sizeof(client));
+    memset(&producer, 0, sizeof(producer));
+    memset(&producer_pool, 0, sizeof(producer_pool));
+    memset(&header, 0, sizeof(header));
+    memset(&epoch1, 0, sizeof(epoch1));
+    memset(&epoch2, 0, sizeof(epoch2));
+
+    if (tp_context_init(&client.context) < 0)
+    {
+        goto cleanup;
+    }
+    tp_context_set_allowed_paths(client.context, allowed_paths, 1);
+    if (tp_context_finalize_allowed_paths(client.context) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (aeron_alloc((void **)&consumer, sizeof(*consumer)) < 0)
+    {
+        consumer = NULL;
+        goto cleanup;
+    }
+    consumer->client = &client;
+    consumer->use_shm = true;
+    consumer->context.follow_ring = true;
+    consumer->header_region.fd = -1;
+
+    if (tp_test_remap_epoch_create(&epoch1, 91004, 1) < 0 ||
+        tp_test_remap_epoch_create(&epoch2, 91004, 2) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_apply_announce_for_test(consumer, &epoch1.announce) != 0 ||
+        !consumer->shm_mapped || consumer->mapped_epoch != 1)
+    {
+        goto cleanup;
+    }
+
+    /* A view handed to another thread pins epoch 1 across the remap. */
+    held = tp_consumer_hold_mapping(consumer);
+    old_header = (const volatile uint8_t *)consumer->header_region.addr;
+    if (NULL == held || NULL == old_header)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_apply_announce_for_test(consumer, &epoch2.announce) != 0 ||
+        !consumer->shm_mapped || consumer->mapped_epoch != 2)
+    {
+        goto cleanup;
+    }
+    if (consumer->retired_mappings != held || held->header_region.addr != (void *)old_header ||
+        consumer->remap_started_ns == 0)
+    {
+        goto cleanup;
+    }
+    if (old_header[0] != (uint8_t)(TP_MAGIC_U64 & 0xFF))
+    {
+        goto cleanup;
+    }
+
+    /* A remap that cannot be mapped leaves the current epoch in place. */
+    missing = epoch2.announce;
+    missing.epoch = 3;
+    missing.header_region_uri.data = "shm:file?path=/tmp/tp_seamless_remap_missing";
+    missing.header_region_uri.length = (uint32_t)strlen(missing.header_region_uri.data);
+    if (tp_consumer_apply_announce_for_test(consumer, &missing) == 0 ||
+        !consumer->shm_mapped || consumer->mapped_epoch != 2 || NULL == consumer->mapping)
+    {
+        goto cleanup;
+    }
+
+    /* Once released, the next poll unmaps the retired epoch. */
+    tp_consumer_release_mapping(held);
+    held = NULL;
+    if (tp_consumer_poll_ring(consumer, &view, 1) != 0 || consumer->retired_mappings != NULL)
+    {
+        goto cleanup;
+    }
+
+    producer.client = &client;
+    producer.header_region.addr = consumer->header_region.addr;
+    producer.header_nslots = consumer->header_nslots;
+    producer.pool_count = 1;
+    producer.pools = &producer_pool;
+    producer.stream_id = 91004;
+    producer.epoch = 2;
+
+    producer_pool.pool_id = 1;
+    producer_pool.nslots = 4;
+    producer_pool.stride_bytes = 64;
+    producer_pool.region.addr = consumer->pools[0].region.addr;
+
+    header.dtype = TP_DTYPE_UINT8;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = sizeof(payload);
+    memset(payload, 7, sizeof(payload));
+    tp_producer_publish_frame(&producer, 0, &header, payload, sizeof(payload), 1, 10, 0, 0);
+
+    /* The first frame read on the new epoch closes the remap gap. */
+    if (tp_consumer_poll_ring(consumer, &view, 1) != 1 || view.payload[0] != 7)
+    {
+        goto cleanup;
+    }
+    if (tp_consumer_get_remap_stats(consumer, &remap_count, &last_gap_ns, NULL) < 0 ||
+        remap_count != 1 || consumer->remap_started_ns != 0)
+    {
+        goto cleanup;
+    }
+    (void)last_gap_ns;
+
+    if (tp_consumer_get_drop_counts(consumer, NULL, &drops_late, NULL) < 0 || drops_late != 0)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    if (held)
+    {
+        tp_consumer_release_mapping(held);
+    }
+    if (consumer)
+    {
+        tp_consumer_close(consumer);
+    }
+    tp_test_remap_epoch_remove(&epoch1);
+    tp_test_remap_epoch_remove(&epoch2);
+    tp_context_close(client.context);
+    assert(result == 0);
+}
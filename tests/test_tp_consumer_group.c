@@ -0,0 +1,569 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/internal/tp_client_internal.h"
+#include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/tp_clock.h"
+#include "tensor_pool/tp_consumer_group.h"
+#include "tensor_pool/tp_context.h"
+#include "tensor_pool/tp_error.h"
+#include "tp_aeron_wrap.h"
+
+#include "wire/tensor_pool/frameDescriptor.h"
+#include "wire/tensor_pool/messageHeader.h"
+
+#include "aeronc.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+enum { TP_TEST_GROUP_MEMBERS = 40 };
+
+static bool tp_test_has_aeron_dir(const tp_client_t *client)
+{
+    const char *dir = tp_context_get_aeron_dir(client->context);
+    return NULL != dir && dir[0] != '\0';
+}
+
+static int tp_test_driver_active(const char *aeron_dir)
+{
+    aeron_cnc_t *cnc = NULL;
+    int64_t heartbeat = 0;
+    int64_t now_ms = 0;
+    int64_t age_ms = 0;
+
+    if (NULL == aeron_dir || aeron_dir[0] == '\0')
+    {
+        return 0;
+    }
+
+    if (aeron_cnc_init(&cnc, aeron_dir, 100) < 0)
+    {
+        return 0;
+    }
+
+    heartbeat = aeron_cnc_to_driver_heartbeat(cnc);
+    now_ms = aeron_epoch_clock();
+    age_ms = now_ms - heartbeat;
+
+    aeron_cnc_close(cnc);
+    return heartbeat > 0 && age_ms <= 1000;
+}
+
+static int tp_test_start_client(tp_client_t **client, tp_context_t **ctx, const char *aeron_dir)
+{
+    if (!tp_test_driver_active(aeron_dir))
+    {
+        return -1;
+    }
+
+    if (tp_context_init(ctx) < 0)
+    {
+        return -1;
+    }
+
+    if (NULL != aeron_dir && aeron_dir[0] != '\0')
+    {
+        tp_context_set_aeron_dir(*ctx, aeron_dir);
+    }
+    tp_context_set_use_agent_invoker(*ctx, true);
+
+    if (tp_client_init(client, *ctx) < 0)
+    {
+        return -1;
+    }
+
+    if (tp_client_start(*client) < 0)
+    {
+        tp_client_close(*client);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int tp_test_start_client_any(tp_client_t **client, tp_context_t **ctx)
+{
+    char default_dir[AERON_MAX_PATH];
+    const char *env_dir = getenv("AERON_DIR");
+    const char *candidates[2];
+    size_t candidate_count = 0;
+    size_t i;
+
+    default_dir[0] = '\0';
+    if (aeron_default_path(default_dir, sizeof(default_dir)) < 0)
+    {
+        default_dir[0] = '\0';
+    }
+
+    if (NULL != env_dir && env_dir[0] != '\0')
+    {
+        candidates[candidate_count++] = env_dir;
+    }
+    if (default_dir[0] != '\0')
+    {
+        candidates[candidate_count++] = default_dir;
+    }
+
+    for (i = 0; i < candidate_count; i++)
+    {
+        if (tp_test_start_client(client, ctx, candidates[i]) == 0)
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static int tp_test_add_publication(tp_client_t *client, const char *channel, int32_t stream_id, tp_publication_t **out)
+{
+    tp_async_add_publication_t *async_add = NULL;
+
+    if (tp_client_async_add_publication(client, channel, stream_id, &async_add) < 0)
+    {
+        return -1;
+    }
+
+    *out = NULL;
+    while (NULL == *out)
+    {
+        if (tp_client_async_add_publication_poll(out, async_add) < 0)
+        {
+            return -1;
+        }
+        tp_client_do_work(client);
+    }
+
+    return 0;
+}
+
+static int tp_test_add_subscription(tp_client_t *client, const char *channel, int32_t stream_id, tp_subscription_t **out)
+{
+    tp_async_add_subscription_t *async_add = NULL;
+
+    if (tp_client_async_add_subscription(client, channel, stream_id, &async_add) < 0)
+    {
+        return -1;
+    }
+
+    *out = NULL;
+    while (NULL == *out)
+    {
+        if (tp_client_async_add_subscription_poll(out, async_add) < 0)
+        {
+            return -1;
+        }
+        tp_client_do_work(client);
+    }
+
+    return 0;
+}
+
+static int tp_test_wait_for_connected(tp_client_t *client, tp_publication_t *pub, tp_subscription_t *sub)
+{
+    int64_t deadline = tp_clock_now_ns() + 2 * 1000 * 1000 * 1000LL;
+
+    while (tp_clock_now_ns() < deadline)
+    {
+        if (aeron_publication_is_connected(tp_publication_handle(pub)) &&
+            aeron_subscription_is_connected(tp_subscription_handle(sub)))
+        {
+            return 0;
+        }
+        tp_client_do_work(client);
+        {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    return -1;
+}
+
+static int tp_test_offer_descriptor(tp_client_t *client, tp_publication_t *pub, uint32_t stream_id, uint64_t seq)
+{
+    uint8_t buffer[128];
+    struct tensor_pool_messageHeader header;
+    struct tensor_pool_frameDescriptor descriptor;
+    size_t header_len = tensor_pool_messageHeader_encoded_length();
+    size_t body_len = tensor_pool_frameDescriptor_sbe_block_length();
+    int64_t deadline = tp_clock_now_ns() + 2 * 1000 * 1000 * 1000LL;
+
+    tensor_pool_messageHeader_wrap(
+        &header,
+        (char *)buffer,
+        0,
+        tensor_pool_messageHeader_sbe_schema_version(),
+        sizeof(buffer));
+    tensor_pool_messageHeader_set_blockLength(&header, (uint16_t)body_len);
+    tensor_pool_messageHeader_set_templateId(&header, tensor_pool_frameDescriptor_sbe_template_id());
+    tensor_pool_messageHeader_set_schemaId(&header, tensor_pool_frameDescriptor_sbe_schema_id());
+    tensor_pool_messageHeader_set_version(&header, tensor_pool_frameDescriptor_sbe_schema_version());
+
+    tensor_pool_frameDescriptor_wrap_for_encode(&descriptor, (char *)buffer, header_len, sizeof(buffer));
+    tensor_pool_frameDescriptor_set_streamId(&descriptor, stream_id);
+    tensor_pool_frameDescriptor_set_epoch(&descriptor, 1);
+    tensor_pool_frameDescriptor_set_seq(&descriptor, seq);
+    tensor_pool_frameDescriptor_set_timestampNs(&descriptor, 0);
+    tensor_pool_frameDescriptor_set_metaVersion(&descriptor, 0);
+    tensor_pool_frameDescriptor_set_traceId(&descriptor, 0);
+
+    while (tp_clock_now_ns() < deadline)
+    {
+        if (aeron_publication_offer(tp_publication_handle(pub), buffer, header_len + body_len, NULL, NULL) >= 0)
+        {
+            return 0;
+        }
+        tp_client_do_work(client);
+        {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    return -1;
+}
+
+static void tp_test_count_descriptor(void *clientd, const tp_frame_descriptor_t *desc)
+{
+    int *count = (int *)clientd;
+
+    (void)desc;
+    (*count)++;
+}
+
+/* A stand-in member that accepts every epoch-1 descriptor for its stream without mapping anything. */
+static void tp_test_init_member(tp_consumer_t *consumer, tp_client_t *client, uint32_t stream_id, int *count)
+{
+    memset(consumer, 0, sizeof(*consumer));
+    consumer->client = client;
+    consumer->context.stream_id = stream_id;
+    consumer->shm_mapped = true;
+    consumer->mapped_epoch = 1;
+    tp_consumer_set_descriptor_handler(consumer, tp_test_count_descriptor, count);
+}
+
+static void tp_test_close_member(tp_consumer_t *consumer)
+{
+    tp_subscription_close(&consumer->descriptor_subscription);
+    tp_fragment_assembler_close(&consumer->descriptor_assembler);
+}
+
+static void test_consumer_group_invalid_input(void)
+{
+    tp_consumer_group_context_t ctx;
+    tp_consumer_group_t *group = NULL;
+    tp_client_t client;
+
+    memset(&client, 0, sizeof(client));
+    assert(tp_consumer_group_context_init(NULL) < 0);
+    assert(tp_consumer_group_context_init(&ctx) == 0);
+    assert(ctx.stream_budget > 0);
+    assert(ctx.control_fragment_limit > 0);
+
+    assert(tp_consumer_group_init(&group, NULL, &ctx) < 0);
+    ctx.stream_budget = 0;
+    assert(tp_consumer_group_init(&group, &client, &ctx) < 0);
+    assert(NULL == group);
+
+    assert(tp_consumer_group_add(NULL, NULL) < 0);
+    assert(tp_consumer_group_poll(NULL, 10) < 0);
+    assert(tp_consumer_group_member_count(NULL) == 0);
+    assert(tp_consumer_group_close(NULL) == 0);
+}
+
+static void test_consumer_group_membership(void)
+{
+    tp_consumer_group_context_t ctx;
+    tp_consumer_group_t *group = NULL;
+    tp_client_t client;
+    tp_client_t other_client;
+    tp_consumer_t consumers[TP_TEST_GROUP_MEMBERS];
+    tp_consumer_t duplicate;
+    tp_consumer_t polled;
+    size_t i;
+    int result = -1;
+
+    memset(&client, 0, sizeof(client));
+    memset(&other_client, 0, sizeof(other_client));
+    memset(consumers, 0, sizeof(consumers));
+    memset(&duplicate, 0, sizeof(duplicate));
+    memset(&polled, 0, sizeof(polled));
+
+    if (tp_consumer_group_context_init(&ctx) < 0 || tp_consumer_group_init(&group, &client, &ctx) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Enough members to grow the stream_id table past its initial size. */
+    for (i = 0; i < TP_TEST_GROUP_MEMBERS; i++)
+    {
+        consumers[i].client = &client;
+        consumers[i].context.stream_id = (uint32_t)(1000 + i * 16);
+        if (tp_consumer_group_add(group, &consumers[i]) < 0)
+        {
+            goto cleanup;
+        }
+    }
+    if (tp_consumer_group_member_count(group) != TP_TEST_GROUP_MEMBERS)
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < TP_TEST_GROUP_MEMBERS; i++)
+    {
+        duplicate.client = &client;
+        duplicate.context.stream_id = consumers[i].context.stream_id;
+        if (tp_consumer_group_add(group, &duplicate) == 0 || tp_errcode() != EEXIST)
+        {
+            goto cleanup;
+        }
+    }
+
+    /* Consumers polled elsewhere or owned by another client cannot join. */
+    polled.client = &client;
+    polled.context.stream_id = 7;
+    polled.conductor_poll_registered = true;
+    if (tp_consumer_group_add(group, &polled) == 0)
+    {
+        goto cleanup;
+    }
+    polled.client = &other_client;
+    polled.conductor_poll_registered = false;
+    if (tp_consumer_group_add(group, &polled) == 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_group_member_count(group) != TP_TEST_GROUP_MEMBERS ||
+        tp_consumer_group_unrouted_count(group) != 0)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    tp_consumer_group_close(group);
+    assert(result == 0);
+}
+
+static void test_consumer_group_shared_routing(void)
+{
+    tp_context_t *ctx = NULL;
+    tp_client_t *client = NULL;
+    tp_consumer_group_context_t group_ctx;
+    tp_consumer_group_t *group = NULL;
+    tp_publication_t *shared_pub = NULL;
+    tp_publication_t *assigned_pub = NULL;
+    tp_consumer_t members[3];
+    int counts[3] = { 0, 0, 0 };
+    int expected[3] = { 3, 2, 1 };
+    int64_t deadline;
+    size_t i;
+    int result = -1;
+
+    memset(members, 0, sizeof(members));
+
+    if (tp_test_start_client_any(&client, &ctx) < 0)
+    {
+        return;
+    }
+
+    /* Two members share stream 4100; the third has its own descriptor stream 4200. */
+    for (i = 0; i < 3; i++)
+    {
+        tp_test_init_member(&members[i], client, (uint32_t)(501 + i), &counts[i]);
+    }
+    members[2].assigned_descriptor_stream_id = 4200;
+    if (tp_test_add_publication(client, "aeron:ipc", 4100, &shared_pub) < 0 ||
+        tp_test_add_publication(client, "aeron:ipc", 4200, &assigned_pub) < 0 ||
+        tp_test_add_subscription(client, "aeron:ipc", 4100, &members[0].descriptor_subscription) < 0 ||
+        tp_test_add_subscription(client, "aeron:ipc", 4100, &members[1].descriptor_subscription) < 0 ||
+        tp_test_add_subscription(client, "aeron:ipc", 4200, &members[2].descriptor_subscription) < 0 ||
+        tp_test_wait_for_connected(client, shared_pub, members[0].descriptor_subscription) < 0 ||
+        tp_test_wait_for_connected(client, assigned_pub, members[2].descriptor_subscription) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_group_context_init(&group_ctx) < 0 || tp_consumer_group_init(&group, client, &group_ctx) < 0)
+    {
+        goto cleanup;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        if (tp_consumer_group_add(group, &members[i]) < 0)
+        {
+            goto cleanup;
+        }
+    }
+    if (NULL != members[0].descriptor_subscription ||
+        NULL != members[1].descriptor_subscription ||
+        NULL == members[2].descriptor_subscription)
+    {
+        goto cleanup;
+    }
+
+    /* The shared copy for 503 duplicates its own stream and must not be delivered twice. */
+    if (tp_test_offer_descriptor(client, shared_pub, 501, 1) < 0 ||
+        tp_test_offer_descriptor(client, shared_pub, 502, 1) < 0 ||
+        tp_test_offer_descriptor(client, shared_pub, 503, 1) < 0 ||
+        tp_test_offer_descriptor(client, shared_pub, 999, 1) < 0 ||
+        tp_test_offer_descriptor(client, shared_pub, 501, 2) < 0 ||
+        tp_test_offer_descriptor(client, shared_pub, 502, 2) < 0 ||
+        tp_test_offer_descriptor(client, shared_pub, 501, 3) < 0 ||
+        tp_test_offer_descriptor(client, assigned_pub, 503, 1) < 0)
+    {
+        goto cleanup;
+    }
+
+    deadline = tp_clock_now_ns() + 500 * 1000 * 1000LL;
+    while (tp_clock_now_ns() < deadline)
+    {
+        if (tp_consumer_group_poll(group, 10) < 0)
+        {
+            goto cleanup;
+        }
+        {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        if (counts[i] != expected[i])
+        {
+            goto cleanup;
+        }
+    }
+    if (tp_consumer_group_unrouted_count(group) != 1)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    tp_consumer_group_close(group);
+    for (i = 0; i < 3; i++)
+    {
+        tp_test_close_member(&members[i]);
+    }
+    tp_publication_close(&shared_pub);
+    tp_publication_close(&assigned_pub);
+    if (tp_test_has_aeron_dir(client))
+    {
+        tp_client_close(client);
+    }
+    assert(result == 0);
+}
+
+static void test_consumer_group_stream_budget(void)
+{
+    tp_context_t *ctx = NULL;
+    tp_client_t *client = NULL;
+    tp_consumer_group_context_t group_ctx;
+    tp_consumer_group_t *group = NULL;
+    tp_publication_t *busy_pub = NULL;
+    tp_publication_t *quiet_pub = NULL;
+    tp_consumer_t members[3];
+    int counts[3] = { 0, 0, 0 };
+    size_t i;
+    int polled;
+    int result = -1;
+
+    memset(members, 0, sizeof(members));
+
+    if (tp_test_start_client_any(&client, &ctx) < 0)
+    {
+        return;
+    }
+
+    /* Members 0 and 1 share stream 4300, member 2 reads 4301 alone. */
+    for (i = 0; i < 3; i++)
+    {
+        tp_test_init_member(&members[i], client, (uint32_t)(601 + i), &counts[i]);
+    }
+    if (tp_test_add_publication(client, "aeron:ipc", 4300, &busy_pub) < 0 ||
+        tp_test_add_publication(client, "aeron:ipc", 4301, &quiet_pub) < 0 ||
+        tp_test_add_subscription(client, "aeron:ipc", 4300, &members[0].descriptor_subscription) < 0 ||
+        tp_test_add_subscription(client, "aeron:ipc", 4300, &members[1].descriptor_subscription) < 0 ||
+        tp_test_add_subscription(client, "aeron:ipc", 4301, &members[2].descriptor_subscription) < 0 ||
+        tp_test_wait_for_connected(client, busy_pub, members[0].descriptor_subscription) < 0 ||
+        tp_test_wait_for_connected(client, busy_pub, members[1].descriptor_subscription) < 0 ||
+        tp_test_wait_for_connected(client, quiet_pub, members[2].descriptor_subscription) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_group_context_init(&group_ctx) < 0)
+    {
+        goto cleanup;
+    }
+    group_ctx.stream_budget = 4;
+    if (tp_consumer_group_init(&group, client, &group_ctx) < 0)
+    {
+        goto cleanup;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        if (tp_consumer_group_add(group, &members[i]) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    /* The busy stream has far more queued than one poll may take. */
+    for (i = 0; i < 20; i++)
+    {
+        if (tp_test_offer_descriptor(client, busy_pub, 601, i + 1) < 0)
+        {
+            goto cleanup;
+        }
+    }
+    for (i = 0; i < 10; i++)
+    {
+        if (tp_test_offer_descriptor(client, quiet_pub, 603, i + 1) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    /*
+     * A shared subscription serving two streams may take twice the per-stream budget in a
+     * round, and the other subscription still gets its own budget from the same poll.
+     */
+    polled = tp_consumer_group_poll(group, 12);
+    if (polled < 0 || counts[0] != 8 || counts[1] != 0 || counts[2] != 4)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    tp_consumer_group_close(group);
+    for (i = 0; i < 3; i++)
+    {
+        tp_test_close_member(&members[i]);
+    }
+    tp_publication_close(&busy_pub);
+    tp_publication_close(&quiet_pub);
+    if (tp_test_has_aeron_dir(client))
+    {
+        tp_client_close(client);
+    }
+    assert(result == 0);
+}
+
+void tp_test_consumer_group(void)
+{
+    test_consumer_group_invalid_input();
+    test_consumer_group_membership();
+    test_consumer_group_shared_routing();
+    test_consumer_group_stream_budget();
+}
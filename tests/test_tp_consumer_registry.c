@@ -177,6 +177,79 @@ cleanup:
     assert(result == 0);
 }
 
+static void test_consumer_registry_active_dense(void)
+{
+    tp_consumer_registry_t registry;
+    tp_consumer_hello_view_t hello;
+    tp_consumer_entry_t *entry = NULL;
+    size_t i;
+    int result = -1;
+
+    if (tp_consumer_registry_init(&registry, 4) != 0)
+    {
+        goto cleanup;
+    }
+
+    memset(&hello, 0, sizeof(hello));
+    hello.consumer_id = 1;
+    if (tp_consumer_registry_update(&registry, &hello, 10, NULL) != 0)
+    {
+        goto cleanup;
+    }
+
+    hello.consumer_id = 2;
+    hello.mode = TP_MODE_RATE_LIMITED;
+    hello.max_rate_hz = 100;
+    if (tp_consumer_registry_update(&registry, &hello, 40, &entry) != 0)
+    {
+        goto cleanup;
+    }
+    assert(entry->hot->descriptor_interval_ns == 10000000ULL);
+
+    hello.consumer_id = 3;
+    hello.mode = TP_MODE_STREAM;
+    hello.max_rate_hz = 0;
+    if (tp_consumer_registry_update(&registry, &hello, 40, NULL) != 0)
+    {
+        goto cleanup;
+    }
+    assert(registry.active_count == 3);
+
+    if (tp_consumer_registry_sweep(&registry, 50, 20) != 1)
+    {
+        goto cleanup;
+    }
+    assert(registry.active_count == 2);
+    assert(NULL == tp_consumer_registry_find(&registry, 1));
+
+    for (i = 0; i < registry.active_count; i++)
+    {
+        tp_consumer_hot_t *hot = &registry.active[i];
+        entry = &registry.entries[hot->entry_index];
+        assert(entry->in_use);
+        assert(entry->consumer_id == hot->consumer_id);
+        assert(entry->hot == hot);
+    }
+
+    entry = tp_consumer_registry_find(&registry, 2);
+    assert(NULL != entry);
+    assert(entry->hot->mode == TP_MODE_RATE_LIMITED);
+
+    hello.consumer_id = 4;
+    if (tp_consumer_registry_update(&registry, &hello, 60, &entry) != 0)
+    {
+        goto cleanup;
+    }
+    assert(registry.active_count == 3);
+    assert(entry->hot->descriptor_interval_ns == 0);
+
+    result = 0;
+
+cleanup:
+    tp_consumer_registry_close(&registry);
+    assert(result == 0);
+}
+
 static void test_progress_throttle_should_publish(void)
 {
     tp_consumer_manager_t manager;
@@ -252,6 +325,7 @@ void tp_test_consumer_registry(void)
     test_consumer_progress_aggregation();
     test_consumer_registry_decline_invalid_channel();
     test_consumer_registry_sweep();
+    test_consumer_registry_active_dense();
     test_progress_throttle_should_publish();
     test_consumer_manager_force_no_shm();
 }
@@ -0,0 +1,140 @@
+#include "tensor_pool/tp_copy.h"
+#include "tp_copy_pool.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void test_copy_engine_resolve(void)
+{
+    tp_copy_engine_t resolved;
+
+    assert(tp_copy_engine_resolve(TP_COPY_ENGINE_MEMCPY) == TP_COPY_ENGINE_MEMCPY);
+
+    resolved = tp_copy_engine_resolve(TP_COPY_ENGINE_AUTO);
+    assert(resolved != TP_COPY_ENGINE_AUTO);
+    assert(tp_copy_engine_resolve(TP_COPY_ENGINE_AVX2) <= TP_COPY_ENGINE_AVX2);
+    assert(tp_copy_engine_resolve(TP_COPY_ENGINE_SSE2) <= TP_COPY_ENGINE_SSE2);
+    assert(NULL != tp_copy_engine_fn(TP_COPY_ENGINE_MEMCPY));
+    assert(strcmp(tp_copy_engine_name(TP_COPY_ENGINE_MEMCPY), "memcpy") == 0);
+}
+
+static void test_copy_engine_roundtrip(void)
+{
+    const size_t capacity = 8192;
+    uint8_t *src = NULL;
+    uint8_t *dst = NULL;
+    int engine;
+    size_t length;
+    size_t offset;
+    size_t i;
+    int result = -1;
+
+    src = malloc(capacity + 128);
+    dst = malloc(capacity + 128);
+    if (NULL == src || NULL == dst)
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < capacity + 128; i++)
+    {
+        src[i] = (uint8_t)(i * 31u + 7u);
+    }
+
+    for (engine = TP_COPY_ENGINE_MEMCPY; engine <= TP_COPY_ENGINE_AVX512; engine++)
+    {
+        tp_copy_fn_t copy = tp_copy_engine_fn((tp_copy_engine_t)engine);
+
+        for (length = 0; length <= capacity; length += 251)
+        {
+            for (offset = 0; offset < 64; offset += 13)
+            {
+                memset(dst, 0, capacity + 128);
+                copy(dst + offset, src + 3, length);
+                if (memcmp(dst + offset, src + 3, length) != 0)
+                {
+                    goto cleanup;
+                }
+                if (offset > 0 && dst[offset - 1] != 0)
+                {
+                    goto cleanup;
+                }
+                if (dst[offset + length] != 0)
+                {
+                    goto cleanup;
+                }
+            }
+        }
+    }
+
+    result = 0;
+
+cleanup:
+    free(src);
+    free(dst);
+    assert(result == 0);
+}
+
+static void test_copy_pool_striped(void)
+{
+    const size_t capacity = 1024 * 1024;
+    tp_copy_pool_t *pool = NULL;
+    uint8_t *src = NULL;
+    uint8_t *dst = NULL;
+    size_t lengths[] = { 0, 1, 4095, 4096, 4097, 65536 + 17, 1024 * 1024 - 64 };
+    size_t i;
+    int round;
+    int result = -1;
+
+    assert(tp_copy_pool_init(&pool, 0, 4096, NULL) < 0);
+
+    src = malloc(capacity + 64);
+    dst = malloc(capacity + 64);
+    if (NULL == src || NULL == dst)
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < capacity + 64; i++)
+    {
+        src[i] = (uint8_t)(i * 13u + 1u);
+    }
+
+    if (tp_copy_pool_init(&pool, 3, 4000, tp_copy_engine_fn(TP_COPY_ENGINE_AUTO)) < 0)
+    {
+        goto cleanup;
+    }
+    assert(tp_copy_pool_helper_count(pool) == 3);
+
+    for (round = 0; round < 50; round++)
+    {
+        for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        {
+            size_t offset = (size_t)(round % 7) * 9u;
+
+            memset(dst, 0, capacity + 64);
+            tp_copy_pool_copy(pool, dst + offset, src, lengths[i]);
+            if (memcmp(dst + offset, src, lengths[i]) != 0 || dst[offset + lengths[i]] != 0)
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    result = 0;
+
+cleanup:
+    tp_copy_pool_close(pool);
+    free(src);
+    free(dst);
+    assert(result == 0);
+}
+
+void tp_test_copy_engine(void)
+{
+    test_copy_engine_resolve();
+    test_copy_engine_roundtrip();
+    test_copy_pool_striped();
+}
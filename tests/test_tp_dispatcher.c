@@ -0,0 +1,393 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/internal/tp_client_internal.h"
+#include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/internal/tp_producer_internal.h"
+#include "tensor_pool/tp_dispatcher.h"
+#include "tensor_pool/tp_seqlock.h"
+#include "tensor_pool/tp_slot.h"
+#include "tensor_pool/tp_types.h"
+#include "tp_steal_queue.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int tp_producer_publish_frame(
+    tp_producer_t *producer,
+    uint64_t seq,
+    const tp_tensor_header_t *tensor,
+    const void *payload,
+    uint32_t payload_len,
+    uint16_t pool_id,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id);
+
+enum
+{
+    TP_TEST_STEAL_VALUES = 20000,
+    TP_TEST_STEAL_THIEVES = 3
+};
+
+typedef struct tp_test_steal_state_stct
+{
+    tp_steal_queue_t *queue;
+    _Atomic uint32_t *seen;
+    _Atomic bool done;
+}
+tp_test_steal_state_t;
+
+static void *tp_test_thief(void *arg)
+{
+    tp_test_steal_state_t *state = (tp_test_steal_state_t *)arg;
+    uint64_t value;
+
+    for (;;)
+    {
+        if (tp_steal_queue_take(state->queue, &value))
+        {
+            atomic_fetch_add(&state->seen[value], 1);
+            continue;
+        }
+        if (atomic_load(&state->done) && tp_steal_queue_size(state->queue) == 0)
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static void test_steal_queue_basic(void)
+{
+    tp_steal_queue_t queue;
+    uint64_t value = 0;
+
+    assert(tp_steal_queue_init(&queue, 3) < 0);
+    assert(tp_steal_queue_init(&queue, 4) == 0);
+
+    assert(!tp_steal_queue_take(&queue, &value));
+    assert(tp_steal_queue_push(&queue, 10));
+    assert(tp_steal_queue_push(&queue, 11));
+    assert(tp_steal_queue_push(&queue, 12));
+    assert(tp_steal_queue_push(&queue, 13));
+    assert(!tp_steal_queue_push(&queue, 14));
+    assert(tp_steal_queue_size(&queue) == 4);
+
+    assert(tp_steal_queue_take(&queue, &value) && value == 10);
+    assert(tp_steal_queue_push(&queue, 14));
+    assert(tp_steal_queue_take(&queue, &value) && value == 11);
+    assert(tp_steal_queue_take(&queue, &value) && value == 12);
+    assert(tp_steal_queue_take(&queue, &value) && value == 13);
+    assert(tp_steal_queue_take(&queue, &value) && value == 14);
+    assert(!tp_steal_queue_take(&queue, &value));
+
+    tp_steal_queue_close(&queue);
+}
+
+static void test_steal_queue_concurrent(void)
+{
+    tp_steal_queue_t queue;
+    tp_test_steal_state_t state;
+    pthread_t thieves[TP_TEST_STEAL_THIEVES];
+    uint32_t started = 0;
+    uint64_t value;
+    uint64_t next = 0;
+    uint32_t i;
+    int result = -1;
+
+    memset(&state, 0, sizeof(state));
+    assert(tp_steal_queue_init(&queue, 64) == 0);
+    state.queue = &queue;
+    state.seen = (_Atomic uint32_t *)calloc(TP_TEST_STEAL_VALUES, sizeof(*state.seen));
+    atomic_init(&state.done, false);
+    if (NULL == state.seen)
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < TP_TEST_STEAL_THIEVES; i++)
+    {
+        if (pthread_create(&thieves[i], NULL, tp_test_thief, &state) != 0)
+        {
+            goto cleanup;
+        }
+        started++;
+    }
+
+    /* The owner interleaves pushes with its own takes while the thieves race it. */
+    while (next < TP_TEST_STEAL_VALUES)
+    {
+        if (tp_steal_queue_push(&queue, next))
+        {
+            next++;
+        }
+        if ((next & 7u) == 0 && tp_steal_queue_take(&queue, &value))
+        {
+            atomic_fetch_add(&state.seen[value], 1);
+        }
+    }
+    result = 0;
+
+cleanup:
+    atomic_store(&state.done, true);
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(thieves[i], NULL);
+    }
+
+    if (result == 0)
+    {
+        for (i = 0; i < TP_TEST_STEAL_VALUES; i++)
+        {
+            if (atomic_load(&state.seen[i]) != 1)
+            {
+                result = -1;
+                break;
+            }
+        }
+    }
+
+    free((void *)state.seen);
+    tp_steal_queue_close(&queue);
+    assert(result == 0);
+}
+
+static void tp_test_dispatch_noop(void *clientd, const tp_frame_view_t *view, uint32_t worker_index)
+{
+    (void)clientd;
+    (void)view;
+    (void)worker_index;
+}
+
+static void test_dispatcher_invalid_input(void)
+{
+    tp_dispatcher_context_t ctx;
+    tp_dispatcher_t *dispatcher = NULL;
+    tp_consumer_t consumer;
+    uint64_t processed = 0;
+
+    memset(&consumer, 0, sizeof(consumer));
+    assert(tp_dispatcher_context_init(NULL) < 0);
+    assert(tp_dispatcher_context_init(&ctx) == 0);
+    assert(ctx.worker_count == 1);
+    assert(ctx.queue_capacity > 0);
+    assert(ctx.validate_after_process);
+
+    assert(tp_dispatcher_init(&dispatcher, NULL, &ctx) < 0);
+    assert(NULL == dispatcher);
+    ctx.process = tp_test_dispatch_noop;
+    ctx.worker_count = 0;
+    assert(tp_dispatcher_init(&dispatcher, &consumer, &ctx) < 0);
+    assert(tp_dispatcher_poll(NULL, 1) < 0);
+    assert(tp_dispatcher_get_counts(NULL, &processed, NULL, NULL) < 0);
+    assert(tp_dispatcher_close(NULL) == 0);
+}
+
+typedef struct tp_test_dispatch_state_stct
+{
+    uint8_t *header_region;
+    _Atomic uint32_t payload_sum;
+    uint64_t completed[8];
+    bool valid[8];
+    size_t completed_count;
+}
+tp_test_dispatch_state_t;
+
+static void tp_test_dispatch_process(void *clientd, const tp_frame_view_t *view, uint32_t worker_index)
+{
+    tp_test_dispatch_state_t *state = (tp_test_dispatch_state_t *)clientd;
+
+    (void)worker_index;
+    atomic_fetch_add(&state->payload_sum, view->payload[0]);
+
+    /* Simulate the producer lapping the ring while seq 1 is still being processed. */
+    if (view->seq == 1)
+    {
+        tp_atomic_store_u64((uint64_t *)tp_slot_at(state->header_region, 1), tp_seq_in_progress(5));
+    }
+}
+
+static void tp_test_dispatch_complete(void *clientd, const tp_frame_view_t *view, bool valid)
+{
+    tp_test_dispatch_state_t *state = (tp_test_dispatch_state_t *)clientd;
+
+    if (state->completed_count < 8)
+    {
+        state->completed[state->completed_count] = view->seq;
+        state->valid[state->completed_count] = valid;
+    }
+    state->completed_count++;
+}
+
+static void test_dispatcher_ordered_ring(void)
+{
+    tp_client_t client;
+    tp_producer_t producer;
+    tp_consumer_t consumer;
+    tp_payload_pool_t producer_pool;
+    tp_consumer_pool_t consumer_pool;
+    tp_tensor_header_t header;
+    tp_dispatcher_context_t ctx;
+    tp_dispatcher_t *dispatcher = NULL;
+    tp_test_dispatch_state_t state;
+    tp_frame_view_t views[4];
+    uint8_t payload[8];
+    uint8_t *header_region = NULL;
+    uint8_t *pool_region = NULL;
+    uint32_t header_nslots = 4;
+    uint32_t stride_bytes = 64;
+    size_t header_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * TP_HEADER_SLOT_BYTES);
+    size_t pool_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * stride_bytes);
+    uint64_t processed = 0;
+    uint64_t torn = 0;
+    uint64_t seq;
+    size_t queued = 0;
+    size_t i;
+    int result = -1;
+
+    memset(&client, 0, sizeof(client));
+    memset(&producer, 0, sizeof(producer));
+    memset(&consumer, 0, sizeof(consumer));
+    memset(&producer_pool, 0, sizeof(producer_pool));
+    memset(&consumer_pool, 0, sizeof(consumer_pool));
+    memset(&header, 0, sizeof(header));
+    memset(&state, 0, sizeof(state));
+    atomic_init(&state.payload_sum, 0);
+
+    if (tp_context_init(&client.context) < 0)
+    {
+        goto cleanup;
+    }
+
+    header_region = calloc(1, header_size);
+    pool_region = calloc(1, pool_size);
+    if (NULL == header_region || NULL == pool_region)
+    {
+        goto cleanup;
+    }
+
+    producer.client = &client;
+    producer.header_region.addr = header_region;
+    producer.header_nslots = header_nslots;
+    producer.pool_count = 1;
+    producer.pools = &producer_pool;
+    producer.stream_id = 1;
+    producer.epoch = 1;
+
+    producer_pool.pool_id = 1;
+    producer_pool.nslots = header_nslots;
+    producer_pool.stride_bytes = stride_bytes;
+    producer_pool.region.addr = pool_region;
+
+    consumer.client = &client;
+    consumer.use_shm = true;
+    consumer.shm_mapped = true;
+    consumer.header_region.addr = header_region;
+    consumer.header_nslots = header_nslots;
+    consumer.pool_count = 1;
+    consumer.pools = &consumer_pool;
+    consumer.stream_id = 1;
+    consumer.epoch = 1;
+    consumer.context.follow_ring = true;
+
+    consumer_pool.pool_id = 1;
+    consumer_pool.nslots = header_nslots;
+    consumer_pool.stride_bytes = stride_bytes;
+    consumer_pool.region.addr = pool_region;
+
+    header.dtype = TP_DTYPE_UINT8;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = sizeof(payload);
+
+    /* Prime the ring reader on the empty ring so it starts from seq 0. */
+    if (tp_consumer_poll_ring(&consumer, views, 4) != 0)
+    {
+        goto cleanup;
+    }
+
+    for (seq = 0; seq < 4; seq++)
+    {
+        memset(payload, (int)(seq + 1), sizeof(payload));
+        tp_producer_publish_frame(&producer, seq, &header, payload, sizeof(payload), 1, 10, 0, 0);
+    }
+
+    state.header_region = header_region;
+    if (tp_dispatcher_context_init(&ctx) < 0)
+    {
+        goto cleanup;
+    }
+    ctx.worker_count = 3;
+    ctx.queue_capacity = 2;
+    ctx.process = tp_test_dispatch_process;
+    ctx.ordered_complete = tp_test_dispatch_complete;
+    ctx.clientd = &state;
+
+    if (tp_dispatcher_init(&dispatcher, &consumer, &ctx) < 0)
+    {
+        goto cleanup;
+    }
+
+    while (queued < 4)
+    {
+        int frames = tp_dispatcher_poll(dispatcher, 4 - queued);
+        if (frames < 0)
+        {
+            goto cleanup;
+        }
+        queued += (size_t)frames;
+    }
+
+    while (processed < 4)
+    {
+        if (tp_dispatcher_get_counts(dispatcher, &processed, NULL, &torn) < 0)
+        {
+            goto cleanup;
+        }
+        sched_yield();
+    }
+    if (torn != 1)
+    {
+        goto cleanup;
+    }
+
+    /* Joining the workers makes their ordered completions visible here. */
+    tp_dispatcher_close(dispatcher);
+    dispatcher = NULL;
+
+    if (state.completed_count != 4 || atomic_load(&state.payload_sum) != 1 + 2 + 3 + 4)
+    {
+        goto cleanup;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        if (state.completed[i] != i || state.valid[i] != (i != 1))
+        {
+            goto cleanup;
+        }
+    }
+    result = 0;
+
+cleanup:
+    tp_dispatcher_close(dispatcher);
+    free(header_region);
+    free(pool_region);
+    assert(result == 0);
+}
+
+void tp_test_dispatcher(void)
+{
+    test_steal_queue_basic();
+    test_steal_queue_concurrent();
+    test_dispatcher_invalid_input();
+    test_dispatcher_ordered_ring();
+}
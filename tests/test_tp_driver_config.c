@@ -19,12 +19,18 @@ void tp_test_driver_config(void)
     assert(strcmp(config.shm_namespace, "default") == 0);
     assert(config.allow_dynamic_streams == false);
     assert(config.node_id_reuse_cooldown_ms == 1000);
+    assert(config.provision_workers == 2);
+    assert(config.spare_epochs == false);
+    assert(config.transparent_hugepages == false);
     assert(config.profile_count == 1);
     assert(config.stream_count == 1);
     assert(config.profiles[0].header_nslots == 64);
     assert(config.profiles[0].pool_count == 1);
     assert(config.profiles[0].pools[0].pool_id == 1);
     assert(config.profiles[0].pools[0].stride_bytes == 1048576);
+    assert(config.profiles[0].numa.mode == TP_NUMA_PREFERRED);
+    assert(config.profiles[0].numa.nodes == 1ULL);
+    assert(!config.streams[0].numa_configured);
 
     tp_driver_config_close(&config);
 
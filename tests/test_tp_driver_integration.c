@@ -12,6 +12,7 @@
 #include "tensor_pool/tp_discovery_client.h"
 #include "tensor_pool/tp_error.h"
 #include "tensor_pool/tp_producer.h"
+#include "tensor_pool/tp_shm.h"
 #include "tensor_pool/tp_consumer.h"
 #include "tensor_pool/tp_types.h"
 
@@ -24,10 +25,17 @@
 #include "driver/tensor_pool/hugepagesPolicy.h"
 #include "driver/tensor_pool/shmAttachResponse.h"
 
+#include "wire/tensor_pool/shmRegionSuperblock.h"
+
 #include <assert.h>
+#include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/statfs.h>
 #include <time.h>
 #include <unistd.h>
@@ -88,6 +96,175 @@ static int tp_test_is_hugepages_dir(const char *path)
     return (st.f_type == HUGETLBFS_MAGIC) ? 1 : 0;
 }
 
+/* Splits a driver region URI into its file path, epoch directory and stream directory. */
+static int tp_test_region_dirs(
+    const char *uri,
+    char *path,
+    size_t path_len,
+    char *epoch_dir,
+    char *stream_dir,
+    size_t dir_len)
+{
+    const char *prefix = "shm:file?path=";
+    const char *start;
+    const char *end;
+    char *slash;
+    size_t len;
+
+    if (NULL == uri || strncmp(uri, prefix, strlen(prefix)) != 0)
+    {
+        return -1;
+    }
+
+    start = uri + strlen(prefix);
+    end = strchr(start, '|');
+    len = NULL == end ? strlen(start) : (size_t)(end - start);
+    if (len >= path_len || len >= dir_len)
+    {
+        return -1;
+    }
+    memcpy(path, start, len);
+    path[len] = '\0';
+
+    memcpy(epoch_dir, path, len + 1);
+    slash = strrchr(epoch_dir, '/');
+    if (NULL == slash)
+    {
+        return -1;
+    }
+    *slash = '\0';
+
+    memcpy(stream_dir, epoch_dir, strlen(epoch_dir) + 1);
+    slash = strrchr(stream_dir, '/');
+    if (NULL == slash)
+    {
+        return -1;
+    }
+    *slash = '\0';
+    return 0;
+}
+
+/* Returns the numeric epoch directories under stream_dir, in no particular order. */
+static size_t tp_test_list_epochs(const char *stream_dir, uint64_t *epochs, size_t capacity)
+{
+    DIR *dir = opendir(stream_dir);
+    struct dirent *entry;
+    size_t count = 0;
+
+    if (NULL == dir)
+    {
+        return 0;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        char *endptr = NULL;
+        uint64_t epoch = strtoull(entry->d_name, &endptr, 10);
+
+        if (entry->d_name[0] == '.' || endptr == entry->d_name || *endptr != '\0')
+        {
+            continue;
+        }
+        if (count < capacity)
+        {
+            epochs[count] = epoch;
+        }
+        count++;
+    }
+
+    closedir(dir);
+    return count;
+}
+
+static int tp_test_read_superblock(const char *path, uint64_t *epoch, uint64_t *start_timestamp_ns)
+{
+    uint8_t buffer[TP_SUPERBLOCK_SIZE_BYTES];
+    struct tensor_pool_shmRegionSuperblock block;
+    ssize_t read_len;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+    read_len = pread(fd, buffer, sizeof(buffer), 0);
+    close(fd);
+    if (read_len != (ssize_t)sizeof(buffer))
+    {
+        return -1;
+    }
+
+    tensor_pool_shmRegionSuperblock_wrap_for_decode(
+        &block,
+        (char *)buffer,
+        0,
+        tensor_pool_shmRegionSuperblock_sbe_block_length(),
+        tensor_pool_shmRegionSuperblock_sbe_schema_version(),
+        sizeof(buffer));
+    if (tensor_pool_shmRegionSuperblock_magic(&block) != TP_MAGIC_U64)
+    {
+        return -1;
+    }
+
+    *epoch = tensor_pool_shmRegionSuperblock_epoch(&block);
+    *start_timestamp_ns = tensor_pool_shmRegionSuperblock_startTimestampNs(&block);
+    return 0;
+}
+
+/* The spare of a stream is the one epoch directory ahead of the current epoch. */
+static uint64_t tp_test_find_spare(const char *stream_dir, uint64_t current)
+{
+    uint64_t epochs[16];
+    uint64_t spare = 0;
+    size_t count = tp_test_list_epochs(stream_dir, epochs, 16);
+    size_t i;
+
+    for (i = 0; i < count && i < 16; i++)
+    {
+        if (epochs[i] > current && (spare == 0 || epochs[i] < spare))
+        {
+            spare = epochs[i];
+        }
+    }
+    return spare;
+}
+
+/* Pumps the driver until both of the spare's superblocks are written, then drains its result. */
+static int tp_test_wait_spare_built(
+    tp_driver_t *driver,
+    const char *stream_dir,
+    uint64_t spare,
+    const char *header_name,
+    const char *pool_name)
+{
+    char header_path[4096];
+    char pool_path[4096];
+    int64_t deadline_ns = tp_clock_now_ns() + 5 * 1000 * 1000 * 1000LL;
+    uint64_t epoch;
+    uint64_t start_ns;
+    int i;
+
+    snprintf(header_path, sizeof(header_path), "%s/%" PRIu64 "/%s", stream_dir, spare, header_name);
+    snprintf(pool_path, sizeof(pool_path), "%s/%" PRIu64 "/%s", stream_dir, spare, pool_name);
+    while (tp_test_read_superblock(header_path, &epoch, &start_ns) < 0 ||
+        tp_test_read_superblock(pool_path, &epoch, &start_ns) < 0)
+    {
+        if (tp_clock_now_ns() > deadline_ns)
+        {
+            return -1;
+        }
+        tp_driver_do_work(driver);
+        tp_test_sleep_ms(1);
+    }
+
+    for (i = 0; i < 20; i++)
+    {
+        tp_driver_do_work(driver);
+        tp_test_sleep_ms(1);
+    }
+    return 0;
+}
+
 static int tp_test_driver_attach_with_work(
     tp_driver_t *driver,
     tp_driver_client_t *client,
@@ -745,6 +922,7 @@ void tp_test_driver_publish_mode_hugepages(void)
     int result = -1;
     int step = 0;
     int expect_hugepages_ok;
+    int expect_thp_ok;
 
     memset(&driver, 0, sizeof(driver));
     client = NULL;
@@ -836,6 +1014,32 @@ void tp_test_driver_publish_mode_hugepages(void)
     {
         assert(info.code == tensor_pool_responseCode_REJECTED);
     }
+    tp_driver_attach_info_close(&info);
+
+    expect_thp_ok = tp_shm_transparent_hugepages_supported(driver_config.shm_base_dir);
+
+    memset(&info, 0, sizeof(info));
+    request.correlation_id++;
+    request.require_hugepages = tensor_pool_hugepagesPolicy_TRANSPARENT;
+
+    if (tp_test_driver_attach_with_work(&driver, driver_client, client, &request, &info, 2 * 1000 * 1000 * 1000LL) < 0)
+    {
+        goto cleanup;
+    }
+    step = 3;
+    if (expect_thp_ok == 1)
+    {
+        assert(info.code == tensor_pool_responseCode_OK);
+        assert(strstr(info.header_region_uri, "|transparent_hugepages=true") != NULL);
+        if (tp_test_driver_detach_with_work(&driver, driver_client, client, 2 * 1000 * 1000 * 1000LL) < 0)
+        {
+            goto cleanup;
+        }
+    }
+    else
+    {
+        assert(info.code == tensor_pool_responseCode_REJECTED);
+    }
 
     result = 0;
 
@@ -1097,6 +1301,221 @@ cleanup:
     assert(result == 0);
 }
 
+void tp_test_driver_spare_epochs(void)
+{
+    tp_driver_config_t driver_config;
+    tp_driver_t driver;
+    tp_context_t *ctx = NULL;
+    tp_client_t *client = NULL;
+    tp_driver_client_t *producer_client = NULL;
+    tp_driver_client_t *observer_client = NULL;
+    tp_driver_attach_request_t request;
+    tp_driver_attach_request_t observer_request;
+    tp_driver_attach_info_t info;
+    char header_path[4096];
+    char pool_path[4096];
+    char epoch_dir[4096];
+    char stream_dir[4096];
+    char stale_dir[4096];
+    char header_name[256];
+    char pool_name[256];
+    struct stat st;
+    uint64_t spare;
+    uint64_t epoch;
+    uint64_t start_ns;
+    int64_t before_promote_ns;
+    int result = -1;
+    int step = 0;
+
+    memset(&driver, 0, sizeof(driver));
+    memset(&info, 0, sizeof(info));
+    stale_dir[0] = '\0';
+
+    if (tp_driver_config_init(&driver_config) < 0)
+    {
+        goto cleanup;
+    }
+    if (tp_driver_config_load(&driver_config, TP_TEST_CONFIG_PATH("driver_integration_example.toml")) < 0)
+    {
+        goto cleanup;
+    }
+    strncpy(driver_config.shm_namespace, "test-spare", sizeof(driver_config.shm_namespace) - 1);
+    driver_config.spare_epochs = true;
+    driver_config.epoch_gc_enabled = true;
+
+    if (tp_driver_init(&driver, &driver_config) < 0)
+    {
+        goto cleanup;
+    }
+    if (tp_driver_start(&driver) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_context_init(&ctx) < 0)
+    {
+        goto cleanup;
+    }
+    tp_context_set_use_agent_invoker(ctx, true);
+    tp_context_set_control_channel(
+        ctx,
+        tp_context_get_control_channel(driver.config.base),
+        tp_context_get_control_stream_id(driver.config.base));
+
+    if (tp_client_init(&client, ctx) < 0)
+    {
+        goto cleanup;
+    }
+    if (tp_client_start(client) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_driver_client_init(&producer_client, client) < 0 ||
+        tp_driver_client_init(&observer_client, client) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Producer attaches and detaches each move the stream to a new epoch; consumers only observe it. */
+    memset(&request, 0, sizeof(request));
+    request.correlation_id = 1;
+    request.stream_id = 10000;
+    request.client_id = 0;
+    request.role = tensor_pool_role_PRODUCER;
+    request.expected_layout_version = TP_LAYOUT_VERSION;
+    request.publish_mode = tensor_pool_publishMode_EXISTING_OR_CREATE;
+    request.require_hugepages = 0;
+    request.desired_node_id = TP_NULL_U32;
+    observer_request = request;
+    observer_request.correlation_id = 1000;
+    observer_request.role = tensor_pool_role_CONSUMER;
+
+    if (tp_test_driver_attach_with_work(&driver, producer_client, client, &request, &info, 5 * 1000 * 1000 * 1000LL) < 0)
+    {
+        goto cleanup;
+    }
+    step = 1;
+    if (info.code != tensor_pool_responseCode_OK || info.pool_count != 1 ||
+        tp_test_region_dirs(info.header_region_uri, header_path, sizeof(header_path),
+            epoch_dir, stream_dir, sizeof(epoch_dir)) < 0 ||
+        tp_test_region_dirs(info.pools[0].region_uri, pool_path, sizeof(pool_path),
+            epoch_dir, stream_dir, sizeof(epoch_dir)) < 0)
+    {
+        goto cleanup;
+    }
+    snprintf(header_name, sizeof(header_name), "%s", strrchr(header_path, '/') + 1);
+    snprintf(pool_name, sizeof(pool_name), "%s", strrchr(pool_path, '/') + 1);
+
+    /* The next epoch starts building as soon as the first one is ready. */
+    spare = tp_test_find_spare(stream_dir, info.epoch);
+    step = 2;
+    if (spare == 0)
+    {
+        goto cleanup;
+    }
+
+    /*
+     * Detach straight away, long before the spare's 64 MiB pool has been prefaulted, so the
+     * spare is promoted while still building and consumers wait for it rather than a fresh epoch.
+     */
+    if (tp_test_driver_detach_with_work(&driver, producer_client, client, 2 * 1000 * 1000 * 1000LL) < 0)
+    {
+        goto cleanup;
+    }
+    tp_driver_attach_info_close(&info);
+    memset(&info, 0, sizeof(info));
+    if (tp_test_driver_attach_with_work(
+            &driver, observer_client, client, &observer_request, &info, 5 * 1000 * 1000 * 1000LL) < 0)
+    {
+        goto cleanup;
+    }
+    step = 3;
+    if (info.code != tensor_pool_responseCode_OK || info.epoch != spare)
+    {
+        goto cleanup;
+    }
+    if (tp_test_driver_detach_with_work(&driver, observer_client, client, 2 * 1000 * 1000 * 1000LL) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Let the following spare finish so the next producer attach promotes a ready one. */
+    spare = tp_test_find_spare(stream_dir, info.epoch);
+    step = 4;
+    if (spare == 0 || tp_test_wait_spare_built(&driver, stream_dir, spare, header_name, pool_name) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* An epoch directory ahead of the stream that is not its spare was abandoned and must go. */
+    snprintf(stale_dir, sizeof(stale_dir), "%s/%" PRIu64, stream_dir, UINT64_MAX / 2);
+    step = 5;
+    if (mkdir(stale_dir, 0700) != 0)
+    {
+        stale_dir[0] = '\0';
+        goto cleanup;
+    }
+
+    before_promote_ns = tp_clock_now_ns();
+    tp_driver_attach_info_close(&info);
+    memset(&info, 0, sizeof(info));
+    request.correlation_id++;
+    if (tp_test_driver_attach_with_work(&driver, producer_client, client, &request, &info, 5 * 1000 * 1000 * 1000LL) < 0)
+    {
+        goto cleanup;
+    }
+    step = 6;
+    if (info.code != tensor_pool_responseCode_OK || info.epoch != spare)
+    {
+        goto cleanup;
+    }
+
+    /* A promoted spare is restamped so it reads as created at promotion, not when it was built. */
+    snprintf(header_path, sizeof(header_path), "%s/%" PRIu64 "/%s", stream_dir, spare, header_name);
+    step = 7;
+    if (tp_test_read_superblock(header_path, &epoch, &start_ns) < 0 ||
+        epoch != spare ||
+        start_ns < (uint64_t)before_promote_ns)
+    {
+        goto cleanup;
+    }
+
+    step = 8;
+    if (stat(stale_dir, &st) == 0 || errno != ENOENT)
+    {
+        goto cleanup;
+    }
+    stale_dir[0] = '\0';
+
+    /* Promotion leaves the stream with a new spare of its own. */
+    step = 9;
+    if (tp_test_find_spare(stream_dir, info.epoch) == 0)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    if (stale_dir[0] != '\0')
+    {
+        rmdir(stale_dir);
+    }
+    tp_driver_attach_info_close(&info);
+    tp_driver_client_close(observer_client);
+    tp_driver_client_close(producer_client);
+    tp_client_close(client);
+    tp_driver_close(&driver);
+
+    if (result != 0)
+    {
+        fprintf(stderr, "tp_test_driver_spare_epochs failed at step %d: %s\n", step, tp_errmsg());
+    }
+
+    assert(result == 0);
+}
+
 void tp_test_driver_async_attach_wrappers(void)
 {
     tp_driver_config_t driver_config;
@@ -0,0 +1,179 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tp_driver_provision.h"
+#include "tensor_pool/tp_shm.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static void tp_test_fill_spec(tp_driver_region_spec_t *spec, const char *dir, const char *name, size_t size, uint8_t tag)
+{
+    memset(spec, 0, sizeof(*spec));
+    snprintf(spec->path, sizeof(spec->path), "%s/%s", dir, name);
+    spec->file_size = size;
+    spec->file_mode = 0600;
+    memset(spec->superblock, tag, sizeof(spec->superblock));
+}
+
+static int tp_test_check_region(const tp_driver_region_spec_t *spec)
+{
+    uint8_t buffer[TP_SUPERBLOCK_SIZE_BYTES];
+    struct stat st;
+    int fd;
+    int result = -1;
+
+    if (stat(spec->path, &st) != 0 || (size_t)st.st_size != spec->file_size)
+    {
+        return -1;
+    }
+
+    fd = open(spec->path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (pread(fd, buffer, sizeof(buffer), 0) == (ssize_t)sizeof(buffer) &&
+        memcmp(buffer, spec->superblock, sizeof(buffer)) == 0)
+    {
+        result = 0;
+    }
+    close(fd);
+    return result;
+}
+
+static int tp_test_wait_result(tp_driver_provision_t *pool, tp_driver_provision_result_t *result)
+{
+    int attempts;
+
+    for (attempts = 0; attempts < 1000000; attempts++)
+    {
+        int polled = tp_driver_provision_poll(pool, result);
+        if (polled != 0)
+        {
+            return polled;
+        }
+        sched_yield();
+    }
+
+    return 0;
+}
+
+void tp_test_driver_provision(void)
+{
+    char dir[] = "/tmp/tp_provision_XXXXXX";
+    tp_driver_region_spec_t specs[3];
+    tp_driver_region_spec_t missing;
+    tp_driver_region_spec_t huge;
+    tp_driver_provision_t *pool = NULL;
+    tp_driver_provision_t *inline_pool = NULL;
+    tp_driver_provision_result_t result;
+    tp_numa_policy_t numa;
+    size_t i;
+    int test_result = -1;
+
+    assert(NULL != mkdtemp(dir));
+    assert(tp_driver_provision_init(NULL, 1, 0, true, false) < 0);
+    assert(tp_driver_provision_poll(NULL, &result) < 0);
+
+    tp_test_fill_spec(&specs[0], dir, "header.ring", TP_SUPERBLOCK_SIZE_BYTES + 40000, 0xA1);
+    tp_test_fill_spec(&specs[1], dir, "1.pool", TP_SUPERBLOCK_SIZE_BYTES + 128, 0xB2);
+    tp_test_fill_spec(&specs[2], dir, "2.pool", TP_SUPERBLOCK_SIZE_BYTES + 70000, 0xC3);
+    tp_test_fill_spec(&missing, dir, "absent/1.pool", 4096, 0xD4);
+    tp_test_fill_spec(&huge, dir, "3.pool", TP_SUPERBLOCK_SIZE_BYTES + 3u * 1024u * 1024u, 0xE5);
+    huge.transparent_hugepages = true;
+
+    if (tp_driver_provision_init(&pool, 3, 16384, true, false) < 0 ||
+        tp_driver_provision_worker_count(pool) != 3)
+    {
+        goto cleanup;
+    }
+
+    /* Files that cannot be opened fail the submit itself. */
+    if (tp_driver_provision_submit(pool, 7, 1, &missing, 1, NULL) == 0)
+    {
+        goto cleanup;
+    }
+
+    /* Node 0 exists on every host, so the policy never stops the epoch from building. */
+    memset(&numa, 0, sizeof(numa));
+    numa.mode = TP_NUMA_PREFERRED;
+    numa.nodes = 1ULL;
+    if (tp_driver_provision_submit(pool, 7, 2, specs, 3, &numa) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_test_wait_result(pool, &result) != 1 ||
+        result.stream_id != 7 || result.epoch != 2 || result.error != 0)
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        if (tp_test_check_region(&specs[i]) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    if (tp_driver_provision_poll(pool, &result) != 0)
+    {
+        goto cleanup;
+    }
+
+    /*
+     * Hugepage regions are chunked on 2 MiB boundaries, so only the first chunk is a hugepage
+     * target; hosts without transparent hugepages for tmpfs build it on small pages.
+     */
+    if (tp_driver_provision_submit(pool, 9, 1, &huge, 1, NULL) < 0 ||
+        tp_test_wait_result(pool, &result) != 1 ||
+        result.stream_id != 9 || result.error != 0 ||
+        result.hugepage_target_bytes != TP_SHM_TRANSPARENT_HUGEPAGE_BYTES ||
+        result.hugepage_bytes > result.hugepage_target_bytes ||
+        tp_test_check_region(&huge) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Without workers the epoch is complete as soon as submit returns. */
+    if (tp_driver_provision_init(&inline_pool, 0, 0, false, false) < 0)
+    {
+        goto cleanup;
+    }
+    specs[1].superblock[0] = 0xEE;
+    if (tp_driver_provision_submit(inline_pool, 8, 3, &specs[1], 1, NULL) < 0 ||
+        tp_driver_provision_poll(inline_pool, &result) != 1 ||
+        result.stream_id != 8 || result.epoch != 3 || result.error != 0 ||
+        tp_test_check_region(&specs[1]) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Closing with an epoch still queued releases its files. */
+    if (tp_driver_provision_submit(pool, 7, 4, specs, 3, NULL) < 0)
+    {
+        goto cleanup;
+    }
+
+    test_result = 0;
+
+cleanup:
+    tp_driver_provision_close(pool);
+    tp_driver_provision_close(inline_pool);
+    for (i = 0; i < 3; i++)
+    {
+        unlink(specs[i].path);
+    }
+    unlink(huge.path);
+    rmdir(dir);
+    assert(test_result == 0);
+}
@@ -0,0 +1,200 @@
+#include "tensor_pool/internal/tp_client_internal.h"
+#include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/internal/tp_producer_internal.h"
+#include "tensor_pool/tp_clock.h"
+#include "tensor_pool/tp_latency.h"
+#include "tensor_pool/tp_slot.h"
+#include "tensor_pool/tp_types.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+int tp_producer_publish_frame(
+    tp_producer_t *producer,
+    uint64_t seq,
+    const tp_tensor_header_t *tensor,
+    const void *payload,
+    uint32_t payload_len,
+    uint16_t pool_id,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id);
+
+static void test_latency_histogram_percentiles(void)
+{
+    tp_latency_histogram_t *histogram = calloc(1, sizeof(*histogram));
+    tp_latency_summary_t summary;
+    uint64_t value;
+
+    assert(NULL != histogram);
+    assert(tp_latency_histogram_percentile(histogram, 50.0) == 0);
+    assert(tp_latency_histogram_summarize(histogram, NULL) < 0);
+
+    /* Small values have exact buckets. */
+    for (value = 1; value <= 10; value++)
+    {
+        tp_latency_histogram_record(histogram, value);
+    }
+    assert(histogram->count == 10);
+    assert(histogram->min_ns == 1);
+    assert(tp_latency_histogram_percentile(histogram, 50.0) == 5);
+    assert(tp_latency_histogram_percentile(histogram, 100.0) == 10);
+
+    /* Larger values are reported within 1/16 of the true percentile. */
+    tp_latency_histogram_reset(histogram);
+    for (value = 1; value <= 1000; value++)
+    {
+        tp_latency_histogram_record(histogram, value * 1000);
+    }
+    assert(tp_latency_histogram_summarize(histogram, &summary) == 0);
+    assert(summary.count == 1000);
+    assert(summary.p50_ns >= 500000 && summary.p50_ns <= 500000 + 500000 / 16);
+    assert(summary.p90_ns >= 900000 && summary.p90_ns <= 900000 + 900000 / 16);
+    assert(summary.p99_ns >= 990000 && summary.p99_ns <= 1000000);
+    assert(summary.max_ns == 1000000);
+
+    /* Out-of-range values land in the last bucket without losing the true max. */
+    tp_latency_histogram_reset(histogram);
+    tp_latency_histogram_record(histogram, UINT64_MAX);
+    assert(histogram->counts[TP_LATENCY_BUCKETS - 1] == 1);
+    assert(histogram->max_ns == UINT64_MAX);
+
+    free(histogram);
+}
+
+static void test_consumer_records_latency(void)
+{
+    tp_client_t client;
+    tp_producer_t producer;
+    tp_consumer_t consumer;
+    tp_payload_pool_t producer_pool;
+    tp_consumer_pool_t consumer_pool;
+    tp_tensor_header_t header;
+    tp_latency_histogram_t *arrival = calloc(1, sizeof(*arrival));
+    tp_latency_histogram_t *read = calloc(1, sizeof(*read));
+    tp_latency_histogram_t *snapshot = calloc(1, sizeof(*snapshot));
+    tp_frame_view_t view;
+    uint8_t payload[8];
+    uint8_t *header_region = NULL;
+    uint8_t *pool_region = NULL;
+    uint32_t header_nslots = 4;
+    uint32_t stride_bytes = 64;
+    size_t header_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * TP_HEADER_SLOT_BYTES);
+    size_t pool_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * stride_bytes);
+    uint64_t stamped_ns;
+    int result = -1;
+
+    memset(&client, 0, sizeof(client));
+    memset(&producer, 0, sizeof(producer));
+    memset(&consumer, 0, sizeof(consumer));
+    memset(&producer_pool, 0, sizeof(producer_pool));
+    memset(&consumer_pool, 0, sizeof(consumer_pool));
+    memset(&header, 0, sizeof(header));
+    memset(payload, 7, sizeof(payload));
+
+    if (NULL == arrival || NULL == read || NULL == snapshot || tp_context_init(&client.context) < 0)
+    {
+        goto cleanup;
+    }
+
+    header_region = calloc(1, header_size);
+    pool_region = calloc(1, pool_size);
+    if (NULL == header_region || NULL == pool_region)
+    {
+        goto cleanup;
+    }
+
+    producer.client = &client;
+    producer.header_region.addr = header_region;
+    producer.header_nslots = header_nslots;
+    producer.pool_count = 1;
+    producer.pools = &producer_pool;
+    producer.stream_id = 1;
+    producer.epoch = 1;
+
+    producer_pool.pool_id = 1;
+    producer_pool.nslots = header_nslots;
+    producer_pool.stride_bytes = stride_bytes;
+    producer_pool.region.addr = pool_region;
+
+    consumer.client = &client;
+    consumer.use_shm = true;
+    consumer.shm_mapped = true;
+    consumer.header_region.addr = header_region;
+    consumer.header_nslots = header_nslots;
+    consumer.pool_count = 1;
+    consumer.pools = &consumer_pool;
+    consumer.stream_id = 1;
+    consumer.epoch = 1;
+    consumer.arrival_latency = arrival;
+    consumer.read_latency = read;
+
+    consumer_pool.pool_id = 1;
+    consumer_pool.nslots = header_nslots;
+    consumer_pool.stride_bytes = stride_bytes;
+    consumer_pool.region.addr = pool_region;
+
+    header.dtype = TP_DTYPE_UINT8;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = sizeof(payload);
+
+    stamped_ns = (uint64_t)tp_clock_now_ns() - 1000000;
+    tp_producer_publish_frame(&producer, 0, &header, payload, sizeof(payload), 1, stamped_ns, 0, 0);
+    tp_producer_publish_frame(&producer, 1, &header, payload, sizeof(payload), 1, stamped_ns, 0, 0);
+    /* A timestamp from another clock domain must not be recorded. */
+    tp_producer_publish_frame(&producer, 2, &header, payload, sizeof(payload), 1, UINT64_MAX - 1, 0, 0);
+
+    consumer.descriptor_rx_ns = stamped_ns + 400000;
+    consumer.descriptor_rx_seq = 0;
+    consumer.has_descriptor_rx = true;
+
+    if (tp_consumer_read_frame(&consumer, 0, &view) != 0 ||
+        tp_consumer_read_frame(&consumer, 0, &view) != 0 ||
+        tp_consumer_read_frame(&consumer, 1, &view) != 0 ||
+        tp_consumer_read_frame(&consumer, 2, &view) != 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_get_latency(&consumer, NULL, snapshot) < 0 ||
+        snapshot->count != 3 ||
+        snapshot->min_ns < 1000000)
+    {
+        goto cleanup;
+    }
+    if (tp_consumer_get_latency(&consumer, snapshot, NULL) < 0 ||
+        snapshot->count != 1 ||
+        snapshot->max_ns != 400000)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_reset_latency(&consumer) < 0 || arrival->count != 0 || read->count != 0)
+    {
+        goto cleanup;
+    }
+
+    consumer.read_latency = NULL;
+    if (tp_consumer_get_latency(&consumer, snapshot, snapshot) >= 0)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    free(header_region);
+    free(pool_region);
+    free(arrival);
+    free(read);
+    free(snapshot);
+    assert(result == 0);
+}
+
+void tp_test_latency(void)
+{
+    test_latency_histogram_percentiles();
+    test_consumer_records_latency();
+}
@@ -0,0 +1,161 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/internal/tp_consumer_internal.h"
+#include "tensor_pool/tp_error.h"
+#include "tensor_pool/tp_numa.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+static void test_numa_modes(void)
+{
+    tp_numa_mode_t mode = TP_NUMA_DEFAULT;
+
+    assert(tp_numa_parse_mode("preferred", &mode) == 0 && mode == TP_NUMA_PREFERRED);
+    assert(tp_numa_parse_mode("bind", &mode) == 0 && mode == TP_NUMA_BIND);
+    assert(tp_numa_parse_mode("interleave", &mode) == 0 && mode == TP_NUMA_INTERLEAVE);
+    assert(tp_numa_parse_mode("default", &mode) == 0 && mode == TP_NUMA_DEFAULT);
+    assert(tp_numa_parse_mode("local", &mode) < 0);
+    assert(tp_numa_parse_mode(NULL, &mode) < 0);
+    assert(strcmp(tp_numa_mode_name(TP_NUMA_INTERLEAVE), "interleave") == 0);
+}
+
+/* Runs on single-node hosts too: node 0 always exists, and platforms without NUMA say ENOSYS. */
+static void test_numa_apply_file(void)
+{
+    char path[] = "/tmp/tp_numa_XXXXXX";
+    tp_numa_policy_t policy;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = page * 4;
+    void *addr = MAP_FAILED;
+    int node_count = tp_numa_node_count();
+    int node = -1;
+    int fd;
+    int result = -1;
+
+    assert(node_count >= 1);
+    fd = mkstemp(path);
+    assert(fd >= 0);
+    unlink(path);
+    if (ftruncate(fd, (off_t)length) != 0)
+    {
+        goto cleanup;
+    }
+
+    addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        goto cleanup;
+    }
+
+    memset(&policy, 0, sizeof(policy));
+    assert(tp_numa_apply(NULL, length, &policy) < 0);
+    if (tp_numa_apply(addr, length, &policy) != 0)
+    {
+        goto cleanup;
+    }
+
+    policy.mode = TP_NUMA_PREFERRED;
+    if (tp_numa_apply(addr, length, &policy) == 0)
+    {
+        goto cleanup;
+    }
+
+    policy.nodes = 1ULL << 0;
+    if (tp_numa_apply(addr, length, &policy) != 0 && tp_errcode() != ENOSYS)
+    {
+        goto cleanup;
+    }
+
+    memset(addr, 1, length);
+    if (tp_numa_node_of((uint8_t *)addr + page, &node) != 0 || node < 0 || node >= TP_NUMA_MAX_NODES)
+    {
+        goto cleanup;
+    }
+
+    if (node_count < TP_NUMA_MAX_NODES)
+    {
+        policy.mode = TP_NUMA_BIND;
+        policy.nodes = 1ULL << (TP_NUMA_MAX_NODES - 1);
+        if (tp_numa_apply(addr, length, &policy) == 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    policy.mode = TP_NUMA_INTERLEAVE;
+    policy.nodes = 0;
+    if (tp_numa_apply(addr, length, &policy) != 0 && tp_errcode() != ENOSYS)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    if (addr != MAP_FAILED)
+    {
+        munmap(addr, length);
+    }
+    close(fd);
+    assert(result == 0);
+}
+
+static void test_consumer_numa_node(void)
+{
+    tp_consumer_t consumer;
+    tp_consumer_pool_t pool;
+    uint8_t *header_region = NULL;
+    uint8_t *pool_region = NULL;
+    size_t region_size = TP_SUPERBLOCK_SIZE_BYTES + 4096;
+    int node = -1;
+    int result = -1;
+
+    memset(&consumer, 0, sizeof(consumer));
+    memset(&pool, 0, sizeof(pool));
+    assert(tp_consumer_get_numa_node(NULL, 0, &node) < 0);
+    assert(tp_consumer_get_numa_node(&consumer, 0, &node) < 0);
+
+    header_region = calloc(1, region_size);
+    pool_region = calloc(1, region_size);
+    if (NULL == header_region || NULL == pool_region)
+    {
+        goto cleanup;
+    }
+
+    consumer.shm_mapped = true;
+    consumer.header_region.addr = header_region;
+    consumer.header_region.length = region_size;
+    consumer.pool_count = 1;
+    consumer.pools = &pool;
+    pool.pool_id = 3;
+    pool.region.addr = pool_region;
+    pool.region.length = region_size;
+
+    if (tp_consumer_get_numa_node(&consumer, 0, &node) < 0 || node < 0 ||
+        tp_consumer_get_numa_node(&consumer, 3, &node) < 0 || node < 0 ||
+        tp_consumer_get_numa_node(&consumer, 9, &node) == 0)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    free(header_region);
+    free(pool_region);
+    assert(result == 0);
+}
+
+void tp_test_numa(void)
+{
+    test_numa_modes();
+    test_numa_apply_file();
+    test_consumer_numa_node();
+}
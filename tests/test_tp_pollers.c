@@ -15,6 +15,7 @@
 #include "tensor_pool/internal/tp_producer_internal.h"
 #include "tensor_pool/internal/tp_qos.h"
 #include "tensor_pool/tp_slot.h"
+#include "tensor_pool/tp_tensor.h"
 
 #include "aeronc.h"
 #include "tp_aeron_wrap.h"
@@ -46,6 +47,17 @@
 #include <time.h>
 #include <unistd.h>
 
+int tp_producer_publish_frame(
+    tp_producer_t *producer,
+    uint64_t seq,
+    const tp_tensor_header_t *tensor,
+    const void *payload,
+    uint32_t payload_len,
+    uint16_t pool_id,
+    uint64_t timestamp_ns,
+    uint32_t meta_version,
+    uint64_t trace_id);
+
 static bool tp_test_has_aeron_dir(const tp_client_t *client)
 {
     const char *dir = tp_context_get_aeron_dir(client->context);
@@ -1087,7 +1099,7 @@ void tp_test_rate_limit(void)
     }
 
     entry = tp_test_find_consumer_entry(manager, 44);
-    if (NULL == entry || NULL == entry->descriptor_publication)
+    if (NULL == entry || NULL == entry->hot->descriptor_publication)
     {
         goto cleanup;
     }
@@ -1095,7 +1107,7 @@ void tp_test_rate_limit(void)
     while (tp_clock_now_ns() < deadline)
     {
         if (aeron_subscription_is_connected(tp_subscription_handle(descriptor_sub)) &&
-            aeron_publication_is_connected(tp_publication_handle(entry->descriptor_publication)))
+            aeron_publication_is_connected(tp_publication_handle(entry->hot->descriptor_publication)))
         {
             break;
         }
@@ -1106,7 +1118,7 @@ void tp_test_rate_limit(void)
         }
     }
     if (!aeron_subscription_is_connected(tp_subscription_handle(descriptor_sub)) ||
-        !aeron_publication_is_connected(tp_publication_handle(entry->descriptor_publication)))
+        !aeron_publication_is_connected(tp_publication_handle(entry->hot->descriptor_publication)))
     {
         goto cleanup;
     }
@@ -1593,6 +1605,421 @@ cleanup:
     assert(result == 0);
 }
 
+void tp_test_consumer_poll_frames(void)
+{
+    tp_context_t *ctx = NULL;
+    tp_client_t *client = NULL;
+    tp_consumer_context_t consumer_ctx;
+    tp_consumer_t *consumer = NULL;
+    tp_producer_t writer;
+    tp_payload_pool_t writer_pool;
+    tp_tensor_header_t tensor;
+    tp_publication_t *descriptor_pub = NULL;
+    int header_fd = -1;
+    int pool_fd = -1;
+    char header_path[] = "/tmp/tp_poll_frames_headerXXXXXX";
+    char pool_path[] = "/tmp/tp_poll_frames_poolXXXXXX";
+    char header_uri[256];
+    char pool_uri[256];
+    tp_consumer_config_t config;
+    tp_consumer_pool_config_t pool_cfg;
+    uint8_t buffer[256];
+    struct tensor_pool_messageHeader header;
+    struct tensor_pool_frameDescriptor descriptor;
+    const size_t header_len = tensor_pool_messageHeader_encoded_length();
+    const size_t body_len = tensor_pool_frameDescriptor_sbe_block_length();
+    tp_frame_view_t views[4];
+    uint8_t payload[16];
+    size_t received = 0;
+    uint64_t seq;
+    int result = -1;
+    int64_t deadline;
+
+    if (tp_test_start_client_any(&client, &ctx, 0) < 0)
+    {
+        return;
+    }
+
+    if (tp_consumer_context_init(&consumer_ctx) < 0)
+    {
+        goto cleanup;
+    }
+    consumer_ctx.stream_id = 82002;
+    consumer_ctx.consumer_id = 10;
+
+    if (tp_consumer_init(&consumer, client, &consumer_ctx) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_test_add_publication(client, "aeron:ipc", 1100, &descriptor_pub) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_test_wait_for_publication(client, descriptor_pub) < 0)
+    {
+        goto cleanup;
+    }
+
+    header_fd = mkstemp(header_path);
+    pool_fd = mkstemp(pool_path);
+    if (header_fd < 0 || pool_fd < 0)
+    {
+        goto cleanup;
+    }
+
+    if (ftruncate(header_fd, TP_SUPERBLOCK_SIZE_BYTES + TP_HEADER_SLOT_BYTES * 4) != 0 ||
+        ftruncate(pool_fd, TP_SUPERBLOCK_SIZE_BYTES + 64 * 4) != 0)
+    {
+        goto cleanup;
+    }
+
+    tp_test_write_superblock(header_fd, 82002, 1, tensor_pool_regionType_HEADER_RING, 0, 4, TP_HEADER_SLOT_BYTES, 0);
+    tp_test_write_superblock(pool_fd, 82002, 1, tensor_pool_regionType_PAYLOAD_POOL, 1, 4, TP_NULL_U32, 64);
+
+    snprintf(header_uri, sizeof(header_uri), "shm:file?path=%s", header_path);
+    snprintf(pool_uri, sizeof(pool_uri), "shm:file?path=%s", pool_path);
+
+    memset(&pool_cfg, 0, sizeof(pool_cfg));
+    pool_cfg.pool_id = 1;
+    pool_cfg.nslots = 4;
+    pool_cfg.stride_bytes = 64;
+    pool_cfg.uri = pool_uri;
+
+    memset(&config, 0, sizeof(config));
+    config.stream_id = 82002;
+    config.epoch = 1;
+    config.layout_version = 1;
+    config.header_nslots = 4;
+    config.header_uri = header_uri;
+    config.pools = &pool_cfg;
+    config.pool_count = 1;
+
+    if (tp_consumer_attach(consumer, &config) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Write committed slots straight into the consumer's mappings with a detached producer. */
+    memset(&writer, 0, sizeof(writer));
+    memset(&writer_pool, 0, sizeof(writer_pool));
+    writer.client = client;
+    writer.header_region.addr = consumer->header_region.addr;
+    writer.header_nslots = 4;
+    writer.pool_count = 1;
+    writer.pools = &writer_pool;
+    writer.stream_id = 82002;
+    writer.epoch = 1;
+    writer_pool.pool_id = 1;
+    writer_pool.nslots = 4;
+    writer_pool.stride_bytes = 64;
+    writer_pool.region.addr = consumer->pools[0].region.addr;
+
+    memset(&tensor, 0, sizeof(tensor));
+    tensor.dtype = TP_DTYPE_UINT8;
+    tensor.major_order = TP_MAJOR_ORDER_ROW;
+    tensor.ndims = 1;
+    tensor.progress_unit = TP_PROGRESS_NONE;
+    tensor.dims[0] = sizeof(payload);
+
+    tensor_pool_messageHeader_wrap(
+        &header,
+        (char *)buffer,
+        0,
+        tensor_pool_messageHeader_sbe_schema_version(),
+        sizeof(buffer));
+    tensor_pool_messageHeader_set_blockLength(&header, (uint16_t)body_len);
+    tensor_pool_messageHeader_set_templateId(&header, tensor_pool_frameDescriptor_sbe_template_id());
+    tensor_pool_messageHeader_set_schemaId(&header, tensor_pool_frameDescriptor_sbe_schema_id());
+    tensor_pool_messageHeader_set_version(&header, tensor_pool_frameDescriptor_sbe_schema_version());
+
+    tensor_pool_frameDescriptor_wrap_for_encode(&descriptor, (char *)buffer, header_len, sizeof(buffer));
+    tensor_pool_frameDescriptor_set_streamId(&descriptor, 82002);
+    tensor_pool_frameDescriptor_set_epoch(&descriptor, 1);
+    tensor_pool_frameDescriptor_set_timestampNs(&descriptor, 0);
+    tensor_pool_frameDescriptor_set_metaVersion(&descriptor, 0);
+    tensor_pool_frameDescriptor_set_traceId(&descriptor, 0);
+
+    for (seq = 1; seq <= 3; seq++)
+    {
+        memset(payload, (int)seq, sizeof(payload));
+        (void)tp_producer_publish_frame(&writer, seq, &tensor, payload, sizeof(payload), 1, 0, 0, 0);
+
+        tensor_pool_frameDescriptor_set_seq(&descriptor, seq);
+        if (tp_test_offer(client, descriptor_pub, buffer, header_len + body_len) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    /* seq 3 is reported but torn, so the batch must skip it and count it late. */
+    tp_atomic_store_u64((uint64_t *)tp_slot_at(consumer->header_region.addr, 3), tp_seq_in_progress(3));
+
+    deadline = tp_clock_now_ns() + 2 * 1000 * 1000 * 1000LL;
+    while (tp_clock_now_ns() < deadline && consumer->last_seq_seen < 3)
+    {
+        int frames = tp_consumer_poll_frames(consumer, views + received, 4 - received);
+        if (frames < 0)
+        {
+            goto cleanup;
+        }
+        received += (size_t)frames;
+        tp_client_do_work(client);
+        {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    if (received != 2 ||
+        views[0].seq != 1 ||
+        views[1].seq != 2 ||
+        views[0].payload_len != sizeof(payload) ||
+        views[1].payload[0] != 2 ||
+        consumer->drops_late != 1)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    if (descriptor_pub)
+    {
+        tp_publication_close(&descriptor_pub);
+    }
+    if (consumer)
+    {
+        tp_consumer_close(consumer);
+    }
+    if (tp_test_has_aeron_dir(client))
+    {
+        tp_client_close(client);
+    }
+    if (header_fd >= 0)
+    {
+        close(header_fd);
+        unlink(header_path);
+    }
+    if (pool_fd >= 0)
+    {
+        close(pool_fd);
+        unlink(pool_path);
+    }
+
+    assert(result == 0);
+}
+
+static void tp_on_rate_gate_descriptor(void *clientd, const tp_frame_descriptor_t *desc)
+{
+    int *delivered = (int *)clientd;
+
+    (void)desc;
+    (*delivered)++;
+}
+
+void tp_test_consumer_rate_gate(void)
+{
+    tp_context_t *ctx = NULL;
+    tp_client_t *client = NULL;
+    tp_consumer_context_t consumer_ctx;
+    tp_consumer_t *consumer = NULL;
+    tp_producer_t writer;
+    tp_payload_pool_t writer_pool;
+    tp_tensor_header_t tensor;
+    tp_publication_t *descriptor_pub = NULL;
+    int header_fd = -1;
+    int pool_fd = -1;
+    char header_path[] = "/tmp/tp_rate_gate_headerXXXXXX";
+    char pool_path[] = "/tmp/tp_rate_gate_poolXXXXXX";
+    char header_uri[256];
+    char pool_uri[256];
+    tp_consumer_config_t config;
+    tp_consumer_pool_config_t pool_cfg;
+    uint8_t buffer[256];
+    struct tensor_pool_messageHeader header;
+    struct tensor_pool_frameDescriptor descriptor;
+    const size_t header_len = tensor_pool_messageHeader_encoded_length();
+    const size_t body_len = tensor_pool_frameDescriptor_sbe_block_length();
+    uint8_t payload[16];
+    const uint64_t timestamps[4] = { 1000000000ULL, 1001000000ULL, 1200000000ULL, TP_NULL_U64 };
+    int delivered = 0;
+    uint64_t seq;
+    int result = -1;
+    int64_t deadline;
+
+    if (tp_test_start_client_any(&client, &ctx, 0) < 0)
+    {
+        return;
+    }
+
+    if (tp_consumer_context_init(&consumer_ctx) < 0)
+    {
+        goto cleanup;
+    }
+    consumer_ctx.stream_id = 82003;
+    consumer_ctx.consumer_id = 11;
+    consumer_ctx.hello.mode = TP_MODE_RATE_LIMITED;
+    consumer_ctx.hello.max_rate_hz = 10;
+
+    if (tp_consumer_init(&consumer, client, &consumer_ctx) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_test_add_publication(client, "aeron:ipc", 1100, &descriptor_pub) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_test_wait_for_publication(client, descriptor_pub) < 0)
+    {
+        goto cleanup;
+    }
+
+    header_fd = mkstemp(header_path);
+    pool_fd = mkstemp(pool_path);
+    if (header_fd < 0 || pool_fd < 0)
+    {
+        goto cleanup;
+    }
+
+    if (ftruncate(header_fd, TP_SUPERBLOCK_SIZE_BYTES + TP_HEADER_SLOT_BYTES * 4) != 0 ||
+        ftruncate(pool_fd, TP_SUPERBLOCK_SIZE_BYTES + 64 * 4) != 0)
+    {
+        goto cleanup;
+    }
+
+    tp_test_write_superblock(header_fd, 82003, 1, tensor_pool_regionType_HEADER_RING, 0, 4, TP_HEADER_SLOT_BYTES, 0);
+    tp_test_write_superblock(pool_fd, 82003, 1, tensor_pool_regionType_PAYLOAD_POOL, 1, 4, TP_NULL_U32, 64);
+
+    snprintf(header_uri, sizeof(header_uri), "shm:file?path=%s", header_path);
+    snprintf(pool_uri, sizeof(pool_uri), "shm:file?path=%s", pool_path);
+
+    memset(&pool_cfg, 0, sizeof(pool_cfg));
+    pool_cfg.pool_id = 1;
+    pool_cfg.nslots = 4;
+    pool_cfg.stride_bytes = 64;
+    pool_cfg.uri = pool_uri;
+
+    memset(&config, 0, sizeof(config));
+    config.stream_id = 82003;
+    config.epoch = 1;
+    config.layout_version = 1;
+    config.header_nslots = 4;
+    config.header_uri = header_uri;
+    config.pools = &pool_cfg;
+    config.pool_count = 1;
+
+    if (tp_consumer_attach(consumer, &config) < 0)
+    {
+        goto cleanup;
+    }
+
+    /* Write committed slots straight into the consumer's mappings with a detached producer. */
+    memset(&writer, 0, sizeof(writer));
+    memset(&writer_pool, 0, sizeof(writer_pool));
+    writer.client = client;
+    writer.header_region.addr = consumer->header_region.addr;
+    writer.header_nslots = 4;
+    writer.pool_count = 1;
+    writer.pools = &writer_pool;
+    writer.stream_id = 82003;
+    writer.epoch = 1;
+    writer_pool.pool_id = 1;
+    writer_pool.nslots = 4;
+    writer_pool.stride_bytes = 64;
+    writer_pool.region.addr = consumer->pools[0].region.addr;
+
+    memset(&tensor, 0, sizeof(tensor));
+    tensor.dtype = TP_DTYPE_UINT8;
+    tensor.major_order = TP_MAJOR_ORDER_ROW;
+    tensor.ndims = 1;
+    tensor.progress_unit = TP_PROGRESS_NONE;
+    tensor.dims[0] = sizeof(payload);
+
+    tensor_pool_messageHeader_wrap(
+        &header,
+        (char *)buffer,
+        0,
+        tensor_pool_messageHeader_sbe_schema_version(),
+        sizeof(buffer));
+    tensor_pool_messageHeader_set_blockLength(&header, (uint16_t)body_len);
+    tensor_pool_messageHeader_set_templateId(&header, tensor_pool_frameDescriptor_sbe_template_id());
+    tensor_pool_messageHeader_set_schemaId(&header, tensor_pool_frameDescriptor_sbe_schema_id());
+    tensor_pool_messageHeader_set_version(&header, tensor_pool_frameDescriptor_sbe_schema_version());
+
+    tensor_pool_frameDescriptor_wrap_for_encode(&descriptor, (char *)buffer, header_len, sizeof(buffer));
+    tensor_pool_frameDescriptor_set_streamId(&descriptor, 82003);
+    tensor_pool_frameDescriptor_set_epoch(&descriptor, 1);
+    tensor_pool_frameDescriptor_set_timestampNs(&descriptor, 0);
+    tensor_pool_frameDescriptor_set_metaVersion(&descriptor, 0);
+    tensor_pool_frameDescriptor_set_traceId(&descriptor, 0);
+
+    tp_consumer_set_descriptor_handler(consumer, tp_on_rate_gate_descriptor, &delivered);
+
+    /* Descriptor seq 4 carries no timestamp, so the gate falls back to the slot timestamp. */
+    for (seq = 1; seq <= 4; seq++)
+    {
+        memset(payload, (int)seq, sizeof(payload));
+        (void)tp_producer_publish_frame(&writer, seq, &tensor, payload, sizeof(payload), 1, 1250000000ULL, 0, 0);
+
+        tensor_pool_frameDescriptor_set_seq(&descriptor, seq);
+        tensor_pool_frameDescriptor_set_timestampNs(&descriptor, timestamps[seq - 1]);
+        if (tp_test_offer(client, descriptor_pub, buffer, header_len + body_len) < 0)
+        {
+            goto cleanup;
+        }
+    }
+
+    deadline = tp_clock_now_ns() + 2 * 1000 * 1000 * 1000LL;
+    while (tp_clock_now_ns() < deadline && consumer->last_seq_seen < 4)
+    {
+        if (tp_consumer_poll_descriptors(consumer, 10) < 0)
+        {
+            goto cleanup;
+        }
+        {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    if (delivered != 2 || tp_consumer_rate_limited_count(consumer) != 2 || consumer->drops_gap != 0)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    if (descriptor_pub)
+    {
+        tp_publication_close(&descriptor_pub);
+    }
+    if (consumer)
+    {
+        tp_consumer_close(consumer);
+    }
+    if (tp_test_has_aeron_dir(client))
+    {
+        tp_client_close(client);
+    }
+    if (header_fd >= 0)
+    {
+        close(header_fd);
+        unlink(header_path);
+    }
+    if (pool_fd >= 0)
+    {
+        close(pool_fd);
+        unlink(pool_path);
+    }
+
+    assert(result == 0);
+}
+
 void tp_test_epoch_regression(void)
 {
     tp_context_t *ctx = NULL;
@@ -4,6 +4,7 @@
 #include "wire/tensor_pool/messageHeader.h"
 #include "wire/tensor_pool/qosProducer.h"
 #include "wire/tensor_pool/qosConsumer.h"
+#include "wire/tensor_pool/qosConsumerLatency.h"
 
 #include <assert.h>
 #include <string.h>
@@ -13,6 +14,8 @@ typedef struct tp_qos_test_state_stct
     int events;
     int producers;
     int consumers;
+    int latencies;
+    uint64_t read_p99_ns;
 }
 tp_qos_test_state_t;
 
@@ -34,6 +37,11 @@ static void tp_on_qos_event(void *clientd, const tp_qos_event_t *event)
     {
         state->consumers++;
     }
+    else if (event->type == TP_QOS_EVENT_CONSUMER_LATENCY)
+    {
+        state->latencies++;
+        state->read_p99_ns = event->read_latency.p99_ns;
+    }
 }
 
 static size_t encode_qos_producer(uint8_t *buffer, size_t capacity)
@@ -80,6 +88,35 @@ static size_t encode_qos_consumer(uint8_t *buffer, size_t capacity)
     return (size_t)tensor_pool_qosConsumer_sbe_position(&qos);
 }
 
+static size_t encode_qos_consumer_latency(uint8_t *buffer, size_t capacity)
+{
+    struct tensor_pool_messageHeader header;
+    struct tensor_pool_qosConsumerLatency qos;
+
+    tensor_pool_messageHeader_wrap(&header, (char *)buffer, 0, tensor_pool_messageHeader_sbe_schema_version(), capacity);
+    tensor_pool_messageHeader_set_blockLength(&header, tensor_pool_qosConsumerLatency_sbe_block_length());
+    tensor_pool_messageHeader_set_templateId(&header, tensor_pool_qosConsumerLatency_sbe_template_id());
+    tensor_pool_messageHeader_set_schemaId(&header, tensor_pool_qosConsumerLatency_sbe_schema_id());
+    tensor_pool_messageHeader_set_version(&header, tensor_pool_qosConsumerLatency_sbe_schema_version());
+
+    tensor_pool_qosConsumerLatency_wrap_for_encode(&qos, (char *)buffer, tensor_pool_messageHeader_encoded_length(), capacity);
+    tensor_pool_qosConsumerLatency_set_streamId(&qos, 1);
+    tensor_pool_qosConsumerLatency_set_consumerId(&qos, 2);
+    tensor_pool_qosConsumerLatency_set_epoch(&qos, 3);
+    tensor_pool_qosConsumerLatency_set_arrivalCount(&qos, 10);
+    tensor_pool_qosConsumerLatency_set_arrivalP50Ns(&qos, 100);
+    tensor_pool_qosConsumerLatency_set_arrivalP90Ns(&qos, 200);
+    tensor_pool_qosConsumerLatency_set_arrivalP99Ns(&qos, 300);
+    tensor_pool_qosConsumerLatency_set_arrivalMaxNs(&qos, 400);
+    tensor_pool_qosConsumerLatency_set_readCount(&qos, 10);
+    tensor_pool_qosConsumerLatency_set_readP50Ns(&qos, 500);
+    tensor_pool_qosConsumerLatency_set_readP90Ns(&qos, 600);
+    tensor_pool_qosConsumerLatency_set_readP99Ns(&qos, 700);
+    tensor_pool_qosConsumerLatency_set_readMaxNs(&qos, 800);
+
+    return (size_t)tensor_pool_qosConsumerLatency_sbe_position(&qos);
+}
+
 static void test_qos_poller_invalid_inputs(void)
 {
     tp_qos_poller_t poller;
@@ -133,6 +170,14 @@ static void test_qos_poller_dispatch(void)
     tp_qos_poller_handle_fragment(&poller, buffer, len);
     assert(state.events == 2);
     assert(state.consumers == 1);
+
+    len = encode_qos_consumer_latency(buffer, sizeof(buffer));
+    tp_qos_poller_handle_fragment(&poller, buffer, len - 1);
+    assert(state.events == 2);
+    tp_qos_poller_handle_fragment(&poller, buffer, len);
+    assert(state.events == 3);
+    assert(state.latencies == 1);
+    assert(state.read_p99_ns == 700);
 }
 
 void tp_test_qos_poller(void)
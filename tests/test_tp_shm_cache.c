@@ -0,0 +1,160 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tensor_pool/tp_context.h"
+#include "tensor_pool/tp_shm.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int tp_test_cache_file(const char *path, size_t size)
+{
+    FILE *file = fopen(path, "w");
+    int result;
+
+    if (NULL == file)
+    {
+        return -1;
+    }
+    result = ftruncate(fileno(file), (off_t)size);
+    fclose(file);
+    return result;
+}
+
+void tp_test_shm_cache(void)
+{
+    tp_context_t *ctx = NULL;
+    tp_context_t *other_ctx = NULL;
+    tp_shm_region_t first;
+    tp_shm_region_t second;
+    tp_shm_region_t next_epoch;
+    tp_shm_region_t replaced;
+    tp_shm_region_t denied;
+    const char *allowed_paths[1];
+    char file_path[64] = "/tmp/tp_shm_cacheXXXXXX";
+    char other_dir[64] = "/tmp/tp_shm_cache_dirXXXXXX";
+    bool other_dir_created = false;
+    char uri[512];
+    size_t base_entries = 0;
+    size_t entries = 0;
+    uint64_t base_hits = 0;
+    uint64_t base_misses = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    int fd;
+    int result = -1;
+
+    memset(&first, 0, sizeof(first));
+    memset(&second, 0, sizeof(second));
+    memset(&next_epoch, 0, sizeof(next_epoch));
+    memset(&replaced, 0, sizeof(replaced));
+    memset(&denied, 0, sizeof(denied));
+
+    fd = mkstemp(file_path);
+    if (fd < 0)
+    {
+        goto cleanup;
+    }
+    close(fd);
+    if (tp_test_cache_file(file_path, TP_SUPERBLOCK_SIZE_BYTES) < 0)
+    {
+        goto cleanup;
+    }
+    snprintf(uri, sizeof(uri), "shm:file?path=%s", file_path);
+
+    if (tp_context_init(&ctx) < 0 || tp_context_init(&other_ctx) < 0)
+    {
+        goto cleanup;
+    }
+    allowed_paths[0] = "/tmp";
+    tp_context_set_allowed_paths(ctx, allowed_paths, 1);
+    if (tp_context_finalize_allowed_paths(ctx) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (NULL == mkdtemp(other_dir))
+    {
+        goto cleanup;
+    }
+    other_dir_created = true;
+    allowed_paths[0] = other_dir;
+    tp_context_set_allowed_paths(other_ctx, allowed_paths, 1);
+    if (tp_context_finalize_allowed_paths(other_ctx) < 0)
+    {
+        goto cleanup;
+    }
+
+    tp_shm_cache_get_stats(&base_entries, &base_hits, &base_misses);
+
+    /* Same path and epoch share one mapping. */
+    if (tp_shm_map_shared(&first, uri, 1, tp_context_allowed_paths(ctx), NULL) < 0 ||
+        tp_shm_map_shared(&second, uri, 1, tp_context_allowed_paths(ctx), NULL) < 0)
+    {
+        goto cleanup;
+    }
+    tp_shm_cache_get_stats(&entries, &hits, &misses);
+    if (first.addr != second.addr || entries != base_entries + 1 ||
+        hits != base_hits + 1 || misses != base_misses + 1)
+    {
+        goto cleanup;
+    }
+
+    /* A caller whose allowlist does not cover the path is refused even on a cache hit. */
+    if (tp_shm_map_shared(&denied, uri, 1, tp_context_allowed_paths(other_ctx), NULL) == 0)
+    {
+        goto cleanup;
+    }
+
+    /* A newer epoch gets its own mapping; holders of the old one keep it. */
+    if (tp_shm_map_shared(&next_epoch, uri, 2, tp_context_allowed_paths(ctx), NULL) < 0 ||
+        next_epoch.addr == first.addr)
+    {
+        goto cleanup;
+    }
+    tp_shm_unmap(&next_epoch, NULL);
+
+    /* A file replaced at the same path is not served from the stale mapping. */
+    unlink(file_path);
+    if (tp_test_cache_file(file_path, TP_SUPERBLOCK_SIZE_BYTES * 2) < 0 ||
+        tp_shm_map_shared(&replaced, uri, 2, tp_context_allowed_paths(ctx), NULL) < 0 ||
+        replaced.length != TP_SUPERBLOCK_SIZE_BYTES * 2)
+    {
+        goto cleanup;
+    }
+
+    tp_shm_unmap(&first, NULL);
+    tp_shm_unmap(&second, NULL);
+    tp_shm_unmap(&replaced, NULL);
+    tp_shm_cache_get_stats(&entries, NULL, NULL);
+    if (entries != base_entries)
+    {
+        goto cleanup;
+    }
+    result = 0;
+
+cleanup:
+    tp_shm_unmap(&first, NULL);
+    tp_shm_unmap(&second, NULL);
+    tp_shm_unmap(&next_epoch, NULL);
+    tp_shm_unmap(&replaced, NULL);
+    unlink(file_path);
+    if (other_dir_created)
+    {
+        rmdir(other_dir);
+    }
+    if (ctx)
+    {
+        tp_context_close(ctx);
+    }
+    if (other_ctx)
+    {
+        tp_context_close(other_ctx);
+    }
+    assert(result == 0);
+}
@@ -1,10 +1,17 @@
 #include "tensor_pool/internal/tp_client_internal.h"
 #include "tensor_pool/internal/tp_consumer_internal.h"
 #include "tensor_pool/internal/tp_producer_internal.h"
+#include "tensor_pool/tp_copy.h"
+#include "tensor_pool/tp_seqlock.h"
+#include "tensor_pool/tp_slot.h"
 #include "tensor_pool/tp_tensor.h"
+#include "tensor_pool/tp_trace.h"
 #include "tensor_pool/tp_types.h"
 
 #include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -31,77 +38,120 @@ static void tp_test_payload_flush(void *clientd, void *payload, size_t length)
     tp_test_flush_len = length;
 }
 
-void tp_test_shm_roundtrip(void)
+typedef struct tp_test_roundtrip_stct
 {
     tp_client_t client;
     tp_producer_t producer;
     tp_consumer_t consumer;
     tp_payload_pool_t producer_pool;
     tp_consumer_pool_t consumer_pool;
+    uint8_t *header_region;
+    uint8_t *pool_region;
+    uint32_t header_nslots;
+}
+tp_test_roundtrip_t;
+
+/* Wires a producer and a consumer to the same calloc'd header ring and payload pool. */
+static int tp_test_roundtrip_setup(tp_test_roundtrip_t *rt)
+{
+    uint32_t header_nslots = 4;
+    uint32_t stride_bytes = 64;
+    size_t header_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * TP_HEADER_SLOT_BYTES);
+    size_t pool_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * stride_bytes);
+
+    memset(rt, 0, sizeof(*rt));
+
+    if (tp_context_init(&rt->client.context) < 0)
+    {
+        return -1;
+    }
+
+    rt->header_region = calloc(1, header_size);
+    rt->pool_region = calloc(1, pool_size);
+    if (NULL == rt->header_region || NULL == rt->pool_region)
+    {
+        return -1;
+    }
+    rt->header_nslots = header_nslots;
+
+    rt->producer.client = &rt->client;
+    rt->producer.header_region.addr = rt->header_region;
+    rt->producer.header_nslots = header_nslots;
+    rt->producer.pool_count = 1;
+    rt->producer.pools = &rt->producer_pool;
+    rt->producer.stream_id = 1;
+    rt->producer.epoch = 1;
+
+    rt->producer_pool.pool_id = 1;
+    rt->producer_pool.nslots = header_nslots;
+    rt->producer_pool.stride_bytes = stride_bytes;
+    rt->producer_pool.region.addr = rt->pool_region;
+
+    rt->consumer.client = &rt->client;
+    rt->consumer.use_shm = true;
+    rt->consumer.shm_mapped = true;
+    rt->consumer.header_region.addr = rt->header_region;
+    rt->consumer.header_nslots = header_nslots;
+    rt->consumer.pool_count = 1;
+    rt->consumer.pools = &rt->consumer_pool;
+    rt->consumer.stream_id = 1;
+    rt->consumer.epoch = 1;
+
+    rt->consumer_pool.pool_id = 1;
+    rt->consumer_pool.nslots = header_nslots;
+    rt->consumer_pool.stride_bytes = stride_bytes;
+    rt->consumer_pool.region.addr = rt->pool_region;
+
+    return 0;
+}
+
+static void tp_test_roundtrip_enable_reorder(
+    tp_test_roundtrip_t *rt,
+    tp_producer_reorder_entry_t *entries,
+    size_t entry_count)
+{
+    size_t i;
+
+    rt->producer.reorder_entries = entries;
+    rt->producer.reorder_mask = (uint64_t)(entry_count - 1);
+    for (i = 0; i < entry_count; i++)
+    {
+        atomic_init(&entries[i].state, UINT64_MAX);
+    }
+    atomic_init(&rt->producer.next_seq, 0);
+    atomic_init(&rt->producer.reorder_next_seq, 0);
+    atomic_init(&rt->producer.reorder_draining, false);
+}
+
+static void tp_test_roundtrip_teardown(tp_test_roundtrip_t *rt)
+{
+    free(rt->header_region);
+    free(rt->pool_region);
+    rt->header_region = NULL;
+    rt->pool_region = NULL;
+}
+
+static void test_shm_roundtrip_basic(void)
+{
+    tp_test_roundtrip_t rt;
     tp_tensor_header_t header;
     tp_frame_t frame;
     tp_frame_view_t view;
     tp_frame_progress_t progress;
     const float payload[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
-    uint8_t *header_region = NULL;
-    uint8_t *pool_region = NULL;
-    uint32_t header_nslots = 4;
-    uint32_t stride_bytes = 64;
-    size_t header_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * TP_HEADER_SLOT_BYTES);
-    size_t pool_size = TP_SUPERBLOCK_SIZE_BYTES + (header_nslots * stride_bytes);
     uint64_t seq = 5;
     int result = -1;
 
-    memset(&client, 0, sizeof(client));
-    memset(&producer, 0, sizeof(producer));
-    memset(&consumer, 0, sizeof(consumer));
-    memset(&producer_pool, 0, sizeof(producer_pool));
-    memset(&consumer_pool, 0, sizeof(consumer_pool));
     memset(&header, 0, sizeof(header));
     memset(&frame, 0, sizeof(frame));
     memset(&view, 0, sizeof(view));
     memset(&progress, 0, sizeof(progress));
 
-    if (tp_context_init(&client.context) < 0)
-    {
-        goto cleanup;
-    }
-
-    header_region = calloc(1, header_size);
-    pool_region = calloc(1, pool_size);
-    if (NULL == header_region || NULL == pool_region)
+    if (tp_test_roundtrip_setup(&rt) < 0)
     {
         goto cleanup;
     }
-
-    producer.client = &client;
-    producer.header_region.addr = header_region;
-    producer.header_nslots = header_nslots;
-    producer.pool_count = 1;
-    producer.pools = &producer_pool;
-    producer.stream_id = 1;
-    producer.epoch = 1;
-    producer.context.payload_flush = tp_test_payload_flush;
-
-    producer_pool.pool_id = 1;
-    producer_pool.nslots = header_nslots;
-    producer_pool.stride_bytes = stride_bytes;
-    producer_pool.region.addr = pool_region;
-
-    consumer.client = &client;
-    consumer.use_shm = true;
-    consumer.shm_mapped = true;
-    consumer.header_region.addr = header_region;
-    consumer.header_nslots = header_nslots;
-    consumer.pool_count = 1;
-    consumer.pools = &consumer_pool;
-    consumer.stream_id = 1;
-    consumer.epoch = 1;
-
-    consumer_pool.pool_id = 1;
-    consumer_pool.nslots = header_nslots;
-    consumer_pool.stride_bytes = stride_bytes;
-    consumer_pool.region.addr = pool_region;
+    rt.producer.context.payload_flush = tp_test_payload_flush;
 
     header.dtype = TP_DTYPE_FLOAT32;
     header.major_order = TP_MAJOR_ORDER_ROW;
@@ -113,15 +163,15 @@ void tp_test_shm_roundtrip(void)
     frame.tensor = &header;
     frame.payload = payload;
     frame.payload_len = sizeof(payload);
-    frame.pool_id = producer_pool.pool_id;
+    frame.pool_id = rt.producer_pool.pool_id;
 
     if (tp_producer_publish_frame(
-        &producer,
+        &rt.producer,
         seq,
         &header,
         payload,
         sizeof(payload),
-        producer_pool.pool_id,
+        rt.producer_pool.pool_id,
         123,
         7,
         0) >= 0)
@@ -134,13 +184,13 @@ void tp_test_shm_roundtrip(void)
         goto cleanup;
     }
 
-    if ( tp_consumer_read_frame(&consumer, seq, &view) != 0)
+    if ( tp_consumer_read_frame(&rt.consumer, seq, &view) != 0)
     {
         goto cleanup;
     }
 
     if (view.payload_len != sizeof(payload) ||
-        view.pool_id != producer_pool.pool_id ||
+        view.pool_id != rt.producer_pool.pool_id ||
         view.timestamp_ns != 123 ||
         view.meta_version != 7 ||
         memcmp(view.payload, payload, sizeof(payload)) != 0)
@@ -148,12 +198,505 @@ void tp_test_shm_roundtrip(void)
         goto cleanup;
     }
 
-    progress.stream_id = consumer.stream_id;
-    progress.epoch = consumer.epoch;
+    progress.stream_id = rt.consumer.stream_id;
+    progress.epoch = rt.consumer.epoch;
     progress.seq = seq;
     progress.payload_bytes_filled = sizeof(payload);
     progress.state = TP_PROGRESS_COMPLETE;
-    if (tp_consumer_validate_progress(&consumer, &progress) != 0)
+    if (tp_consumer_validate_progress(&rt.consumer, &progress) != 0)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+static void test_shm_tensor_header_cache(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_tensor_header_t header;
+    tp_frame_view_t view;
+    const float payload[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    int result = -1;
+
+    memset(&header, 0, sizeof(header));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+
+    header.dtype = TP_DTYPE_FLOAT32;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 2;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = 2;
+    header.dims[1] = 2;
+
+    tp_producer_publish_frame(&rt.producer, 1, &header, payload, sizeof(payload), 1, 10, 0, 0);
+    assert(rt.producer.has_cached_tensor);
+
+    tp_producer_publish_frame(&rt.producer, 2, &header, payload, sizeof(payload), 1, 11, 0, 0);
+    if (tp_consumer_read_frame(&rt.consumer, 2, &view) != 0 ||
+        view.tensor.ndims != 2 ||
+        view.tensor.dims[0] != 2 ||
+        view.tensor.dims[1] != 2)
+    {
+        goto cleanup;
+    }
+
+    header.ndims = 1;
+    header.dims[0] = 4;
+    header.dims[1] = 0;
+    tp_producer_publish_frame(&rt.producer, 3, &header, payload, sizeof(payload), 1, 12, 0, 0);
+    if (tp_consumer_read_frame(&rt.consumer, 3, &view) != 0 ||
+        view.tensor.ndims != 1 ||
+        view.tensor.dims[0] != 4)
+    {
+        goto cleanup;
+    }
+
+    header.ndims = 0;
+    if (tp_producer_publish_frame(&rt.producer, 4, &header, payload, sizeof(payload), 1, 13, 0, 0) >= 0)
+    {
+        goto cleanup;
+    }
+    assert(!rt.producer.has_cached_tensor);
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+static void test_shm_consumer_header_cache(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_consumer_header_cache_entry_t cache[4];
+    tp_tensor_header_t header;
+    tp_frame_view_t view;
+    tp_frame_progress_t progress;
+    const float payload[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    int result = -1;
+
+    memset(cache, 0, sizeof(cache));
+    memset(&header, 0, sizeof(header));
+    memset(&progress, 0, sizeof(progress));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+    rt.consumer.header_cache = cache;
+
+    header.dtype = TP_DTYPE_FLOAT32;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = 4;
+
+    tp_producer_publish_frame(&rt.producer, 1, &header, payload, sizeof(payload), 1, 10, 0, 0);
+    if (tp_consumer_read_frame(&rt.consumer, 1, &view) != 0 ||
+        atomic_load(&cache[1].seq_commit) != tp_seq_committed(1) ||
+        cache[1].payload != view.payload)
+    {
+        goto cleanup;
+    }
+
+    /* A second read of the same seq_commit is served from the cache without decoding the slot. */
+    cache[1].tensor.dims[0] = 99;
+    if (tp_consumer_read_frame(&rt.consumer, 1, &view) != 0 ||
+        view.tensor.dims[0] != 99 ||
+        view.timestamp_ns != 10 ||
+        view.payload_len != sizeof(payload))
+    {
+        goto cleanup;
+    }
+
+    progress.stream_id = 1;
+    progress.epoch = 1;
+    progress.seq = 1;
+    progress.payload_bytes_filled = sizeof(payload);
+    if (tp_consumer_validate_progress(&rt.consumer, &progress) != 0)
+    {
+        goto cleanup;
+    }
+    progress.payload_bytes_filled = sizeof(payload) + 1;
+    if (tp_consumer_validate_progress(&rt.consumer, &progress) >= 0)
+    {
+        goto cleanup;
+    }
+
+    /* Reusing the slot changes seq_commit, so the stale entry misses and is replaced. */
+    tp_producer_publish_frame(&rt.producer, 5, &header, payload, sizeof(payload), 1, 11, 0, 0);
+    if (tp_consumer_read_frame(&rt.consumer, 1, &view) != 1 ||
+        tp_consumer_read_frame(&rt.consumer, 5, &view) != 0 ||
+        view.tensor.dims[0] != 4 ||
+        view.timestamp_ns != 11 ||
+        atomic_load(&cache[1].seq_commit) != tp_seq_committed(5))
+    {
+        goto cleanup;
+    }
+
+    /* validate_progress fills the cache on a miss too. */
+    tp_producer_publish_frame(&rt.producer, 2, &header, payload, sizeof(payload), 1, 12, 0, 0);
+    progress.seq = 2;
+    progress.payload_bytes_filled = 0;
+    if (tp_consumer_validate_progress(&rt.consumer, &progress) != 0 ||
+        atomic_load(&cache[2].seq_commit) != tp_seq_committed(2))
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+static void test_shm_concurrent_claim_reorder(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_producer_reorder_entry_t entries[2];
+    tp_buffer_claim_t claims[6];
+    tp_trace_id_generator_t failing_generator;
+    size_t i;
+    int result = -1;
+
+    memset(claims, 0, sizeof(claims));
+    memset(&failing_generator, 0, sizeof(failing_generator));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+    tp_test_roundtrip_enable_reorder(&rt, entries, 2);
+
+    for (i = 0; i < 6; i++)
+    {
+        claims[i].tensor.dtype = TP_DTYPE_UINT8;
+        claims[i].tensor.major_order = TP_MAJOR_ORDER_ROW;
+        claims[i].tensor.ndims = 1;
+        claims[i].tensor.progress_unit = TP_PROGRESS_NONE;
+        claims[i].tensor.dims[0] = 16;
+    }
+
+    if (tp_producer_try_claim(&rt.producer, 16, &claims[0]) != 0 ||
+        tp_producer_try_claim(&rt.producer, 16, &claims[1]) != 1 ||
+        tp_producer_try_claim(&rt.producer, 16, &claims[2]) != TP_BACK_PRESSURED)
+    {
+        goto cleanup;
+    }
+
+    memset(claims[1].payload, 0x11, 16);
+    tp_producer_commit_claim(&rt.producer, &claims[1], NULL);
+    if (tp_atomic_load_u64((uint64_t *)tp_slot_at(rt.header_region, 1)) != tp_seq_committed(1) ||
+        tp_atomic_load_u64((uint64_t *)tp_slot_at(rt.header_region, 0)) != tp_seq_in_progress(0) ||
+        atomic_load(&rt.producer.reorder_next_seq) != 0)
+    {
+        goto cleanup;
+    }
+
+    memset(claims[0].payload, 0x22, 16);
+    tp_producer_commit_claim(&rt.producer, &claims[0], NULL);
+    if (atomic_load(&rt.producer.reorder_next_seq) != 2)
+    {
+        goto cleanup;
+    }
+
+    if (tp_producer_try_claim(&rt.producer, 16, &claims[2]) != 2 ||
+        tp_producer_abort_claim(&rt.producer, &claims[2]) != 0 ||
+        atomic_load(&rt.producer.reorder_next_seq) != 3 ||
+        tp_atomic_load_u64((uint64_t *)tp_slot_at(rt.header_region, 2)) != tp_seq_in_progress(2))
+    {
+        goto cleanup;
+    }
+
+    /* A commit that fails before publishing still releases its seq, so later seqs drain. */
+    if (tp_producer_try_claim(&rt.producer, 16, &claims[3]) != 3 ||
+        tp_producer_try_claim(&rt.producer, 16, &claims[4]) != 4)
+    {
+        goto cleanup;
+    }
+
+    memset(claims[4].payload, 0x44, 16);
+    tp_producer_commit_claim(&rt.producer, &claims[4], NULL);
+
+    /* An uninitialized generator returns 0, which fails trace id resolution. */
+    tp_producer_set_trace_id_generator(&rt.producer, &failing_generator);
+    if (tp_producer_commit_claim(&rt.producer, &claims[3], NULL) >= 0 ||
+        atomic_load(&rt.producer.reorder_next_seq) != 5 ||
+        tp_atomic_load_u64((uint64_t *)tp_slot_at(rt.header_region, 0)) != tp_seq_committed(4))
+    {
+        goto cleanup;
+    }
+    tp_producer_set_trace_id_generator(&rt.producer, NULL);
+
+    if (tp_producer_try_claim(&rt.producer, 16, &claims[5]) != 5)
+    {
+        goto cleanup;
+    }
+    memset(claims[5].payload, 0x55, 16);
+    tp_producer_commit_claim(&rt.producer, &claims[5], NULL);
+    if (atomic_load(&rt.producer.reorder_next_seq) != 6 ||
+        tp_atomic_load_u64((uint64_t *)tp_slot_at(rt.header_region, 1)) != tp_seq_committed(5))
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+enum
+{
+    TP_TEST_COMMIT_THREADS = 4,
+    TP_TEST_COMMITS_PER_THREAD = 2000
+};
+
+typedef struct tp_test_commit_worker_stct
+{
+    tp_producer_t *producer;
+    _Atomic bool *failed;
+}
+tp_test_commit_worker_t;
+
+static void *tp_test_commit_worker(void *arg)
+{
+    tp_test_commit_worker_t *worker = (tp_test_commit_worker_t *)arg;
+    int committed = 0;
+
+    while (committed < TP_TEST_COMMITS_PER_THREAD && !atomic_load(worker->failed))
+    {
+        tp_buffer_claim_t claim;
+        uint64_t spins = 0;
+        int64_t seq;
+
+        memset(&claim, 0, sizeof(claim));
+        claim.tensor.dtype = TP_DTYPE_UINT8;
+        claim.tensor.major_order = TP_MAJOR_ORDER_ROW;
+        claim.tensor.ndims = 1;
+        claim.tensor.progress_unit = TP_PROGRESS_NONE;
+        claim.tensor.dims[0] = 16;
+
+        /* A stranded completion keeps the window full forever, so give up rather than hang. */
+        while ((seq = tp_producer_try_claim(worker->producer, 16, &claim)) == TP_BACK_PRESSURED)
+        {
+            if (++spins > 100000000ULL || atomic_load(worker->failed))
+            {
+                atomic_store(worker->failed, true);
+                return NULL;
+            }
+            sched_yield();
+        }
+        if (seq < 0)
+        {
+            atomic_store(worker->failed, true);
+            return NULL;
+        }
+
+        memset(claim.payload, (int)(seq & 0xFF), 16);
+        tp_producer_commit_claim(worker->producer, &claim, NULL);
+        committed++;
+    }
+
+    return NULL;
+}
+
+static void test_shm_concurrent_claim_threads(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_producer_reorder_entry_t entries[4];
+    tp_test_commit_worker_t workers[TP_TEST_COMMIT_THREADS];
+    pthread_t threads[TP_TEST_COMMIT_THREADS];
+    _Atomic bool failed;
+    uint64_t total = (uint64_t)TP_TEST_COMMIT_THREADS * TP_TEST_COMMITS_PER_THREAD;
+    size_t started = 0;
+    size_t i;
+    int result = -1;
+
+    atomic_init(&failed, false);
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+    tp_test_roundtrip_enable_reorder(&rt, entries, 4);
+
+    for (i = 0; i < TP_TEST_COMMIT_THREADS; i++)
+    {
+        workers[i].producer = &rt.producer;
+        workers[i].failed = &failed;
+        if (pthread_create(&threads[i], NULL, tp_test_commit_worker, &workers[i]) != 0)
+        {
+            atomic_store(&failed, true);
+            break;
+        }
+        started++;
+    }
+
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* Every commit must have been drained, with nothing left waiting for a later one. */
+    if (atomic_load(&failed) ||
+        atomic_load(&rt.producer.next_seq) != total ||
+        atomic_load(&rt.producer.reorder_next_seq) != total ||
+        atomic_load(&rt.producer.reorder_draining))
+    {
+        goto cleanup;
+    }
+
+    for (i = 0; i < rt.header_nslots; i++)
+    {
+        uint64_t seq = total - rt.header_nslots + i;
+        if (tp_atomic_load_u64((uint64_t *)tp_slot_at(rt.header_region, (uint32_t)(seq & (rt.header_nslots - 1)))) !=
+            tp_seq_committed(seq))
+        {
+            goto cleanup;
+        }
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+static void test_shm_offer_framev(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_tensor_header_t header;
+    tp_frame_t frame;
+    tp_frame_view_t view;
+    tp_iovec_t iov[3];
+    const uint8_t band[4] = { 1, 2, 3, 4 };
+    const uint8_t plane[8] = { 5, 6, 7, 8, 9, 10, 11, 12 };
+    const uint8_t trailer[4] = { 13, 14, 15, 16 };
+    uint8_t expected[16];
+    size_t i;
+    int result = -1;
+
+    memset(&header, 0, sizeof(header));
+    memset(&frame, 0, sizeof(frame));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+
+    header.dtype = TP_DTYPE_UINT8;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = 16;
+
+    frame.tensor = &header;
+
+    iov[0].base = band;
+    iov[0].length = sizeof(band);
+    iov[1].base = plane;
+    iov[1].length = sizeof(plane);
+    iov[2].base = trailer;
+    iov[2].length = sizeof(trailer);
+    for (i = 0; i < sizeof(expected); i++)
+    {
+        expected[i] = (uint8_t)(i + 1);
+    }
+
+    /* No descriptor publication is attached, so the offer reports failure after the slot commit. */
+    if (tp_producer_offer_framev(&rt.producer, &frame, iov, 3, NULL) >= 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_read_frame(&rt.consumer, 0, &view) != 0 ||
+        view.payload_len != sizeof(expected) ||
+        memcmp(view.payload, expected, sizeof(expected)) != 0)
+    {
+        goto cleanup;
+    }
+
+    iov[1].base = NULL;
+    if (tp_producer_offer_framev(&rt.producer, &frame, iov, 3, NULL) >= 0 || atomic_load(&rt.producer.next_seq) != 1)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+static void test_shm_read_frame_copy(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_tensor_header_t header;
+    tp_frame_view_t view;
+    const float payload[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    float copy[4];
+    int result = -1;
+
+    memset(&header, 0, sizeof(header));
+    memset(copy, 0, sizeof(copy));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+    rt.consumer.payload_copy = tp_copy_engine_fn(TP_COPY_ENGINE_AUTO);
+
+    header.dtype = TP_DTYPE_FLOAT32;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = 4;
+
+    tp_producer_publish_frame(&rt.producer, 1, &header, payload, sizeof(payload), 1, 10, 0, 0);
+
+    if (tp_consumer_read_frame_copy(&rt.consumer, 1, &view, copy, sizeof(copy) - 1) >= 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_read_frame_copy(&rt.consumer, 1, &view, copy, sizeof(copy)) != 0 ||
+        view.payload != (const uint8_t *)copy ||
+        memcmp(copy, payload, sizeof(payload)) != 0 ||
+        rt.consumer.drops_late != 0)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_read_frame(&rt.consumer, 1, &view) != 0 || tp_consumer_validate_frame(&rt.consumer, 1) != 0)
+    {
+        goto cleanup;
+    }
+
+    /* Simulate the producer lapping the slot while the zero-copy view is still in use. */
+    tp_atomic_store_u64((uint64_t *)tp_slot_at(rt.header_region, 1), tp_seq_in_progress(1 + rt.header_nslots));
+    if (tp_consumer_validate_frame(&rt.consumer, 1) != 1 || rt.consumer.drops_late != 1)
+    {
+        goto cleanup;
+    }
+
+    tp_producer_publish_frame(&rt.producer, 1 + rt.header_nslots, &header, payload, sizeof(payload), 1, 11, 0, 0);
+    if (tp_consumer_validate_frame(&rt.consumer, 1) != 1 ||
+        rt.consumer.drops_late != 2 ||
+        tp_consumer_validate_frame(&rt.consumer, 1 + rt.header_nslots) != 0)
     {
         goto cleanup;
     }
@@ -161,7 +704,151 @@ void tp_test_shm_roundtrip(void)
     result = 0;
 
 cleanup:
-    free(header_region);
-    free(pool_region);
+    tp_test_roundtrip_teardown(&rt);
     assert(result == 0);
 }
+
+static void test_shm_follow_ring(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_tensor_header_t header;
+    tp_frame_view_t views[8];
+    const float payload[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    uint64_t seq;
+    int result = -1;
+
+    memset(&header, 0, sizeof(header));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+    rt.consumer.context.follow_ring = true;
+
+    header.dtype = TP_DTYPE_FLOAT32;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = 4;
+
+    if (tp_consumer_poll_ring(&rt.consumer, views, 8) != 0 || rt.consumer.next_seq != 0)
+    {
+        goto cleanup;
+    }
+
+    tp_producer_publish_frame(&rt.producer, 0, &header, payload, sizeof(payload), 1, 10, 0, 0);
+    tp_producer_publish_frame(&rt.producer, 1, &header, payload, sizeof(payload), 1, 11, 0, 0);
+    if (tp_consumer_poll_ring(&rt.consumer, views, 8) != 2 ||
+        views[0].seq != 0 ||
+        views[1].seq != 1 ||
+        tp_consumer_poll_ring(&rt.consumer, views, 8) != 0)
+    {
+        goto cleanup;
+    }
+
+    /* Producer laps the reader: seqs 2 and 3 are overwritten by 6 and 7. */
+    for (seq = 2; seq < 8; seq++)
+    {
+        tp_producer_publish_frame(&rt.producer, seq, &header, payload, sizeof(payload), 1, 12, 0, 0);
+    }
+    if (tp_consumer_poll_ring(&rt.consumer, views, 8) != 4 ||
+        views[0].seq != 4 ||
+        views[3].seq != 7 ||
+        rt.consumer.drops_gap != 2 ||
+        rt.consumer.last_seq_seen != 7)
+    {
+        goto cleanup;
+    }
+
+    /* A reader joining an active ring starts after the newest committed frame. */
+    rt.consumer.ring_primed = false;
+    tp_producer_publish_frame(&rt.producer, 8, &header, payload, sizeof(payload), 1, 13, 0, 0);
+    if (tp_consumer_poll_ring(&rt.consumer, views, 8) != 0 || rt.consumer.next_seq != 9)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+static void test_shm_read_latest(void)
+{
+    tp_test_roundtrip_t rt;
+    tp_tensor_header_t header;
+    tp_frame_view_t view;
+    const float payload[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    uint64_t seq;
+    uint64_t drops_gap = 0;
+    uint64_t drops_late = 0;
+    int result = -1;
+
+    memset(&header, 0, sizeof(header));
+
+    if (tp_test_roundtrip_setup(&rt) < 0)
+    {
+        goto cleanup;
+    }
+    rt.consumer.context.latest_only = true;
+
+    header.dtype = TP_DTYPE_FLOAT32;
+    header.major_order = TP_MAJOR_ORDER_ROW;
+    header.ndims = 1;
+    header.progress_unit = TP_PROGRESS_NONE;
+    header.dims[0] = 4;
+
+    if (tp_consumer_read_latest(&rt.consumer, &view) != 1)
+    {
+        goto cleanup;
+    }
+
+    for (seq = 0; seq < 3; seq++)
+    {
+        tp_producer_publish_frame(&rt.producer, seq, &header, payload, sizeof(payload), 1, 10 + seq, 0, 0);
+    }
+    if (tp_consumer_read_latest(&rt.consumer, &view) != 0 ||
+        view.seq != 2 ||
+        tp_consumer_read_latest(&rt.consumer, &view) != 1)
+    {
+        goto cleanup;
+    }
+
+    for (seq = 3; seq < 6; seq++)
+    {
+        tp_producer_publish_frame(&rt.producer, seq, &header, payload, sizeof(payload), 1, 10 + seq, 0, 0);
+    }
+    if (tp_consumer_read_latest(&rt.consumer, &view) != 0 || view.seq != 5)
+    {
+        goto cleanup;
+    }
+
+    if (tp_consumer_get_drop_counts(&rt.consumer, &drops_gap, &drops_late, NULL) < 0 ||
+        drops_gap != 0 ||
+        drops_late != 0 ||
+        tp_consumer_conflated_count(&rt.consumer) != 2)
+    {
+        goto cleanup;
+    }
+
+    result = 0;
+
+cleanup:
+    tp_test_roundtrip_teardown(&rt);
+    assert(result == 0);
+}
+
+void tp_test_shm_roundtrip(void)
+{
+    test_shm_roundtrip_basic();
+    test_shm_tensor_header_cache();
+    test_shm_consumer_header_cache();
+    test_shm_concurrent_claim_reorder();
+    test_shm_concurrent_claim_threads();
+    test_shm_offer_framev();
+    test_shm_read_frame_copy();
+    test_shm_follow_ring();
+    test_shm_read_latest();
+}
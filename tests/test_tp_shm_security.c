@@ -48,6 +48,8 @@ void tp_test_shm_security(void)
     char nested_file[256];
     char link_file[256];
     char uri[512];
+    size_t huge_bytes = 0;
+    size_t resident_bytes = 0;
     int fd = -1;
     int result = -1;
     int step = 0;
@@ -262,6 +264,30 @@ void tp_test_shm_security(void)
         goto cleanup;
     }
 
+    step = 25;
+    snprintf(uri, sizeof(uri), "shm:file?path=%s|require_hugepages=true|transparent_hugepages=true", file_path);
+    if (tp_shm_map(&region, uri, 0, tp_context_allowed_paths(ctx), NULL) == 0)
+    {
+        goto cleanup;
+    }
+
+    /* Transparent hugepages are advisory, so the mapping holds on any filesystem. */
+    step = 26;
+    snprintf(uri, sizeof(uri), "shm:file?path=%s|transparent_hugepages=true", file_path);
+    if (tp_shm_map(&region, uri, 0, tp_context_allowed_paths(ctx), NULL) < 0)
+    {
+        goto cleanup;
+    }
+    if (((volatile const uint8_t *)region.addr)[0] != 0 ||
+        tp_shm_hugepage_coverage(region.addr, region.length, &huge_bytes, &resident_bytes) < 0 ||
+        resident_bytes == 0 ||
+        huge_bytes > resident_bytes)
+    {
+        tp_shm_unmap(&region, NULL);
+        goto cleanup;
+    }
+    tp_shm_unmap(&region, NULL);
+
     close(fd);
     fd = -1;
     unlink(file_path);
@@ -270,7 +296,7 @@ void tp_test_shm_security(void)
 
     strncpy(base_dir, base_template, sizeof(base_dir) - 1);
     base_dir[sizeof(base_dir) - 1] = '\0';
-    step = 25;
+    step = 27;
     if (NULL == mkdtemp(base_dir))
     {
         goto cleanup;
@@ -297,7 +323,7 @@ void tp_test_shm_security(void)
 
     allowed_paths[0] = base_dir;
     tp_context_set_allowed_paths(ctx, allowed_paths, 1);
-    step = 26;
+    step = 28;
     if (tp_context_finalize_allowed_paths(ctx) < 0)
     {
         goto cleanup;
@@ -312,7 +338,7 @@ void tp_test_shm_security(void)
         snprintf(link_file, sizeof(link_file), "%s/%s", link_dir, base + 1);
     }
     snprintf(uri, sizeof(uri), "shm:file?path=%s", link_file);
-    step = 27;
+    step = 29;
     if (tp_shm_map(&region, uri, 0, tp_context_allowed_paths(ctx), NULL) == 0)
     {
         goto cleanup;
@@ -51,12 +51,14 @@ void tp_test_client_context_setters(void);
 void tp_test_driver_client_decoders(void);
 void tp_test_driver_client_attach_detach_live(void);
 void tp_test_driver_config(void);
+void tp_test_driver_provision(void);
 void tp_test_driver_discovery_integration(void);
 void tp_test_driver_exclusive_producer(void);
 void tp_test_driver_publish_mode_hugepages(void);
 void tp_test_driver_node_id_cooldown(void);
 void tp_test_driver_config_matrix(void);
 void tp_test_driver_lease_expiry(void);
+void tp_test_driver_spare_epochs(void);
 void tp_test_driver_async_attach_wrappers(void);
 void tp_test_driver_blocking_attach_wrappers(void);
 void tp_test_discovery_service(void);
@@ -89,7 +91,10 @@ void tp_test_consumer_fallback_state(void);
 void tp_test_consumer_fallback_recover(void);
 void tp_test_consumer_fallback_invalid_announce(void);
 void tp_test_consumer_fallback_layout_version(void);
+void tp_test_consumer_seamless_remap(void);
 void tp_test_qos_drop_counts(void);
+void tp_test_consumer_poll_frames(void);
+void tp_test_consumer_rate_gate(void);
 void tp_test_epoch_remap(void);
 void tp_test_progress_per_consumer_control(void);
 void tp_test_progress_layout_validation(void);
@@ -98,8 +103,14 @@ void tp_test_progress_poller_misc(void);
 void tp_test_progress_poller_monotonic_capacity(void);
 void tp_test_producer_claim_lifecycle(void);
 void tp_test_shm_roundtrip(void);
+void tp_test_copy_engine(void);
+void tp_test_dispatcher(void);
+void tp_test_consumer_group(void);
+void tp_test_latency(void);
+void tp_test_numa(void);
 void tp_test_rollover(void);
 void tp_test_shm_security(void);
+void tp_test_shm_cache(void);
 void tp_test_consumer_lease_revoked(void);
 void tp_test_producer_lease_revoked(void);
 
@@ -249,6 +260,15 @@ static void test_uri_parse(void)
 
     assert(tp_shm_uri_parse(&uri, "shm:file?path=/dev/shm/test", NULL) == 0);
     assert(uri.require_hugepages == false);
+    assert(uri.transparent_hugepages == false);
+
+    assert(tp_shm_uri_parse(&uri, "shm:file?path=/dev/shm/test|require_hugepages=false|transparent_hugepages=true",
+        NULL) == 0);
+    assert(uri.require_hugepages == false);
+    assert(uri.transparent_hugepages == true);
+    assert(tp_shm_uri_parse(&uri, "shm:file?path=/dev/shm/test|transparent_hugepages=yes", NULL) < 0);
+    assert(tp_shm_uri_parse(&uri, "shm:file?path=/dev/shm/test|require_hugepages=true|transparent_hugepages=true",
+        NULL) < 0);
 
     assert(tp_shm_uri_parse(&uri, "shm:file?require_hugepages=true", NULL) < 0);
     assert(tp_shm_uri_parse(&uri, "shm:mem?path=/dev/shm/test", NULL) < 0);
@@ -619,12 +639,14 @@ int main(void)
     tp_test_driver_client_decoders();
     tp_test_driver_client_attach_detach_live();
     tp_test_driver_config();
+    tp_test_driver_provision();
     tp_test_driver_discovery_integration();
     tp_test_driver_exclusive_producer();
     tp_test_driver_publish_mode_hugepages();
     tp_test_driver_node_id_cooldown();
     tp_test_driver_config_matrix();
     tp_test_driver_lease_expiry();
+    tp_test_driver_spare_epochs();
     tp_test_driver_async_attach_wrappers();
     tp_test_driver_blocking_attach_wrappers();
     tp_test_discovery_service();
@@ -649,6 +671,8 @@ int main(void)
     tp_test_rate_limit();
     tp_test_qos_liveness();
     tp_test_qos_drop_counts();
+    tp_test_consumer_poll_frames();
+    tp_test_consumer_rate_gate();
     tp_test_epoch_regression();
     tp_test_epoch_remap();
     tp_test_meta_blob_ordering();
@@ -658,6 +682,7 @@ int main(void)
     tp_test_consumer_fallback_recover();
     tp_test_consumer_fallback_invalid_announce();
     tp_test_consumer_fallback_layout_version();
+    tp_test_consumer_seamless_remap();
     tp_test_progress_per_consumer_control();
     tp_test_progress_layout_validation();
     tp_test_progress_regression_rejected();
@@ -665,8 +690,14 @@ int main(void)
     tp_test_progress_poller_monotonic_capacity();
     tp_test_producer_claim_lifecycle();
     tp_test_shm_roundtrip();
+    tp_test_copy_engine();
+    tp_test_dispatcher();
+    tp_test_consumer_group();
+    tp_test_latency();
+    tp_test_numa();
     tp_test_rollover();
     tp_test_shm_security();
+    tp_test_shm_cache();
     tp_test_consumer_lease_revoked();
     tp_test_producer_lease_revoked();
 
@@ -1,4 +1,5 @@
 #include "tensor_pool/tp_supervisor.h"
+#include "tensor_pool/internal/tp_consumer_registry.h"
 
 #include <assert.h>
 #include <string.h>
@@ -85,8 +86,47 @@ static void tp_test_supervisor_disabled_request(void)
     tp_supervisor_close(&supervisor);
 }
 
+static void tp_test_supervisor_latency_rank(void)
+{
+    tp_supervisor_config_t config;
+    tp_supervisor_t supervisor;
+    tp_consumer_hello_view_t hello;
+    tp_consumer_config_msg_t out;
+    tp_supervisor_consumer_latency_t ranked[2];
+    tp_consumer_entry_t *entry;
+    const uint64_t p99s[4] = { 300, 900, 0, 600 };
+    uint32_t consumer_id;
+
+    assert(tp_supervisor_config_init(&config) == 0);
+    assert(tp_supervisor_init(&supervisor, &config) == 0);
+    assert(tp_supervisor_rank_consumers_by_latency(&supervisor, ranked, 2) == 0);
+
+    for (consumer_id = 1; consumer_id <= 4; consumer_id++)
+    {
+        hello = tp_make_hello(10000, consumer_id, NULL, 0, NULL, 0);
+        assert(tp_supervisor_handle_hello(&supervisor, &hello, &out) == 0);
+        entry = tp_consumer_registry_find((tp_consumer_registry_t *)supervisor.registry, consumer_id);
+        assert(NULL != entry);
+        /* Consumer 3 never reports latency and must not be ranked. */
+        if (p99s[consumer_id - 1] != 0)
+        {
+            entry->last_latency_ns = 1;
+            entry->read_latency.count = 10;
+            entry->read_latency.p99_ns = p99s[consumer_id - 1];
+        }
+    }
+
+    assert(tp_supervisor_rank_consumers_by_latency(&supervisor, ranked, 2) == 2);
+    assert(ranked[0].consumer_id == 2 && ranked[0].read.p99_ns == 900);
+    assert(ranked[1].consumer_id == 4 && ranked[1].read.p99_ns == 600);
+    assert(tp_supervisor_rank_consumers_by_latency(NULL, ranked, 2) < 0);
+
+    tp_supervisor_close(&supervisor);
+}
+
 void tp_test_supervisor(void)
 {
     tp_test_supervisor_per_consumer_assign();
     tp_test_supervisor_disabled_request();
+    tp_test_supervisor_latency_rank();
 }
@@ -19,6 +19,7 @@
 #include "wire/tensor_pool/frameProgressState.h"
 #include "wire/tensor_pool/messageHeader.h"
 #include "wire/tensor_pool/qosConsumer.h"
+#include "wire/tensor_pool/qosConsumerLatency.h"
 #include "wire/tensor_pool/qosProducer.h"
 #include "wire/tensor_pool/mode.h"
 #include "wire/tensor_pool/shmPoolAnnounce.h"
@@ -850,6 +851,47 @@ static void tp_on_qos_fragment(
         }
         return;
     }
+
+    if (template_id == tensor_pool_qosConsumerLatency_sbe_template_id())
+    {
+        struct tensor_pool_qosConsumerLatency qos;
+        tensor_pool_qosConsumerLatency_wrap_for_decode(
+            &qos,
+            (char *)buffer,
+            tensor_pool_messageHeader_encoded_length(),
+            block_length,
+            version,
+            length);
+        if (state && state->json)
+        {
+            printf("{\"type\":\"QosConsumerLatency\",\"stream\":%u,\"consumer\":%u,\"epoch\":%" PRIu64 ",\"arrival_count\":%" PRIu64 ",\"arrival_p50_ns\":%" PRIu64 ",\"arrival_p99_ns\":%" PRIu64 ",\"read_count\":%" PRIu64 ",\"read_p50_ns\":%" PRIu64 ",\"read_p99_ns\":%" PRIu64 ",\"read_max_ns\":%" PRIu64 "}\n",
+                tensor_pool_qosConsumerLatency_streamId(&qos),
+                tensor_pool_qosConsumerLatency_consumerId(&qos),
+                tensor_pool_qosConsumerLatency_epoch(&qos),
+                tensor_pool_qosConsumerLatency_arrivalCount(&qos),
+                tensor_pool_qosConsumerLatency_arrivalP50Ns(&qos),
+                tensor_pool_qosConsumerLatency_arrivalP99Ns(&qos),
+                tensor_pool_qosConsumerLatency_readCount(&qos),
+                tensor_pool_qosConsumerLatency_readP50Ns(&qos),
+                tensor_pool_qosConsumerLatency_readP99Ns(&qos),
+                tensor_pool_qosConsumerLatency_readMaxNs(&qos));
+        }
+        else
+        {
+            printf("QosConsumerLatency stream=%u consumer=%u epoch=%" PRIu64 " arrival_count=%" PRIu64 " arrival_p50_ns=%" PRIu64 " arrival_p99_ns=%" PRIu64 " read_count=%" PRIu64 " read_p50_ns=%" PRIu64 " read_p99_ns=%" PRIu64 " read_max_ns=%" PRIu64 "\n",
+                tensor_pool_qosConsumerLatency_streamId(&qos),
+                tensor_pool_qosConsumerLatency_consumerId(&qos),
+                tensor_pool_qosConsumerLatency_epoch(&qos),
+                tensor_pool_qosConsumerLatency_arrivalCount(&qos),
+                tensor_pool_qosConsumerLatency_arrivalP50Ns(&qos),
+                tensor_pool_qosConsumerLatency_arrivalP99Ns(&qos),
+                tensor_pool_qosConsumerLatency_readCount(&qos),
+                tensor_pool_qosConsumerLatency_readP50Ns(&qos),
+                tensor_pool_qosConsumerLatency_readP99Ns(&qos),
+                tensor_pool_qosConsumerLatency_readMaxNs(&qos));
+        }
+        return;
+    }
 }
 
 int main(int argc, char **argv)